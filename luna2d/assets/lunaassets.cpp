@@ -114,11 +114,18 @@ bool LUNAAssets::IsIgnored(const std::string& path)
 
 	// Ignore description files
 	std::string ext = files->GetExtension(path);
-	if(ext == "atlas" || ext == "font" || ext == "pixmap") return true;
+	if(ext == "atlas" || ext == "font" || ext == "pixmap" || ext == "texture") return true;
 
 	// Shader loading starts from vertex shader file
 	if(ext == "frag") return true;
 
+	// Variants of compressed textures are selected by texture loader when base file is loaded
+	if(ext == "ktx" || ext == "pkm")
+	{
+		std::string variant = files->GetExtension(files->GetBasename(path));
+		if(variant == "astc" || variant == "etc2" || variant == "pvrtc") return true;
+	}
+
 	// Ignore files with different from current resolution suffix
 	std::string suffix = files->SplitSuffix(files->GetBasename(path)).second;
 	if(!suffix.empty() && suffix != LUNAEngine::SharedSizes()->GetResolutionSuffix()) return true;
@@ -132,13 +139,13 @@ std::shared_ptr<LUNAAssetLoader> LUNAAssets::GetLoader(const std::string& path)
 	auto files = LUNAEngine::SharedFiles();
 	std::string ext = files->GetExtension(path);
 
-	if(ext == "png")
+	if(ext == "png" || ext == "ktx" || ext == "pkm")
 	{
 		// Load image as texture atlas if atlas desctiption file is exists
 		if(files->IsFile(files->ReplaceExtension(path, "atlas"))) return std::make_shared<LUNATextureAtlasLoader>();
 
-		// Load image as pixmap if pixmap desctiption file is exists
-		if(files->IsFile(files->ReplaceExtension(path, "pixmap"))) return std::make_shared<LUNAPixmapLoader>();
+		// Load image as pixmap if pixmap desctiption file is exists. Pixmaps cannot be compressed
+		if(ext == "png" && files->IsFile(files->ReplaceExtension(path, "pixmap"))) return std::make_shared<LUNAPixmapLoader>();
 
 		// Load image as just texture
 		else return std::make_shared<LUNATextureLoader>();
@@ -47,15 +47,24 @@ bool LUNAFontLoader::Load(const std::string& filename)
 	}
 
 	// Load font file
-	LUNAFontGenerator generator;
-	if(!generator.Load(filename)) return false;
+	// Generator is shared with generated fonts to rasterize chars on first use
+	auto generator = std::make_shared<LUNAFontGenerator>();
+	if(!generator->Load(filename)) return false;
+
+	// Signed distance field fonts share one atlas generated with max of their sizes
+	int sdfSize = 0;
+	for(auto entry : jsonDesc.object_items())
+	{
+		if(entry.second["sdf"].bool_value()) sdfSize = std::max(sdfSize, entry.second["size"].int_value());
+	}
+	std::shared_ptr<LUNAFont> sdfFont;
 
 	// Generate bitmap fonts for each specifed size in description file
 	for(auto entry : jsonDesc.object_items())
 	{
-		generator.ResetCharSets();
+		generator->ResetCharSets();
 
-		if(entry.second.is_number()) fonts[entry.first] = generator.GenerateFont(entry.second.int_value());
+		if(entry.second.is_number()) fonts[entry.first] = generator->GenerateFont(entry.second.int_value());
 		else if(entry.second.is_object())
 		{
 			auto sizeParams = entry.second;
@@ -66,18 +75,30 @@ bool LUNAFontLoader::Load(const std::string& filename)
 				continue;
 			}
 
+			// Chars from specifed charsets are rasterized immediately
 			auto jsonChars = sizeParams["chars"];
 			if(jsonChars.is_object())
 			{
-				generator.enableLatin = jsonChars["latin"].bool_value() == true;
-				generator.enableDiactritic = jsonChars["diactritic"].bool_value() == true;
-				generator.enableCyrillic = jsonChars["cyrillic"].bool_value() == true;
-				generator.enableCommon = jsonChars["common"].bool_value() == true;
-				generator.enableNumbers = jsonChars["numbers"].bool_value() == true;
-				generator.customSymbols = utf::ToUtf32(jsonChars["custom"].string_value());
+				generator->enableLatin = jsonChars["latin"].bool_value() == true;
+				generator->enableDiactritic = jsonChars["diactritic"].bool_value() == true;
+				generator->enableCyrillic = jsonChars["cyrillic"].bool_value() == true;
+				generator->enableCommon = jsonChars["common"].bool_value() == true;
+				generator->enableNumbers = jsonChars["numbers"].bool_value() == true;
+				generator->customSymbols = utf::ToUtf32(jsonChars["custom"].string_value());
 			}
 
-			fonts[entry.first] = generator.GenerateFont(sizeParams["size"].int_value());
+			int size = sizeParams["size"].int_value();
+			if(!sizeParams["sdf"].bool_value())
+			{
+				fonts[entry.first] = generator->GenerateFont(size);
+				continue;
+			}
+
+			// Chars selected for all sizes are rasterized to shared atlas
+			if(!sdfFont) sdfFont = generator->GenerateFont(sdfSize, true);
+			else sdfFont->PreloadChars(generator->GetSelectedChars());
+
+			fonts[entry.first] = size == sdfSize ? sdfFont : std::make_shared<LUNAFont>(sdfFont, size);
 		}
 	}
 
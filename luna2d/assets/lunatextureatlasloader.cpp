@@ -22,6 +22,7 @@
 //-----------------------------------------------------------------------------
 
 #include "lunatextureatlasloader.h"
+#include "lunafiles.h"
 
 using namespace luna2d;
 
@@ -30,20 +31,27 @@ bool LUNATextureAtlasLoader::Load(const std::string& filename)
 	// Description file for atlas has same name as image, just with different extension
 	std::string atlasPath = LUNAEngine::SharedFiles()->ReplaceExtension(filename, "atlas");
 
-	// Load texture
+	std::string err;
+	json11::Json jsonAtlas = json11::Json::parse(LUNAEngine::SharedFiles()->ReadFileToString(atlasPath), err);
+	if(!jsonAtlas.is_object())
+	{
+		LUNA_LOGE("Cannot parse atlas description \"%s\": %s", atlasPath.c_str(), err.c_str());
+		return false;
+	}
+
+	// Load texture with params declared in atlas description
+	LUNATextureParams params;
+	LUNATextureLoader::ReadParams(jsonAtlas[ATLAS_TEXTURE_PARAMS], params);
+
 	LUNATextureLoader textureLoader;
+	textureLoader.SetParams(params);
 	if(!textureLoader.Load(filename)) return false;
 	texture = textureLoader.GetTexture();
 
 	// Load texture atlas
-	atlas = std::make_shared<LUNATextureAtlas>(texture, atlasPath);
+	atlas = std::make_shared<LUNATextureAtlas>(texture, jsonAtlas);
 	if(!atlas->IsLoaded()) return false;
 
-#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
-	// Set reload path for texture
-	texture->SetReloadPath(filename);
-#endif
-
 	return true;
 }
 
@@ -22,33 +22,136 @@
 //-----------------------------------------------------------------------------
 
 #include "lunatextureloader.h"
+#include "lunafiles.h"
 
 using namespace luna2d;
 
+// Tags of compressed texture variants in order of preference. Variant is stored near base file,
+// for example "image.astc.ktx" near "image.ktx". Base file is expected to be in ETC1 format
+const std::vector<std::string> COMPRESSED_VARIANTS = { "astc", "etc2", "pvrtc" };
+
+// Select compressed image supported by device from base file and its variants
+// Selected image is returned already loaded, "outPath" is set to path of it
+static LUNACompressedImage SelectCompressedImage(const std::string& filename, std::string& outPath)
+{
+	auto files = LUNAEngine::SharedFiles();
+	std::string ext = files->GetExtension(filename);
+
+	for(const auto& tag : COMPRESSED_VARIANTS)
+	{
+		std::string variantPath = files->ReplaceExtension(filename, tag + "." + ext);
+		if(!files->IsFile(variantPath)) continue;
+
+		LUNACompressedImage variant(variantPath, LUNAFileLocation::ASSETS);
+		if(variant.IsSupported())
+		{
+			outPath = variantPath;
+			return variant;
+		}
+	}
+
+	outPath = filename;
+	return LUNACompressedImage(filename, LUNAFileLocation::ASSETS);
+}
+
+// Read texture params from json object like: { "filter": "linearMipmap", "wrap": "clamp" }
+void LUNATextureLoader::ReadParams(const json11::Json& jsonParams, LUNATextureParams& params)
+{
+	const json11::Json& jsonFilter = jsonParams["filter"];
+	if(jsonFilter.is_string())
+	{
+		if(TEXTURE_FILTER.HasKey(jsonFilter.string_value())) params.filter = TEXTURE_FILTER.FromString(jsonFilter.string_value());
+		else LUNA_LOGE("Unsupported texture filter \"%s\"", jsonFilter.string_value().c_str());
+	}
+
+	const json11::Json& jsonWrap = jsonParams["wrap"];
+	if(jsonWrap.is_string())
+	{
+		if(TEXTURE_WRAP.HasKey(jsonWrap.string_value())) params.wrap = TEXTURE_WRAP.FromString(jsonWrap.string_value());
+		else LUNA_LOGE("Unsupported texture wrap \"%s\"", jsonWrap.string_value().c_str());
+	}
+}
+
 std::shared_ptr<LUNATexture> LUNATextureLoader::GetTexture()
 {
 	return texture;
 }
 
+// Set default params. Params from texture description file (with ".texture" extension) override them
+void LUNATextureLoader::SetParams(const LUNATextureParams& params)
+{
+	this->params = params;
+}
+
+// Load texture from compressed image. If format of image is not supported by device,
+// try decode it on CPU (only ETC1 format can be decoded)
+bool LUNATextureLoader::LoadCompressed(const LUNACompressedImage& image)
+{
+	if(image.IsEmpty()) return false;
+
+	if(image.IsSupported())
+	{
+		texture = std::make_shared<LUNATexture>(image, params);
+		return true;
+	}
+
+	if(!image.CanDecode())
+	{
+		LUNA_LOGE("Compressed texture format 0x%x is not supported by device", image.GetGlFormat());
+		return false;
+	}
+
+	LUNAImage decodedImage = image.Decode();
+	if(decodedImage.IsEmpty()) return false;
+
+	texture = std::make_shared<LUNATexture>(decodedImage, params);
+	return true;
+}
+
 bool LUNATextureLoader::Load(const std::string& filename)
 {
-	std::string ext = LUNAEngine::SharedFiles()->GetExtension(filename);
-	std::unique_ptr<LUNAImageFormat> format;
+	auto files = LUNAEngine::SharedFiles();
+	std::string ext = files->GetExtension(filename);
 
-	// Select image format to decode
-	if(ext == "png") format = std::unique_ptr<LUNAPngFormat>(new LUNAPngFormat());
-	if(!format) return false;
+	// Read params from optional description file
+	std::string descPath = files->ReplaceExtension(filename, "texture");
+	if(files->IsFile(descPath))
+	{
+		std::string err;
+		json11::Json jsonParams = json11::Json::parse(files->ReadFileToString(descPath), err);
+		if(jsonParams.is_object()) ReadParams(jsonParams, params);
+		else LUNA_LOGE("Cannot parse texture description \"%s\": %s", descPath.c_str(), err.c_str());
+	}
 
-	// Load image data
-	LUNAImage image(filename, *format, LUNAFileLocation::ASSETS);
-	if(image.IsEmpty()) return false;
+	std::string texturePath = filename;
+
+	// Load compressed texture
+	if(ext == "ktx" || ext == "pkm")
+	{
+		LUNACompressedImage image = SelectCompressedImage(filename, texturePath);
+		if(!LoadCompressed(image)) return false;
+	}
+
+	// Load texture from image
+	else
+	{
+		std::unique_ptr<LUNAImageFormat> format;
+
+		// Select image format to decode
+		if(ext == "png") format = std::unique_ptr<LUNAPngFormat>(new LUNAPngFormat());
+		if(!format) return false;
+
+		// Load image data
+		LUNAImage image(filename, *format, LUNAFileLocation::ASSETS);
+		if(image.IsEmpty()) return false;
 
-	// Make texture from image
-	texture = std::make_shared<LUNATexture>(image);
+		// Make texture from image
+		texture = std::make_shared<LUNATexture>(image, params);
+	}
 
 #if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
 	// Set reload path for texture
-	texture->SetReloadPath(filename);
+	texture->SetReloadPath(texturePath);
 #endif
 
 	return true;
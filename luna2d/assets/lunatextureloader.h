@@ -24,6 +24,7 @@
 #pragma once
 
 #include "lunatexture.h"
+#include <json11.hpp>
 
 namespace luna2d{
 
@@ -31,9 +32,23 @@ class LUNATextureLoader : public LUNAAssetLoader
 {
 private:
 	std::shared_ptr<LUNATexture> texture;
+	LUNATextureParams params;
+
+private:
+	// Load texture from compressed image. If format of image is not supported by device,
+	// try decode it on CPU (only ETC1 format can be decoded)
+	bool LoadCompressed(const LUNACompressedImage& image);
+
+public:
+	// Read texture params from json object like: { "filter": "linearMipmap", "wrap": "clamp" }
+	static void ReadParams(const json11::Json& jsonParams, LUNATextureParams& params);
 
 public:
 	std::shared_ptr<LUNATexture> GetTexture();
+
+	// Set default params. Params from texture description file (with ".texture" extension) override them
+	void SetParams(const LUNATextureParams& params);
+
 	virtual bool Load(const std::string& filename);
 	virtual void PushToLua(const std::string& name, LuaTable& parentTable);
 };
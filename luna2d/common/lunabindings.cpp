@@ -38,7 +38,6 @@
 #include "math/lunasplines.h"
 #include "math/lunaeasing.h"
 #include "math/lunabounds.h"
-#include "lunapngformat.h"
 
 using namespace luna2d;
 
@@ -76,14 +75,14 @@ static void BindUtils(LuaScript* lua, LuaTable& tblLuna)
 	tblLuna.SetField("utils", tblUtils);
 
 	// Take screenshot image to application folder
-	std::function<void(const std::string&)> fnTakeScreenshot = [](const std::string& filename)
+	// Image is encoded asynchronously, optional callback receives success flag
+	std::function<void(const std::string&, const LuaFunction&)> fnTakeScreenshot =
+		[](const std::string& filename, const LuaFunction& callback)
 	{
-		// Take screenshot when current frame will be completely rendered
-		LUNAEngine::SharedGraphics()->RunAfterRender([filename]()
-		{
-			auto image = LUNAEngine::SharedGraphics()->GetRenderer()->ReadPixels();
-			image->Save(filename, LUNAPngFormat(), LUNAFileLocation::APP_FOLDER);
-		});
+		std::function<void(bool)> fnCallback;
+		if(callback) fnCallback = [callback](bool success) { callback.CallVoid(success); };
+
+		LUNAEngine::SharedGraphics()->GetScreenshots()->Take(filename, fnCallback);
 	};
 	tblUtils.SetField("takeScreenshot", LuaFunction(lua, fnTakeScreenshot));
 
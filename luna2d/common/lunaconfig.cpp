@@ -92,6 +92,34 @@ void LUNAConfig::ReadContentHeight(const json11::Json& jsonConfig)
 	else LUNA_LOGE("Content height must be number");
 }
 
+void LUNAConfig::ReadVertexFormat(const json11::Json& jsonConfig)
+{
+	auto jsonVertexFormat = jsonConfig["vertexFormat"];
+	if(jsonVertexFormat.is_null()) return;
+
+	std::string vertexFormatStr = jsonVertexFormat.string_value();
+	if(!VERTEX_FORMAT.HasKey(vertexFormatStr)) LUNA_LOGE("Unsupported vertex format \"%s\"", vertexFormatStr.c_str());
+	else vertexFormat = VERTEX_FORMAT.FromString(vertexFormatStr);
+}
+
+void LUNAConfig::ReadMultiTexture(const json11::Json& jsonConfig)
+{
+	auto jsonMultiTexture = jsonConfig["multiTexture"];
+	if(jsonMultiTexture.is_null()) return;
+
+	if(jsonMultiTexture.is_bool()) multiTexture = jsonMultiTexture.bool_value();
+	else LUNA_LOGE("Multi texture must be boolean");
+}
+
+void LUNAConfig::ReadProgramCache(const json11::Json& jsonConfig)
+{
+	auto jsonProgramCache = jsonConfig["programCache"];
+	if(jsonProgramCache.is_null()) return;
+
+	if(jsonProgramCache.is_bool()) programCache = jsonProgramCache.bool_value();
+	else LUNA_LOGE("Program cache must be boolean");
+}
+
 void LUNAConfig::ReadDebugValues(const json11::Json& jsonConfig)
 {
 	debug_missedStrings = jsonConfig["debug_missedStrings"].bool_value();
@@ -146,6 +174,9 @@ bool LUNAConfig::Read()
 	ReadScaleMode(jsonConfig);
 	ReadContentWidth(jsonConfig);
 	ReadContentHeight(jsonConfig);
+	ReadVertexFormat(jsonConfig);
+	ReadMultiTexture(jsonConfig);
+	ReadProgramCache(jsonConfig);
 	ReadDebugValues(jsonConfig);
 
 	customValues = jsonConfig;
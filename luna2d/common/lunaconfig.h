@@ -26,6 +26,7 @@
 #include "lunaengine.h"
 #include "lunastringenum.h"
 #include "lunaresolutions.h"
+#include "lunavertexformattype.h"
 #include <json11.hpp>
 
 namespace luna2d{
@@ -71,6 +72,9 @@ public:
 	LUNAScaleMode scaleMode = LUNAScaleMode::STRETCH_BY_WIDTH;
 	int contentWidth = 480;
 	int contentHeight = 320;
+	LUNAVertexFormatType vertexFormat = LUNAVertexFormatType::PACKED_COLOR;
+	bool multiTexture = false;
+	bool programCache = true; // Cache binaries of linked shader programs if supported by driver
 	bool debug_missedStrings = false;
 
 private:
@@ -82,6 +86,9 @@ private:
 	void ReadScaleMode(const json11::Json& jsonConfig);
 	void ReadContentWidth(const json11::Json& jsonConfig);
 	void ReadContentHeight(const json11::Json& jsonConfig);
+	void ReadVertexFormat(const json11::Json& jsonConfig);
+	void ReadMultiTexture(const json11::Json& jsonConfig);
+	void ReadProgramCache(const json11::Json& jsonConfig);
 	void ReadDebugValues(const json11::Json& jsonConfig);
 
 public:
@@ -0,0 +1,151 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaetc1.h"
+#include <algorithm>
+
+using namespace luna2d;
+
+// Intensity modifiers for each table codeword
+static const int MODIFIER_TABLE[8][2] =
+{
+	{ 2, 8 },
+	{ 5, 17 },
+	{ 9, 29 },
+	{ 13, 42 },
+	{ 18, 60 },
+	{ 24, 80 },
+	{ 33, 106 },
+	{ 47, 183 },
+};
+
+static inline unsigned char Clamp(int value)
+{
+	return (unsigned char)std::min(std::max(value, 0), 255);
+}
+
+// Expand 4-bit color component to 8 bits
+static inline int Expand4(int value)
+{
+	return (value << 4) | value;
+}
+
+// Expand 5-bit color component to 8 bits
+static inline int Expand5(int value)
+{
+	return (value << 3) | (value >> 2);
+}
+
+// Get signed 3-bit delta
+static inline int Delta3(int value)
+{
+	return value >= 4 ? value - 8 : value;
+}
+
+// Get size of compressed data for image with given sizes (in bytes)
+size_t etc1::GetDataSize(int width, int height)
+{
+	size_t blocksX = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	size_t blocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	return blocksX * blocksY * BLOCK_BYTES;
+}
+
+// Decode one block to RGB pixels. "stride" is size of output row (in bytes)
+// Only "width"x"height" pixels are written for partial blocks on image border
+void etc1::DecodeBlock(const unsigned char* block, unsigned char* outPixels, int stride, int width, int height)
+{
+	// Block is stored as big-endian 64-bit value
+	unsigned int high = (block[0] << 24) | (block[1] << 16) | (block[2] << 8) | block[3];
+	unsigned int low = (block[4] << 24) | (block[5] << 16) | (block[6] << 8) | block[7];
+
+	bool diff = (high & 2) != 0;
+	bool flip = (high & 1) != 0;
+
+	// Base colors of two subblocks
+	int colors[2][3];
+	if(diff)
+	{
+		for(int i = 0; i < 3; i++)
+		{
+			int base = (high >> (27 - i * 8)) & 0x1F;
+			int delta = Delta3((high >> (24 - i * 8)) & 0x7);
+			colors[0][i] = Expand5(base);
+			colors[1][i] = Expand5((base + delta) & 0x1F);
+		}
+	}
+	else
+	{
+		for(int i = 0; i < 3; i++)
+		{
+			colors[0][i] = Expand4((high >> (28 - i * 8)) & 0xF);
+			colors[1][i] = Expand4((high >> (24 - i * 8)) & 0xF);
+		}
+	}
+
+	int tables[2] = { (int)(high >> 5) & 0x7, (int)(high >> 2) & 0x7 };
+
+	for(int x = 0; x < width; x++)
+	{
+		for(int y = 0; y < height; y++)
+		{
+			// Without flip block is split to 2x4 left and right subblocks, with flip to 4x2 top and bottom
+			int subblock = flip ? (y >= 2 ? 1 : 0) : (x >= 2 ? 1 : 0);
+
+			// Pixel indexes are stored in column-major order
+			int bit = x * 4 + y;
+			int msb = (low >> (bit + 16)) & 1;
+			int lsb = (low >> bit) & 1;
+
+			int modifier = MODIFIER_TABLE[tables[subblock]][lsb];
+			if(msb) modifier = -modifier;
+
+			unsigned char* pixel = outPixels + y * stride + x * 3;
+			pixel[0] = Clamp(colors[subblock][0] + modifier);
+			pixel[1] = Clamp(colors[subblock][1] + modifier);
+			pixel[2] = Clamp(colors[subblock][2] + modifier);
+		}
+	}
+}
+
+// Decode whole image to RGB pixels. Returns false when data is too small for given sizes
+bool etc1::Decode(const unsigned char* data, size_t dataSize, int width, int height, std::vector<unsigned char>& outPixels)
+{
+	if(width <= 0 || height <= 0 || dataSize < GetDataSize(width, height)) return false;
+
+	int stride = width * 3;
+	outPixels.resize(stride * height);
+
+	for(int blockY = 0; blockY < height; blockY += BLOCK_SIZE)
+	{
+		for(int blockX = 0; blockX < width; blockX += BLOCK_SIZE)
+		{
+			int blockWidth = std::min(BLOCK_SIZE, width - blockX);
+			int blockHeight = std::min(BLOCK_SIZE, height - blockY);
+
+			DecodeBlock(data, &outPixels[blockY * stride + blockX * 3], stride, blockWidth, blockHeight);
+			data += BLOCK_BYTES;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,49 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace luna2d{ namespace etc1{
+
+//-------------------------------------------------------------------
+// CPU decoder for ETC1 compressed textures. Used as fallback when
+// device doesn't support ETC1 textures. Each 4x4 block takes 8 bytes
+//-------------------------------------------------------------------
+
+const int BLOCK_SIZE = 4; // Size of block side (in pixels)
+const int BLOCK_BYTES = 8;
+
+// Get size of compressed data for image with given sizes (in bytes)
+size_t GetDataSize(int width, int height);
+
+// Decode one block to RGB pixels. "stride" is size of output row (in bytes)
+// Only "width"x"height" pixels are written for partial blocks on image border
+void DecodeBlock(const unsigned char* block, unsigned char* outPixels, int stride, int width = BLOCK_SIZE, int height = BLOCK_SIZE);
+
+// Decode whole image to RGB pixels. Returns false when data is too small for given sizes
+bool Decode(const unsigned char* data, size_t dataSize, int width, int height, std::vector<unsigned char>& outPixels);
+
+}}
@@ -53,8 +53,9 @@ public:
 	// "width" - Width of input image
 	// "height" - Height of input image
 	// "colorType" - Color type of input image
+	// "flipVertically" - Write rows of input image in reverse order. Used for bottom-up data read from OpenGL
 	virtual bool Encode(const std::vector<unsigned char>& inData, std::vector<unsigned char>& outData,
-		int width, int height, LUNAColorType colorType) const = 0;
+		int width, int height, LUNAColorType colorType, bool flipVertically = false) const = 0;
 };
 
 }
@@ -53,7 +53,7 @@ bool LUNAJpegFormat::Decode(const std::vector<unsigned char>& inData, std::vecto
 
 // SEE: "LUNAImageFormat::Encode"
 bool LUNAJpegFormat::Encode(const std::vector<unsigned char>& inData, std::vector<unsigned char>& outData,
-	int width, int height, LUNAColorType colorType) const
+	int width, int height, LUNAColorType colorType, bool flipVertically) const
 {
 	jpeg_compress_struct info;
 
@@ -140,7 +140,8 @@ bool LUNAJpegFormat::Encode(const std::vector<unsigned char>& inData, std::vecto
 
 		while(info.next_scanline < info.image_height)
 		{
-			size_t rowOffset = info.next_scanline * info.image_width * 4;
+			size_t row = flipVertically ? info.image_height - info.next_scanline - 1 : info.next_scanline;
+			size_t rowOffset = row * info.image_width * 4;
 
 			// Input strides by 4 bytes(RGBA), output strides by 3 bytes(RGB)
 			for(int i = 0, j = 0; i < info.image_width * 4; i += 4, j += 3)
@@ -160,7 +161,8 @@ bool LUNAJpegFormat::Encode(const std::vector<unsigned char>& inData, std::vecto
 
 		while(info.next_scanline < info.image_height)
 		{
-			rowPointer[0] = (const_cast<unsigned char*>(&inData[info.next_scanline * rowStride]));
+			size_t row = flipVertically ? info.image_height - info.next_scanline - 1 : info.next_scanline;
+			rowPointer[0] = (const_cast<unsigned char*>(&inData[row * rowStride]));
 			jpeg_write_scanlines(&info, rowPointer, 1);
 		}
 	}
@@ -118,7 +118,7 @@ bool LUNAPngFormat::Decode(const std::vector<unsigned char>& inData, std::vector
 
 // SEE: "LUNAImageFormat::Encode"
 bool LUNAPngFormat::Encode(const std::vector<unsigned char>& inData, std::vector<unsigned char>& outData,
-	int width, int height, LUNAColorType colorType) const
+	int width, int height, LUNAColorType colorType, bool flipVertically) const
 {
 	png_structp pngPtr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
 	if(!pngPtr) return false;
@@ -164,7 +164,8 @@ bool LUNAPngFormat::Encode(const std::vector<unsigned char>& inData, std::vector
 	std::vector<png_bytep> rows(height);
 	for (int i = 0; i < height; i++)
 	{
-		rows[i] = const_cast<png_bytep>(&inData[i * width * GetBytesPerPixel(colorType)]);
+		int row = flipVertically ? height - i - 1 : i;
+		rows[i] = const_cast<png_bytep>(&inData[row * width * GetBytesPerPixel(colorType)]);
 	}
 
 	png_write_info(pngPtr, infoPtr);
@@ -36,7 +36,7 @@ public:
 
 	// SEE: "LUNAImageFormat::Encode"
 	virtual bool Encode(const std::vector<unsigned char>& inData, std::vector<unsigned char>& outData,
-		int width, int height, LUNAColorType colorType) const;
+		int width, int height, LUNAColorType colorType, bool flipVertically = false) const;
 };
 
 }
@@ -26,6 +26,8 @@
 
 using namespace luna2d;
 
+unsigned LUNACamera::lastMatrixVersion = 0;
+
 LUNACamera::LUNACamera(float width, int height) :
 	width(width),
 	height(height),
@@ -39,7 +41,9 @@ void LUNACamera::UpdateMatrix()
 	float halfWidth = (width * zoom) / 2.0f;
 	float halfHeight = (height * zoom) / 2.0f;
 
+	matrixVersion = ++lastMatrixVersion;
 	matrix = glm::ortho(pos.x - halfWidth, pos.x + halfWidth, pos.y - halfHeight, pos.y + halfHeight);
+	visibleRect = LUNARect(pos.x - halfWidth, pos.y - halfHeight, halfWidth * 2.0f, halfHeight * 2.0f);
 }
 
 float LUNACamera::GetX()
@@ -95,6 +99,26 @@ const glm::mat4& LUNACamera::GetMatrix()
 	return matrix;
 }
 
+// Get version of matrix. Shaders compare versions instead of matrices to skip uploading same matrix
+unsigned LUNACamera::GetMatrixVersion()
+{
+	return matrixVersion;
+}
+
+// Get area of world visible through camera
+const LUNARect& LUNACamera::GetVisibleRect()
+{
+	return visibleRect;
+}
+
+// Check whether given bounding box intersects visible area
+bool LUNACamera::IsVisible(const LUNARect& bounds)
+{
+	// Objects lying exactly on edge of visible area are treated as visible
+	return bounds.x <= visibleRect.x + visibleRect.width && bounds.x + bounds.width >= visibleRect.x &&
+		bounds.y <= visibleRect.y + visibleRect.height && bounds.y + bounds.height >= visibleRect.y;
+}
+
 // Convert coordinates from camera to physical screen
 glm::vec2 LUNACamera::Project(const glm::vec2& pos)
 {
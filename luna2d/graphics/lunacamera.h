@@ -25,6 +25,7 @@
 
 #include "lunaglm.h"
 #include "lunalua.h"
+#include "lunarect.h"
 
 namespace luna2d{
 
@@ -43,6 +44,10 @@ private:
 	float zoom;
 	glm::vec2 pos;
 	glm::mat4 matrix;
+	unsigned matrixVersion = 0; // Unique for each matrix update of all cameras
+	LUNARect visibleRect;
+
+	static unsigned lastMatrixVersion;
 
 private:
 	void UpdateMatrix();
@@ -58,6 +63,15 @@ public:
 	void SetZoom(float zoom);
 	const glm::mat4& GetMatrix();
 
+	// Get version of matrix. Shaders compare versions instead of matrices to skip uploading same matrix
+	unsigned GetMatrixVersion();
+
+	// Get area of world visible through camera
+	const LUNARect& GetVisibleRect();
+
+	// Check whether given bounding box intersects visible area
+	bool IsVisible(const LUNARect& bounds);
+
 	// Convert coordinates from camera to physical screen
 	glm::vec2 Project(const glm::vec2& pos);
 
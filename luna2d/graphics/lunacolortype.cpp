@@ -40,6 +40,13 @@ size_t luna2d::GetBytesPerPixel(LUNAColorType colorType)
 
 }
 
+// Check for texture with given color type can be used as color attachment of framebuffer
+bool luna2d::IsColorRenderable(LUNAColorType colorType)
+{
+	// OpenGL ES 2.0 doesn't require alpha and luminance textures to be color-renderable
+	return colorType == LUNAColorType::RGB || colorType == LUNAColorType::RGBA;
+}
+
 // Convert to GL color type
 GLint luna2d::ToGlColorType(LUNAColorType colorType)
 {
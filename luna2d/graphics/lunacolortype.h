@@ -67,6 +67,9 @@ struct LuaStack<LUNAColorType>
 // Get number of bytes per pixel for given color type
 size_t GetBytesPerPixel(LUNAColorType colorType);
 
+// Check for texture with given color type can be used as color attachment of framebuffer
+bool IsColorRenderable(LUNAColorType colorType);
+
 // Convert to GL color type
 GLint ToGlColorType(LUNAColorType colorType);
 
@@ -0,0 +1,247 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunacompressedimage.h"
+#include "lunaetc1.h"
+#include "lunafiles.h"
+#include "lunalog.h"
+#include <cstring>
+#include <algorithm>
+
+using namespace luna2d;
+
+const unsigned char KTX_IDENTIFIER[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+const uint32_t KTX_ENDIANNESS = 0x04030201;
+const size_t KTX_HEADER_SIZE = 64;
+
+const size_t PKM_HEADER_SIZE = 16;
+const int PKM_ETC1_RGB = 0; // Format type of "PKM 10" files
+const int PKM_ETC2_RGB = 1; // Format types of "PKM 20" files
+const int PKM_ETC2_RGBA = 3;
+
+// Read 32-bit value with given byte order
+static uint32_t ReadUint32(const unsigned char* data, bool swap)
+{
+	uint32_t value;
+	memcpy(&value, data, sizeof(value));
+	if(swap) value = (value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24);
+	return value;
+}
+
+// Read big-endian 16-bit value
+static int ReadBigUint16(const unsigned char* data)
+{
+	return (data[0] << 8) | data[1];
+}
+
+LUNACompressedImage::LUNACompressedImage(const std::string& filename, LUNAFileLocation location)
+{
+	auto files = LUNAEngine::SharedFiles();
+	std::vector<unsigned char> data = files->ReadFile(filename, location);
+	if(data.empty()) return;
+
+	if(!Load(data, files->GetExtension(filename))) LUNA_LOGE("Cannot load compressed image \"%s\"", filename.c_str());
+}
+
+// Construct image from data of KTX or PKM file. Type of container is selected by given file extension
+LUNACompressedImage::LUNACompressedImage(const std::vector<unsigned char>& data, const std::string& ext)
+{
+	if(!Load(data, ext)) LUNA_LOGE("Cannot load compressed image from \"%s\" data", ext.c_str());
+}
+
+// Load image from data of container with given file extension
+// Image is left empty if data cannot be loaded
+bool LUNACompressedImage::Load(const std::vector<unsigned char>& data, const std::string& ext)
+{
+	bool loaded = false;
+	if(ext == "ktx") loaded = LoadKtx(data);
+	else if(ext == "pkm") loaded = LoadPkm(data);
+
+	if(!loaded)
+	{
+		width = 0;
+		height = 0;
+		levels.clear();
+	}
+
+	return loaded;
+}
+
+bool LUNACompressedImage::LoadKtx(const std::vector<unsigned char>& data)
+{
+	if(data.size() < KTX_HEADER_SIZE || memcmp(&data[0], KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0) return false;
+
+	const unsigned char* header = &data[sizeof(KTX_IDENTIFIER)];
+	bool swap = ReadUint32(header, false) != KTX_ENDIANNESS;
+
+	uint32_t glType = ReadUint32(header + 4, swap);
+	glFormat = ReadUint32(header + 16, swap);
+	width = ReadUint32(header + 24, swap);
+	height = ReadUint32(header + 28, swap);
+	uint32_t depth = ReadUint32(header + 32, swap);
+	uint32_t arrayElements = ReadUint32(header + 36, swap);
+	uint32_t faces = ReadUint32(header + 40, swap);
+	uint32_t levelsCount = std::max(1u, ReadUint32(header + 44, swap));
+	uint32_t keyValueBytes = ReadUint32(header + 48, swap);
+
+	// Only plain compressed 2D textures are supported
+	if(glType != 0 || depth > 1 || arrayElements > 0 || faces != 1 || width <= 0 || height <= 0) return false;
+
+	// Sizes from file are compared with remaining size of data, so they cannot overflow offset
+	if(keyValueBytes > data.size() - KTX_HEADER_SIZE) return false;
+
+	size_t offset = KTX_HEADER_SIZE + keyValueBytes;
+	for(uint32_t i = 0; i < levelsCount; i++)
+	{
+		if(offset > data.size() || data.size() - offset < 4) return false;
+		size_t imageSize = ReadUint32(&data[offset], swap);
+		offset += 4;
+
+		if(imageSize > data.size() - offset) return false;
+		levels.emplace_back(data.begin() + offset, data.begin() + offset + imageSize);
+		offset += (imageSize + 3) & ~static_cast<size_t>(3); // Levels are aligned by 4 bytes
+	}
+
+	return true;
+}
+
+bool LUNACompressedImage::LoadPkm(const std::vector<unsigned char>& data)
+{
+	if(data.size() < PKM_HEADER_SIZE || memcmp(&data[0], "PKM ", 4) != 0) return false;
+
+	bool isVersion1 = data[4] == '1' && data[5] == '0';
+	bool isVersion2 = data[4] == '2' && data[5] == '0';
+	int formatType = ReadBigUint16(&data[6]);
+
+	if(isVersion1 && formatType == PKM_ETC1_RGB) glFormat = GL_FORMAT_ETC1_RGB8;
+	else if(isVersion2 && formatType == PKM_ETC1_RGB) glFormat = GL_FORMAT_ETC1_RGB8;
+	else if(isVersion2 && formatType == PKM_ETC2_RGB) glFormat = GL_FORMAT_ETC2_RGB8;
+	else if(isVersion2 && formatType == PKM_ETC2_RGBA) glFormat = GL_FORMAT_ETC2_RGBA8;
+	else return false;
+
+	// Extended sizes are aligned by blocks, original sizes are stored after them
+	width = ReadBigUint16(&data[12]);
+	height = ReadBigUint16(&data[14]);
+	if(width <= 0 || height <= 0) return false;
+
+	// ETC2 RGBA blocks are twice as large as ETC1/ETC2 RGB blocks
+	size_t dataSize = etc1::GetDataSize(width, height);
+	if(glFormat == GL_FORMAT_ETC2_RGBA8) dataSize *= 2;
+	if(data.size() < PKM_HEADER_SIZE + dataSize) return false;
+
+	levels.emplace_back(data.begin() + PKM_HEADER_SIZE, data.begin() + PKM_HEADER_SIZE + dataSize);
+	return true;
+}
+
+// Check whether given compressed format can be uploaded to texture on current device
+bool LUNACompressedImage::IsFormatSupported(GLenum glFormat)
+{
+	static std::vector<GLint> formats;
+	static bool formatsFetched = false;
+
+	// List of formats doesn't change during application lifetime
+	if(!formatsFetched)
+	{
+		GLint count = 0;
+		glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+		if(count > 0)
+		{
+			formats.resize(count);
+			glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, &formats[0]);
+		}
+
+		// Some drivers support ETC1 but don't list it
+		const GLubyte* extensions = glGetString(GL_EXTENSIONS);
+		if(extensions && strstr(reinterpret_cast<const char*>(extensions), "GL_OES_compressed_ETC1_RGB8_texture"))
+		{
+			formats.push_back(GL_FORMAT_ETC1_RGB8);
+		}
+
+		formatsFetched = true;
+	}
+
+	return std::find(formats.begin(), formats.end(), (GLint)glFormat) != formats.end();
+}
+
+bool LUNACompressedImage::IsEmpty() const
+{
+	return levels.empty();
+}
+
+int LUNACompressedImage::GetWidth() const
+{
+	return width;
+}
+
+int LUNACompressedImage::GetHeight() const
+{
+	return height;
+}
+
+GLenum LUNACompressedImage::GetGlFormat() const
+{
+	return glFormat;
+}
+
+bool LUNACompressedImage::HasAlpha() const
+{
+	if(glFormat == GL_FORMAT_ETC2_RGBA8) return true;
+	if(glFormat == GL_FORMAT_PVRTC_RGBA_4BPP || glFormat == GL_FORMAT_PVRTC_RGBA_2BPP) return true;
+	if(glFormat >= GL_FORMAT_ASTC_4x4 && glFormat <= GL_FORMAT_ASTC_12x12) return true;
+	return false;
+}
+
+int LUNACompressedImage::GetLevelsCount() const
+{
+	return levels.size();
+}
+
+const std::vector<unsigned char>& LUNACompressedImage::GetLevel(int level) const
+{
+	return levels[level];
+}
+
+// Check whether format of image can be uploaded to texture on current device
+bool LUNACompressedImage::IsSupported() const
+{
+	return IsFormatSupported(glFormat);
+}
+
+// Check whether image can be decoded on CPU when format isn't supported by device
+bool LUNACompressedImage::CanDecode() const
+{
+	return glFormat == GL_FORMAT_ETC1_RGB8;
+}
+
+// Decode first level to raw image. Only ETC1 format can be decoded
+LUNAImage LUNACompressedImage::Decode() const
+{
+	std::vector<unsigned char> pixels;
+	if(!CanDecode() || IsEmpty() || !etc1::Decode(&levels[0][0], levels[0].size(), width, height, pixels))
+	{
+		LUNA_LOGE("Cannot decode compressed image");
+		return LUNAImage();
+	}
+
+	return LUNAImage(width, height, LUNAColorType::RGB, std::move(pixels));
+}
@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunaimage.h"
+#include "lunagl.h"
+
+namespace luna2d{
+
+// Internal formats of compressed textures. Defined here because not all
+// platform GL headers declare formats from extensions and OpenGL ES 3.0
+const GLenum GL_FORMAT_ETC1_RGB8 = 0x8D64;
+const GLenum GL_FORMAT_ETC2_RGB8 = 0x9274;
+const GLenum GL_FORMAT_ETC2_RGBA8 = 0x9278;
+const GLenum GL_FORMAT_PVRTC_RGB_4BPP = 0x8C00;
+const GLenum GL_FORMAT_PVRTC_RGB_2BPP = 0x8C01;
+const GLenum GL_FORMAT_PVRTC_RGBA_4BPP = 0x8C02;
+const GLenum GL_FORMAT_PVRTC_RGBA_2BPP = 0x8C03;
+const GLenum GL_FORMAT_ASTC_4x4 = 0x93B0; // ASTC formats are from 0x93B0 (4x4) to 0x93BD (12x12)
+const GLenum GL_FORMAT_ASTC_12x12 = 0x93BD;
+
+//----------------------------------------------------------------
+// Image in GPU compressed format loaded from KTX or PKM container.
+// Compressed data is uploaded to texture as is
+//----------------------------------------------------------------
+class LUNACompressedImage
+{
+public:
+	LUNACompressedImage(const std::string& filename, LUNAFileLocation location = LUNAFileLocation::ASSETS);
+
+	// Construct image from data of KTX or PKM file. Type of container is selected by given file extension
+	LUNACompressedImage(const std::vector<unsigned char>& data, const std::string& ext);
+
+private:
+	int width = 0;
+	int height = 0;
+	GLenum glFormat = 0;
+	std::vector<std::vector<unsigned char>> levels; // Compressed data of each mipmap level
+
+private:
+	// Load image from data of container with given file extension
+	// Image is left empty if data cannot be loaded
+	bool Load(const std::vector<unsigned char>& data, const std::string& ext);
+
+	bool LoadKtx(const std::vector<unsigned char>& data);
+	bool LoadPkm(const std::vector<unsigned char>& data);
+
+public:
+	// Check whether given compressed format can be uploaded to texture on current device
+	static bool IsFormatSupported(GLenum glFormat);
+
+public:
+	bool IsEmpty() const;
+	int GetWidth() const;
+	int GetHeight() const;
+	GLenum GetGlFormat() const;
+	bool HasAlpha() const;
+	int GetLevelsCount() const;
+	const std::vector<unsigned char>& GetLevel(int level) const;
+
+	// Check whether format of image can be uploaded to texture on current device
+	bool IsSupported() const;
+
+	// Check whether image can be decoded on CPU when format isn't supported by device
+	bool CanDecode() const;
+
+	// Decode first level to raw image. Only ETC1 format can be decoded
+	LUNAImage Decode() const;
+};
+
+}
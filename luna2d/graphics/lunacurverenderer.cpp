@@ -23,6 +23,7 @@
 
 #include "lunacurverenderer.h"
 #include "lunasplines.h"
+#include "lunagraphics.h"
 
 using namespace luna2d;
 
@@ -306,6 +307,26 @@ void LUNACurveRenderer::Build()
 
 void LUNACurveRenderer::Render()
 {
-	if(needBuild) Build();
+	if(needBuild)
+	{
+		// Spline lies inside bounding box of knots, so skip building curve outside of camera
+		if(!knots.empty())
+		{
+			glm::vec2 minPos = knots[0];
+			glm::vec2 maxPos = knots[0];
+			for(const auto& knot : knots)
+			{
+				minPos = glm::min(minPos, knot);
+				maxPos = glm::max(maxPos, knot);
+			}
+
+			float halfWidth = width / 2.0f;
+			LUNARect bounds(minPos.x - halfWidth, minPos.y - halfWidth, maxPos.x - minPos.x + width, maxPos.y - minPos.y + width);
+			if(LUNAEngine::SharedGraphics()->GetRenderer()->IsCulled(bounds)) return;
+		}
+
+		Build();
+	}
+
 	mesh->Render();
 }
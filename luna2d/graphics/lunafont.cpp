@@ -22,32 +22,242 @@
 //-----------------------------------------------------------------------------
 
 #include "lunafont.h"
+#include "lunafontgenerator.h"
 #include "lunautf.h"
+#include "lunamath.h"
 
 using namespace luna2d;
 
-LUNAFont::LUNAFont(const std::shared_ptr<LUNATexture>& texture, int size) :
-	texture(texture),
+const int ATLAS_MIN_CHARS = 64; // Minimal count of chars which initial atlas can contain
+const int ATLAS_DEFAULT_MAX_SIZE = 2048; // Used if max texture size cannot be got from OpenGL
+
+// Get max size of atlas side supported by device
+static int GetMaxAtlasSize()
+{
+	static GLint maxSize = 0;
+
+	if(maxSize == 0)
+	{
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+		if(maxSize <= 0) maxSize = ATLAS_DEFAULT_MAX_SIZE;
+	}
+
+	return maxSize;
+}
+
+// "reserveChars" is expected count of chars to select initial size of atlas
+LUNAFont::LUNAFont(const std::shared_ptr<LUNAFontGenerator>& generator, int size, bool sdf, int reserveChars) :
+	generator(generator),
 	size(size)
 {
+	pixelSize = generator->GetPixelSize(size);
+	generator->GetMetrics(pixelSize, maxWidth, maxHeight, baseline);
+	if(sdf) spread = generator->GetSdfSpread(pixelSize);
+
+	// Select initial atlas size to contain expected chars and unknown char
+	int charArea = (maxWidth + spread * 2 + CHAR_PADDING) * (maxHeight + spread * 2 + CHAR_PADDING);
+	int totalArea = std::max(reserveChars + 1, ATLAS_MIN_CHARS) * charArea;
+	int atlasSide = std::min(math::NearestPowerOfTwo(std::ceil(std::sqrt(totalArea))), GetMaxAtlasSize());
+
+	// Empty atlas is transparent to avoid artefacts around chars
+	image = LUNAImage(atlasSide, atlasSide, LUNAColorType::ALPHA);
+
+	// Draw placeholder for unknown char
+	image.FillRectangle(spread, spread, maxWidth - 1, maxHeight, LUNAColor::WHITE);
+	unknownChar = { spread, spread, maxWidth, maxHeight, nullptr };
+	penX = maxWidth + spread * 2 + CHAR_PADDING;
+
+	RecreateTexture();
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+	// Add font to reloadable assets list
+	LUNAEngine::SharedAssets()->SetAssetReloadable(this, true);
+#endif
+}
+
+// Construct font with given size using atlas of signed distance field font
+LUNAFont::LUNAFont(const std::shared_ptr<LUNAFont>& atlasFont, int size) :
+	atlasFont(atlasFont),
+	glyphScale(size / (float)atlasFont->GetSize()),
+	size(size)
+{
+	if(!atlasFont->IsSdf()) LUNA_LOGE("Scaled font should use atlas of signed distance field font");
+}
+
+LUNAFont::~LUNAFont()
+{
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+	// Remove font from reloadable assets list
+	if(!atlasFont) LUNAEngine::SharedAssets()->SetAssetReloadable(this, false);
+#endif
 }
 
 const std::shared_ptr<LUNATextureRegion>& LUNAFont::GetCharRegion(char32_t c)
 {
-	if(chars.count(c) == 0) return unknownChar; // If char not found return unknown char region
-	return chars[c];
+	if(atlasFont) return atlasFont->GetCharRegion(c);
+
+	auto it = chars.find(c);
+	if(it != chars.end()) return it->second.region;
+
+	// Rasterize char on first use. If char cannot be rasterized return unknown char region
+	if(missingChars.count(c) == 0)
+	{
+		if(RasterizeChar(c)) return chars[c].region;
+		missingChars.insert(c);
+	}
+
+	return unknownChar.region;
 }
 
- // Set texture region for given char
-void LUNAFont::SetCharRegion(char32_t c, int x, int y, int width, int height)
+// Rasterize given char to atlas
+bool LUNAFont::RasterizeChar(char32_t c)
 {
-	chars[c] = std::make_shared<LUNATextureRegion>(texture, x, y, width, height);
+	LUNAGlyphBitmap glyph;
+	if(!generator->RenderChar(pixelSize, c, glyph, spread)) return false;
+
+	// Skip all empty chars except space
+	if((glyph.width == 0 || glyph.height == 0) && c != ' ') return false;
+
+	// Bitmap can be wider than advance, so reserve place for whole bitmap
+	// Distance field of SDF font char is expanded by spread to margin around char
+	int bitmapX = std::max(-spread, glyph.left);
+	int cellWidth = std::max(glyph.advance, bitmapX + glyph.width) + spread * 2;
+	int cellX, cellY;
+	if(!AllocateChar(cellWidth, cellX, cellY))
+	{
+		LUNA_LOGE("Cannot place char with code %u to font atlas", (unsigned int)c);
+		return false;
+	}
+
+	int x = cellX + spread;
+	int y = cellY + spread;
+	int cellBottom = y + maxHeight + spread;
+
+	// Draw char bitmap to atlas. Bitmap is clipped by char cell to keep neighbour chars intact
+	int bitmapY = y + maxHeight - baseline - glyph.top;
+	int skipRows = std::max(0, cellY - bitmapY);
+	int drawRows = std::min(glyph.height, cellBottom - bitmapY) - skipRows;
+	if(drawRows > 0)
+	{
+		image.DrawRawBuffer(x + bitmapX, bitmapY + skipRows, glyph.buffer + skipRows * glyph.width,
+			glyph.width, drawRows, LUNAColorType::ALPHA);
+	}
+
+	// Mark rows of char as changed
+	if(dirtyBegin == dirtyEnd) dirtyBegin = cellY;
+	dirtyBegin = std::min(dirtyBegin, cellY);
+	dirtyEnd = std::max(dirtyEnd, cellBottom);
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+	needCache = true;
+#endif
+
+	auto region = std::make_shared<LUNATextureRegion>(texture, x, y, glyph.advance, maxHeight);
+	chars[c] = { x, y, glyph.advance, maxHeight, region };
+
+	return true;
 }
 
- // Set texture region for unknown char
-void LUNAFont::SetUnknownCharRegion(int x, int y, int width, int height)
+// Find place for char with given width in atlas. Grows atlas if needed
+bool LUNAFont::AllocateChar(int width, int& x, int& y)
 {
-	unknownChar = std::make_shared<LUNATextureRegion>(texture, x, y, width, height);
+	int rowHeight = maxHeight + spread * 2;
+
+	// Move pen to next row
+	if(penX + width > image.GetWidth())
+	{
+		penY += rowHeight + CHAR_PADDING;
+		penX = 0;
+	}
+
+	while(penX + width > image.GetWidth() || penY + rowHeight > image.GetHeight())
+	{
+		if(!GrowAtlas()) return false;
+	}
+
+	x = penX;
+	y = penY;
+	penX += width + CHAR_PADDING;
+
+	return true;
+}
+
+// Double one of sides of atlas and recreate texture with regions
+bool LUNAFont::GrowAtlas()
+{
+	int maxSize = GetMaxAtlasSize();
+	int width = image.GetWidth();
+	int height = image.GetHeight();
+
+	// Keep atlas close to square. Chars keep their positions because rows of image are preserved
+	if((height <= width || width * 2 > maxSize) && height * 2 <= maxSize) height *= 2;
+	else if(width * 2 <= maxSize) width *= 2;
+	else return false;
+
+	image.SetSize(width, height);
+	RecreateTexture();
+
+	return true;
+}
+
+void LUNAFont::RecreateTexture()
+{
+	texture = std::make_shared<LUNATexture>(image);
+
+	for(auto& entry : chars)
+	{
+		Char& ch = entry.second;
+		ch.region = std::make_shared<LUNATextureRegion>(texture, ch.x, ch.y, ch.width, ch.height);
+	}
+
+	unknownChar.region = std::make_shared<LUNATextureRegion>(texture,
+		unknownChar.x, unknownChar.y, unknownChar.width, unknownChar.height);
+
+	// Whole image is uploaded with new texture
+	dirtyBegin = 0;
+	dirtyEnd = 0;
+	generation++;
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+	needCache = true;
+#endif
+}
+
+// Rasterize given chars to atlas immediately
+void LUNAFont::PreloadChars(const std::u32string& chars)
+{
+	if(atlasFont)
+	{
+		atlasFont->PreloadChars(chars);
+		return;
+	}
+
+	for(char32_t c : chars) GetCharRegion(c);
+	UploadChanges();
+}
+
+// Upload changed rows of atlas to texture
+void LUNAFont::UploadChanges()
+{
+	if(atlasFont)
+	{
+		atlasFont->UploadChanges();
+		return;
+	}
+
+	if(dirtyBegin == dirtyEnd) return;
+
+	texture->UpdateRows(image, dirtyBegin, dirtyEnd - dirtyBegin);
+
+	dirtyBegin = 0;
+	dirtyEnd = 0;
+}
+
+// Generation is incremented each time when atlas texture is recreated
+int LUNAFont::GetGeneration()
+{
+	if(atlasFont) return atlasFont->GetGeneration();
+	return generation;
 }
 
 std::weak_ptr<LUNATextureRegion> LUNAFont::GetRegionForChar(char32_t c)
@@ -55,11 +265,31 @@ std::weak_ptr<LUNATextureRegion> LUNAFont::GetRegionForChar(char32_t c)
 	return GetCharRegion(c);
 }
 
+std::weak_ptr<LUNATexture> LUNAFont::GetTexture()
+{
+	if(atlasFont) return atlasFont->GetTexture();
+	return texture;
+}
+
 int LUNAFont::GetSize()
 {
 	return size;
 }
 
+// Check for font is signed distance field font. Such fonts should be rendered with SDF font shader
+// SEE: "LUNARenderer::GetSdfFontShader"
+bool LUNAFont::IsSdf()
+{
+	if(atlasFont) return atlasFont->IsSdf();
+	return spread > 0;
+}
+
+// Get scale which should be applied to sizes of texture regions of chars
+float LUNAFont::GetGlyphScale()
+{
+	return glyphScale;
+}
+
 // Get width of one-line string typed with this font
 float LUNAFont::GetStringWidth(const std::string& string)
 {
@@ -67,7 +297,7 @@ float LUNAFont::GetStringWidth(const std::string& string)
 
 	for(auto c : utf::ToUtf32(string)) width += GetCharRegion(c)->GetWidthPoints();
 
-	return width;
+	return width * glyphScale;
 }
 
 // Get height of one-line string typed with this font
@@ -77,5 +307,21 @@ float LUNAFont::GetStringHeight(const std::string& string)
 
 	for(auto c : utf::ToUtf32(string)) maxHeight = std::max(maxHeight, GetCharRegion(c)->GetHeight());
 
-	return maxHeight;
+	return maxHeight * glyphScale;
+}
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+void LUNAFont::Reload()
+{
+	// Texture is reloaded from cached atlas image
+	texture->Reload();
+}
+
+void LUNAFont::Cache()
+{
+	if(!needCache) return;
+
+	texture->Cache(image.GetData(), false);
+	needCache = false;
 }
+#endif
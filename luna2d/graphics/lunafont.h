@@ -24,34 +24,107 @@
 #pragma once
 
 #include "lunatextureregion.h"
+#include "lunaimage.h"
+#include <unordered_set>
 
 namespace luna2d{
 
+class LUNAFontGenerator;
+
+//--------------------------------------------------------
+// Bitmap font with dynamic atlas
+// Chars are rasterized by font generator on first use and
+// packed to rows of atlas. Atlas grows when it's full.
+// Texture of atlas is recreated on growing, so texture regions
+// got from font before should be requested again when
+// generation of font is changed
+// Atlas of signed distance field font can be shared by
+// fonts with other sizes, which scale its glyphs
+//--------------------------------------------------------
 class LUNAFont : public LUNAAsset
 {
 	LUNA_USERDATA_DERIVED(LUNAAsset, LUNAFont)
 
 public:
-	LUNAFont(const std::shared_ptr<LUNATexture>& texture, int size);
+	// "reserveChars" is expected count of chars to select initial size of atlas
+	LUNAFont(const std::shared_ptr<LUNAFontGenerator>& generator, int size, bool sdf = false, int reserveChars = 0);
+
+	// Construct font with given size using atlas of signed distance field font
+	LUNAFont(const std::shared_ptr<LUNAFont>& atlasFont, int size);
+	virtual ~LUNAFont();
+
+private:
+	// Char placed in atlas
+	struct Char
+	{
+		int x, y, width, height; // Rectangle of char in atlas (in pixels)
+		std::shared_ptr<LUNATextureRegion> region;
+	};
 
 private:
+	std::shared_ptr<LUNAFontGenerator> generator;
+	std::shared_ptr<LUNAFont> atlasFont; // Font owning shared atlas
+	float glyphScale = 1; // Scale of glyphs from shared atlas
+	LUNAImage image; // Atlas image. Kept on CPU for growing atlas and uploading changed rows
 	std::shared_ptr<LUNATexture> texture;
-	std::unordered_map<char32_t, std::shared_ptr<LUNATextureRegion>> chars;
-	std::shared_ptr<LUNATextureRegion> unknownChar;
+	std::unordered_map<char32_t, Char> chars;
+	std::unordered_set<char32_t> missingChars; // Chars which cannot be rasterized
+	Char unknownChar;
 	int size;
+	int pixelSize = 0;
+	int maxWidth = 0, maxHeight = 0, baseline = 0; // Global char metrics (in pixels)
+	int spread = 0; // Spread of distance field for SDF font. Chars in atlas have margin of this size
+	int penX = 0, penY = 0; // Position for next char in atlas
+	int dirtyBegin = 0, dirtyEnd = 0; // Rows of atlas changed since last uploading
+	int generation = 0;
 
 private:
 	const std::shared_ptr<LUNATextureRegion>& GetCharRegion(char32_t c);
 
+	// Rasterize given char to atlas
+	bool RasterizeChar(char32_t c);
+
+	// Find place for char with given width in atlas. Grows atlas if needed
+	bool AllocateChar(int width, int& x, int& y);
+
+	// Double one of sides of atlas and recreate texture with regions
+	bool GrowAtlas();
+	void RecreateTexture();
+
 public:
-	void SetCharRegion(char32_t c, int x, int y, int width, int height); // Set texture region for given char
-	void SetUnknownCharRegion(int x, int y, int width, int height); // Set texture region for unknown char
+	// Rasterize given chars to atlas immediately
+	void PreloadChars(const std::u32string& chars);
+
+	// Upload changed rows of atlas to texture
+	void UploadChanges();
+
+	// Generation is incremented each time when atlas texture is recreated
+	int GetGeneration();
 
 	std::weak_ptr<LUNATextureRegion> GetRegionForChar(char32_t c);
+	std::weak_ptr<LUNATexture> GetTexture();
 	int GetSize();
 
+	// Check for font is signed distance field font. Such fonts should be rendered with SDF font shader
+	// SEE: "LUNARenderer::GetSdfFontShader"
+	bool IsSdf();
+
+	// Get scale which should be applied to sizes of texture regions of chars
+	float GetGlyphScale();
+
 	float GetStringWidth(const std::string& string); // Get width of one-line string typed with this font
 	float GetStringHeight(const std::string& string); // Get height of one-line string typed with this font
+
+// Reload atlas texture when application lost OpenGL context
+// SEE: "lunaassets.h"
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+private:
+	bool needCache = false;
+
+public:
+	virtual void Reload();
+	virtual void Cache();
+#endif
 };
 
 }
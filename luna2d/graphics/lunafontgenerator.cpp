@@ -33,16 +33,8 @@ const std::u32string CYRILLIC_CHARS = LUNA_UTF32("йцукенгшщзхъфыв
 const std::u32string COMMON_CHARS = LUNA_UTF32(" !@#$%^&*()-+=!№?¿<>[]{}:;,.\\/|`~'\"_©");
 const std::u32string NUMBER_CHARS = LUNA_UTF32("1234567890");
 
-struct CharRegion
-{
-	CharRegion(char32_t c, int x, int y, int width, int height) : c(c), x(x), y(y), width(width), height(height) {}
-
-	char32_t c = '\0';
-	int x = 0;
-	int y = 0;
-	int width = 0;
-	int height = 0;
-};
+const int SDF_MIN_SPREAD = 2; // Min distance represented by distance field (in pixels)
+const double EDT_INF = 1e20;
 
 LUNAFontGenerator::~LUNAFontGenerator()
 {
@@ -61,13 +53,111 @@ int LUNAFontGenerator::PixelsToUnits(int pixels)
 	return pixels * 64;
 }
 
+void LUNAFontGenerator::SetPixelSize(int pixelSize)
+{
+	if(currentPixelSize == pixelSize) return;
+
+	FT_Set_Char_Size(face, PixelsToUnits(pixelSize), 0, 0, 0);
+	currentPixelSize = pixelSize;
+}
+
+// Squared euclidean distance transform of grid in place by Felzenszwalb and Huttenlocher algorithm
+// Transform is separable, so it's made by columns and then by rows in linear time
+void LUNAFontGenerator::TransformGrid(std::vector<double>& grid, int width, int height)
+{
+	int maxSide = std::max(width, height);
+	edtValues.resize(maxSide);
+	edtParabolas.resize(maxSide);
+	edtBounds.resize(maxSide + 1);
+
+	for(int x = 0; x < width; x++) TransformLine(&grid[x], height, width);
+	for(int y = 0; y < height; y++) TransformLine(&grid[y * width], width, 1);
+}
+
+void LUNAFontGenerator::TransformLine(double* line, int count, int stride)
+{
+	for(int i = 0; i < count; i++) edtValues[i] = line[i * stride];
+
+	// Build lower envelope of parabolas rooted at each sample
+	int k = 0;
+	edtParabolas[0] = 0;
+	edtBounds[0] = -EDT_INF;
+	edtBounds[1] = EDT_INF;
+
+	for(int q = 1; q < count; q++)
+	{
+		double s;
+
+		while(true)
+		{
+			int r = edtParabolas[k];
+			s = ((edtValues[q] + q * q) - (edtValues[r] + r * r)) / (2 * q - 2 * r);
+			if(s > edtBounds[k] || k == 0) break;
+			k--;
+		}
+
+		k++;
+		edtParabolas[k] = q;
+		edtBounds[k] = s;
+		edtBounds[k + 1] = EDT_INF;
+	}
+
+	// Sample lower envelope
+	k = 0;
+	for(int q = 0; q < count; q++)
+	{
+		while(edtBounds[k + 1] < q) k++;
+
+		int r = edtParabolas[k];
+		line[q * stride] = (q - r) * (q - r) + edtValues[r];
+	}
+}
+
+// Convert rendered bitmap to signed distance field expanded by spread on each side
+void LUNAFontGenerator::MakeDistanceField(const FT_Bitmap& bmp, int spread)
+{
+	int width = bmp.width + spread * 2;
+	int height = bmp.rows + spread * 2;
+	int pitch = std::abs(bmp.pitch);
+	size_t size = width * height;
+
+	// Pixels covered by char more than by half are inside of char. Expanded border is outside of char
+	distanceInside.assign(size, 0);
+	distanceOutside.assign(size, EDT_INF);
+	for(int y = 0; y < (int)bmp.rows; y++)
+	{
+		for(int x = 0; x < (int)bmp.width; x++)
+		{
+			if(bmp.buffer[y * pitch + x] < 128) continue;
+
+			size_t pos = (y + spread) * width + x + spread;
+			distanceInside[pos] = EDT_INF;
+			distanceOutside[pos] = 0;
+		}
+	}
+
+	// After transform "distanceInside" contains squared distances from inside pixels to nearest outside pixel
+	// and "distanceOutside" contains squared distances from outside pixels to nearest inside pixel
+	TransformGrid(distanceInside, width, height);
+	TransformGrid(distanceOutside, width, height);
+
+	// Edge of char is between centers of inside and outside pixels. Edge is stored as 0.5
+	distanceField.resize(size);
+	for(size_t i = 0; i < size; i++)
+	{
+		double distance = distanceInside[i] > 0 ? std::sqrt(distanceInside[i]) - 0.5 : 0.5 - std::sqrt(distanceOutside[i]);
+		double value = 0.5 + distance / (2 * spread);
+		distanceField[i] = (unsigned char)std::round(std::max(0.0, std::min(value, 1.0)) * 255);
+	}
+}
+
 void LUNAFontGenerator::ResetCharSets()
 {
-	enableLatin = true;
-	enableDiactritic = true;
-	enableCyrillic = true;
-	enableCommon = true;
-	enableNumbers = true;
+	enableLatin = false;
+	enableDiactritic = false;
+	enableCyrillic = false;
+	enableCommon = false;
+	enableNumbers = false;
 	customSymbols.clear();
 }
 
@@ -88,108 +178,97 @@ bool LUNAFontGenerator::Load(const std::string& filename, LUNAFileLocation locat
 	return true;
 }
 
-std::shared_ptr<LUNAFont> LUNAFontGenerator::GenerateFont(int size)
+// Get size of font in pixels for given size in game points
+int LUNAFontGenerator::GetPixelSize(int size)
 {
-	if(!face) return nullptr;
-
 	// For same font size on all resolutions size
 	// scale font size to virtual screen resolution and sets default DPI
-	int fontSize = std::floor(size / LUNAEngine::SharedSizes()->GetTextureScale());
-	FT_Set_Char_Size(face, PixelsToUnits(fontSize), 0, 0, 0);
-
-	// Select available chars
-	std::u32string chars;
-
-	if(enableLatin) chars += LATIN_CHARS;
-	if(enableDiactritic) chars += DIACTRITIC_CHARS;
-	if(enableCyrillic) chars += CYRILLIC_CHARS;
-	if(enableCommon) chars += COMMON_CHARS;
-	if(enableNumbers) chars += NUMBER_CHARS;
-	if(!customSymbols.empty()) chars += customSymbols;
+	return std::floor(size / LUNAEngine::SharedSizes()->GetTextureScale());
+}
 
-	// Get global char metrics
-	int maxW = UnitsToPixels(face->size->metrics.max_advance); // Max char width
-	int maxH = UnitsToPixels(face->size->metrics.height); // Max char height
-	int baseline = std::fabs((float)UnitsToPixels(face->size->metrics.descender)); // Distance from bottom to baseline
+// Get global char metrics for given size in pixels
+void LUNAFontGenerator::GetMetrics(int pixelSize, int& maxWidth, int& maxHeight, int& baseline)
+{
+	SetPixelSize(pixelSize);
 
-	// Calculate texture size
-	int charArea = (maxW + CHAR_PADDING) * (maxH + CHAR_PADDING);
-	int totalArea = (chars.size() + 1 /* + unknown char */) * charArea;
-	int textureSide = math::NearestPowerOfTwo(std::ceil(std::sqrt(totalArea)));
+	maxWidth = UnitsToPixels(face->size->metrics.max_advance); // Max char width
+	maxHeight = UnitsToPixels(face->size->metrics.height); // Max char height
+	baseline = std::fabs((float)UnitsToPixels(face->size->metrics.descender)); // Distance from bottom to baseline
+}
 
-	LUNAImage image(textureSide, textureSide, LUNAColorType::ALPHA);
+// Get spread of distance field for given size in pixels
+int LUNAFontGenerator::GetSdfSpread(int pixelSize)
+{
+	return std::max(SDF_MIN_SPREAD, pixelSize / 8);
+}
 
-	// Fill image with white transparent color to avoid black artefacts around chars
-	image.Fill(LUNAColor::Rgb(255, 255, 255, 0));
+// Render bitmap of given char with given size in pixels
+// If spread isn't zero, bitmap is converted to signed distance field expanded by spread on each side
+bool LUNAFontGenerator::RenderChar(int pixelSize, char32_t c, LUNAGlyphBitmap& glyph, int spread)
+{
+	if(!face) return false;
 
-	// Draw placeholder for unknown char
-	image.FillRectangle(0, 0, maxW - 1, maxH, LUNAColor::WHITE);
+	SetPixelSize(pixelSize);
 
-	std::vector<CharRegion> charRegions;
-	int penX = maxW;
-	int penY = 0;
+	FT_Error error = FT_Load_Char(face, c, FT_LOAD_RENDER);
+	if(error) return false;
 
-	// Draw chars on image
-	for(char32_t c : chars)
+	FT_Bitmap bmp = face->glyph->bitmap;
+	if(bmp.pixel_mode != FT_PIXEL_MODE_GRAY)
 	{
-		FT_Error error = FT_Load_Char(face, c, FT_LOAD_RENDER);
-		if(error) continue;
-
-		FT_Bitmap bmp = face->glyph->bitmap;
-		if(bmp.pixel_mode != FT_PIXEL_MODE_GRAY)
-		{
-			LUNA_LOGE("Supported only FT_PIXEL_MODE_GRAY");
-			continue;
-		}
-
-		// Move pen to next line
-		if(penX + maxW > image.GetWidth())
-		{
-			penY += maxH + CHAR_PADDING;
-			penX = 0;
-		}
-
-		int bmpWidth = bmp.width;
-		int bmpHeight = bmp.rows;
-
-		// Skip all empty chars except space
-		if((bmpWidth == 0 || bmpHeight == 0) && c != ' ') continue;
-
-		int charW = UnitsToPixels(face->glyph->advance.x);
-		int charH = std::min(bmpHeight, maxH);
-		int charDescender = charH - face->glyph->bitmap_top;
-		int charX = penX + (face->glyph->bitmap_left > 0 ? face->glyph->bitmap_left : 0);
-		int charY = penY + maxH - charH - baseline + charDescender;
+		LUNA_LOGE("Supported only FT_PIXEL_MODE_GRAY");
+		return false;
+	}
 
-		// Draw char bimtap to image
-		image.DrawRawBuffer(charX, charY, bmp.buffer, bmpWidth, bmpHeight, LUNAColorType::ALPHA);
+	glyph.buffer = bmp.buffer;
+	glyph.width = bmp.width;
+	glyph.height = bmp.rows;
+	glyph.left = face->glyph->bitmap_left;
+	glyph.top = face->glyph->bitmap_top;
+	glyph.advance = UnitsToPixels(face->glyph->advance.x);
 
-		charRegions.push_back(CharRegion(c, penX, penY, charW, maxH));
+	// Empty bitmaps hasn't distance field
+	if(spread > 0 && glyph.width > 0 && glyph.height > 0)
+	{
+		MakeDistanceField(bmp, spread);
 
-		penX += charW + CHAR_PADDING;
+		glyph.buffer = distanceField.data();
+		glyph.width += spread * 2;
+		glyph.height += spread * 2;
+		glyph.left -= spread;
+		glyph.top += spread;
 	}
 
-	if(image.IsEmpty()) return nullptr;
+	return true;
+}
+
+// Get chars selected by charset flags
+std::u32string LUNAFontGenerator::GetSelectedChars()
+{
+	std::u32string chars;
 
-	// Crop empty space in texture if possible
-	int croppedHeight = math::NearestPowerOfTwo(penY + maxH);
-	if(croppedHeight < image.GetHeight()) image.SetSize(image.GetWidth(), croppedHeight);
+	if(enableLatin) chars += LATIN_CHARS;
+	if(enableDiactritic) chars += DIACTRITIC_CHARS;
+	if(enableCyrillic) chars += CYRILLIC_CHARS;
+	if(enableCommon) chars += COMMON_CHARS;
+	if(enableNumbers) chars += NUMBER_CHARS;
+	if(!customSymbols.empty()) chars += customSymbols;
 
-	// Create texture from generated image
-	auto texture = std::make_shared<LUNATexture>(image);
+	return chars;
+}
 
-#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
-	// Cache generated texture to APP_DATA folder for reloading when lossing GL context
-	texture->Cache(image.GetData());
-#endif
+// Create bitmap font with given size. Generator should be owned by shared pointer,
+// because font keeps reference to generator for rasterizing chars on first use
+// Signed distance field font can be rendered with any scale without blurring
+std::shared_ptr<LUNAFont> LUNAFontGenerator::GenerateFont(int size, bool sdf)
+{
+	if(!face) return nullptr;
 
-	// Create font
-	auto font = std::make_shared<LUNAFont>(texture, size);
+	// Selected chars are rasterized immediately
+	std::u32string chars = GetSelectedChars();
 
-	// Set texture regions for chars
-	for(auto region : charRegions) font->SetCharRegion(region.c, region.x, region.y, region.width, region.height);
-	font->SetUnknownCharRegion(0, 0, maxW, maxH);
+	auto font = std::make_shared<LUNAFont>(shared_from_this(), size, sdf, chars.size());
+	font->PreloadChars(chars);
 
 	return font;
 }
-
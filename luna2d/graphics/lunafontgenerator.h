@@ -39,10 +39,18 @@ namespace luna2d{
 
 const int CHAR_PADDING = 3; // Size of padding between chars(in pixels)
 
-//----------------------------------------------
-// Util for generate bitmap fonts using FreeType
-//----------------------------------------------
-class LUNAFontGenerator
+// Rendered bitmap of one char. Buffer is owned by generator and valid until next char rendering
+struct LUNAGlyphBitmap
+{
+	const unsigned char* buffer = nullptr;
+	int width = 0;
+	int height = 0;
+	int left = 0; // Distance from pen position to left side of bitmap
+	int top = 0; // Distance from baseline to top side of bitmap
+	int advance = 0; // Distance from pen position to pen position of next char
+};
+
+class LUNAFontGenerator : public std::enable_shared_from_this<LUNAFontGenerator>
 {
 public:
 	~LUNAFontGenerator();
@@ -51,13 +59,22 @@ private:
 	FT_Library library = nullptr;
 	FT_Face face = nullptr;
 	std::vector<unsigned char> fontBuffer;
+	int currentPixelSize = 0; // Fonts with different sizes share one face, so size is set before rendering
+
+	// Buffers for making distance fields
+	std::vector<unsigned char> distanceField;
+	std::vector<double> distanceInside, distanceOutside;
+	std::vector<double> edtValues, edtBounds;
+	std::vector<int> edtParabolas;
 
 public:
-	bool enableLatin = true;
-	bool enableDiactritic = true;
-	bool enableCyrillic = true;
-	bool enableCommon = true;
-	bool enableNumbers = true;
+	// Chars which should be rasterized when font is generated
+	// Other chars are rasterized on first use
+	bool enableLatin = false;
+	bool enableDiactritic = false;
+	bool enableCyrillic = false;
+	bool enableCommon = false;
+	bool enableNumbers = false;
 	std::u32string customSymbols;
 
 private:
@@ -65,10 +82,40 @@ private:
 	int UnitsToPixels(int units);
 	int PixelsToUnits(int pixels);
 
+	void SetPixelSize(int pixelSize);
+
+	// Squared euclidean distance transform of grid in place by Felzenszwalb and Huttenlocher algorithm
+	// Transform is separable, so it's made by columns and then by rows in linear time
+	void TransformGrid(std::vector<double>& grid, int width, int height);
+	void TransformLine(double* line, int count, int stride);
+
+	// Convert rendered bitmap to signed distance field expanded by spread on each side
+	void MakeDistanceField(const FT_Bitmap& bmp, int spread);
+
 public:
 	void ResetCharSets();
 	bool Load(const std::string& filename, LUNAFileLocation location = LUNAFileLocation::ASSETS); // Load
-	std::shared_ptr<LUNAFont> GenerateFont(int size); // Create bitmap font with given size
+
+	// Get size of font in pixels for given size in game points
+	int GetPixelSize(int size);
+
+	// Get global char metrics for given size in pixels
+	void GetMetrics(int pixelSize, int& maxWidth, int& maxHeight, int& baseline);
+
+	// Get spread of distance field for given size in pixels
+	int GetSdfSpread(int pixelSize);
+
+	// Render bitmap of given char with given size in pixels
+	// If spread isn't zero, bitmap is converted to signed distance field expanded by spread on each side
+	bool RenderChar(int pixelSize, char32_t c, LUNAGlyphBitmap& glyph, int spread = 0);
+
+	// Get chars selected by charset flags
+	std::u32string GetSelectedChars();
+
+	// Create bitmap font with given size. Generator should be owned by shared pointer,
+	// because font keeps reference to generator for rasterizing chars on first use
+	// Signed distance field font can be rendered with any scale without blurring
+	std::shared_ptr<LUNAFont> GenerateFont(int size, bool sdf = false);
 };
 
 }
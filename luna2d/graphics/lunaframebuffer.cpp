@@ -23,27 +23,34 @@
 
 #include "lunaframebuffer.h"
 #include "lunagraphics.h"
-#include "lunamath.h"
 #include "lunapngformat.h"
+#include "lunaglstate.h"
 
 using namespace luna2d;
 
-LUNAFrameBuffer::LUNAFrameBuffer(int viewportWidth, int viewportHeight) :
+// Texture has same size as viewport. Non-power-of-two size is supported
+// by OpenGL ES 2.0 for clamped textures without mipmaps, that suits render targets
+LUNAFrameBuffer::LUNAFrameBuffer(int viewportWidth, int viewportHeight, LUNAColorType colorType) :
 	viewportWidth(viewportWidth),
 	viewportHeight(viewportHeight),
-	texture(std::make_shared<LUNATexture>(math::NearestPowerOfTwo(viewportWidth), math::NearestPowerOfTwo(viewportHeight),
-		LUNAColorType::RGBA))
+	texture(std::make_shared<LUNATexture>(viewportWidth, viewportHeight,
+		IsColorRenderable(colorType) ? colorType : LUNAColorType::RGBA))
 {
-	GLint prevId = 0;
-	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevId);
+	if(!IsColorRenderable(colorType))
+	{
+		LUNA_LOGE("Framebuffer cannot have color type \"%s\", \"rgba\" is used instead",
+			COLOR_TYPE.FromEnum(colorType).c_str());
+	}
+
+	GLuint prevId = glstate::GetFramebuffer();
 
 	glGenFramebuffers(1, &id);
-	glBindFramebuffer(GL_FRAMEBUFFER, id);
+	glstate::BindFramebuffer(id);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->GetId(), 0);
 
 	if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) LUNA_LOGE("Failed to create GL framebuffer");
 
-	glBindFramebuffer(GL_FRAMEBUFFER, prevId);
+	glstate::BindFramebuffer(prevId);
 
 #if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
 	// Add framebuffer to reloadable assets list
@@ -53,7 +60,7 @@ LUNAFrameBuffer::LUNAFrameBuffer(int viewportWidth, int viewportHeight) :
 
 LUNAFrameBuffer::~LUNAFrameBuffer()
 {
-	glDeleteFramebuffers(1, &id);
+	glstate::DeleteFramebuffers(1, &id);
 
 #if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
 	// Remove framebuffer from reloadable assets list
@@ -76,6 +83,17 @@ int LUNAFrameBuffer::GetViewportHeight()
 	return viewportHeight;
 }
 
+LUNAColorType LUNAFrameBuffer::GetColorType()
+{
+	return texture->GetColorType();
+}
+
+// Get size of attached texture in video memory (in bytes)
+size_t LUNAFrameBuffer::GetMemorySize()
+{
+	return texture->GetMemorySize();
+}
+
 std::shared_ptr<LUNATexture> LUNAFrameBuffer::GetTexture()
 {
 	return texture;
@@ -96,14 +114,13 @@ std::shared_ptr<LUNAImage> LUNAFrameBuffer::ReadPixels()
 {
 	std::vector<unsigned char> data(viewportWidth * viewportHeight * GetBytesPerPixel(LUNAColorType::RGBA));
 
-	GLint prevId = 0;
-	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevId);
+	GLuint prevId = glstate::GetFramebuffer();
 
-	glBindFramebuffer(GL_FRAMEBUFFER, id);
-	glViewport(0, 0, viewportWidth, viewportHeight);
+	glstate::BindFramebuffer(id);
+	glstate::Viewport(0, 0, viewportWidth, viewportHeight);
 	glPixelStorei(GL_PACK_ALIGNMENT, 1);
 	glReadPixels(0, 0, viewportWidth, viewportHeight, GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
-	glBindFramebuffer(GL_FRAMEBUFFER, prevId);
+	glstate::BindFramebuffer(prevId);
 	LUNAEngine::SharedGraphics()->GetRenderer()->SetDefaultViewport();
 
 	auto pixmap = std::make_shared<LUNAImage>(viewportWidth, viewportHeight, LUNAColorType::RGBA, data);
@@ -113,9 +130,9 @@ std::shared_ptr<LUNAImage> LUNAFrameBuffer::ReadPixels()
 
 void LUNAFrameBuffer::Bind()
 {
-	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &this->prevId);
-	glBindFramebuffer(GL_FRAMEBUFFER, id);
-	glViewport(0, 0, viewportWidth, viewportHeight);
+	prevId = glstate::GetFramebuffer();
+	glstate::BindFramebuffer(id);
+	glstate::Viewport(0, 0, viewportWidth, viewportHeight);
 
 #if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
 	needCache = true;
@@ -124,7 +141,7 @@ void LUNAFrameBuffer::Bind()
 
 void LUNAFrameBuffer::Unbind()
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, this->prevId);
+	glstate::BindFramebuffer(prevId);
 	LUNAEngine::SharedGraphics()->GetRenderer()->SetDefaultViewport();
 }
 
@@ -138,16 +155,15 @@ void LUNAFrameBuffer::Reload()
 	texture->Reload();
 
 	// Recreate framebuffer
-	GLint prevId = 0;
-	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevId);
+	GLuint prevId = glstate::GetFramebuffer();
 
 	glGenFramebuffers(1, &id);
-	glBindFramebuffer(GL_FRAMEBUFFER, id);
+	glstate::BindFramebuffer(id);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture->GetId(), 0);
 
 	if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) LUNA_LOGE("Failed to create GL framebuffer");
 
-	glBindFramebuffer(GL_FRAMEBUFFER, prevId);
+	glstate::BindFramebuffer(prevId);
 }
 
 void LUNAFrameBuffer::Cache()
@@ -156,16 +172,23 @@ void LUNAFrameBuffer::Cache()
 
 	std::vector<unsigned char> data(texture->GetWidth() * texture->GetHeight() * GetBytesPerPixel(LUNAColorType::RGBA));
 
-	GLint prevId = 0;
-	glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevId);
+	GLuint prevId = glstate::GetFramebuffer();
 
-	glBindFramebuffer(GL_FRAMEBUFFER, id);
-	glViewport(0, 0, viewportWidth, viewportHeight);
+	glstate::BindFramebuffer(id);
+	glstate::Viewport(0, 0, viewportWidth, viewportHeight);
 	glPixelStorei(GL_PACK_ALIGNMENT, 1);
 	glReadPixels(0, 0, texture->GetWidth(), texture->GetHeight(), GL_RGBA, GL_UNSIGNED_BYTE, &data[0]);
-	glBindFramebuffer(GL_FRAMEBUFFER, prevId);
+	glstate::BindFramebuffer(prevId);
 	LUNAEngine::SharedGraphics()->GetRenderer()->SetDefaultViewport();
 
+	// Texture is reloaded from data in its own color type
+	if(texture->GetColorType() == LUNAColorType::RGB)
+	{
+		size_t count = texture->GetWidth() * texture->GetHeight();
+		for(size_t i = 0; i < count; i++) std::memmove(&data[i * 3], &data[i * 4], 3);
+		data.resize(count * GetBytesPerPixel(LUNAColorType::RGB));
+	}
+
 	texture->Cache(data, false);
 
 	needCache = false;
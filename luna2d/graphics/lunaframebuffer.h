@@ -33,12 +33,13 @@ class LUNAFrameBuffer : public LUNAAsset
 	LUNA_USERDATA_DERIVED(LUNAAsset, LUNAFrameBuffer)
 
 public:
-	LUNAFrameBuffer(int viewPortWidth, int viewPortHeight);
+	// Color type should be "RGB" or "RGBA", "RGBA" is used instead of other color types
+	LUNAFrameBuffer(int viewportWidth, int viewportHeight, LUNAColorType colorType = LUNAColorType::RGBA);
 	~LUNAFrameBuffer();
 
 private:
 	GLuint id = 0;
-	GLint prevId = 0;
+	GLuint prevId = 0;
 	int viewportWidth, viewportHeight;
 	std::shared_ptr<LUNATexture> texture;
 
@@ -46,6 +47,8 @@ public:
 	GLuint GetId();
 	int GetViewportWidth();
 	int GetViewportHeight();
+	LUNAColorType GetColorType();
+	size_t GetMemorySize(); // Get size of attached texture in video memory (in bytes)
 	std::shared_ptr<LUNATexture> GetTexture();
 	std::shared_ptr<LUNATextureRegion> GetTextureRegion();
 	std::shared_ptr<LUNAImage> ReadPixels();
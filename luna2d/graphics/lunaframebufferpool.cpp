@@ -0,0 +1,122 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaframebufferpool.h"
+
+using namespace luna2d;
+
+LUNAFrameBufferPool::~LUNAFrameBufferPool()
+{
+	Clear();
+}
+
+uint64_t LUNAFrameBufferPool::MakeKey(int width, int height, LUNAColorType colorType)
+{
+	return ((uint64_t)width << 32) | ((uint64_t)height << 8) | (uint64_t)colorType;
+}
+
+// Get framebuffer with given size and color type. Content of framebuffer is undefined
+// Returns nullptr if color type cannot be used for framebuffer
+std::shared_ptr<LUNAFrameBuffer> LUNAFrameBufferPool::Acquire(int width, int height, LUNAColorType colorType)
+{
+	if(!IsColorRenderable(colorType))
+	{
+		LUNA_LOGE("Framebuffer cannot have color type \"%s\"", COLOR_TYPE.FromEnum(colorType).c_str());
+		return nullptr;
+	}
+
+	auto it = freeFrameBuffers.find(MakeKey(width, height, colorType));
+	if(it != freeFrameBuffers.end() && !it->second.empty())
+	{
+		auto frameBuffer = it->second.back();
+		it->second.pop_back();
+		return frameBuffer;
+	}
+
+	// Forget framebuffers deleted outside of pool
+	createdFrameBuffers.erase(std::remove_if(createdFrameBuffers.begin(), createdFrameBuffers.end(),
+		[](const std::weak_ptr<LUNAFrameBuffer>& frameBuffer) { return frameBuffer.expired(); }), createdFrameBuffers.end());
+
+	auto frameBuffer = std::make_shared<LUNAFrameBuffer>(width, height, colorType);
+	createdFrameBuffers.push_back(frameBuffer);
+	return frameBuffer;
+}
+
+// Return framebuffer to pool for reusing
+void LUNAFrameBufferPool::Release(const std::shared_ptr<LUNAFrameBuffer>& frameBuffer)
+{
+	if(!frameBuffer) LUNA_RETURN_ERR("Attempt to release invalid framebuffer");
+
+	auto& frameBuffers = freeFrameBuffers[MakeKey(frameBuffer->GetViewportWidth(), frameBuffer->GetViewportHeight(),
+		frameBuffer->GetColorType())];
+
+	if(std::find(frameBuffers.begin(), frameBuffers.end(), frameBuffer) != frameBuffers.end())
+	{
+		LUNA_RETURN_ERR("Attempt to release framebuffer twice");
+	}
+
+	frameBuffers.push_back(frameBuffer);
+}
+
+// Delete all released framebuffers
+void LUNAFrameBufferPool::Clear()
+{
+	freeFrameBuffers.clear();
+}
+
+// Get count of framebuffers created by pool and still alive
+int LUNAFrameBufferPool::GetCount()
+{
+	int count = 0;
+	for(const auto& frameBuffer : createdFrameBuffers)
+	{
+		if(!frameBuffer.expired()) count++;
+	}
+
+	return count;
+}
+
+// Get video memory used by textures of all alive framebuffers created by pool (in bytes)
+size_t LUNAFrameBufferPool::GetMemoryUsage()
+{
+	size_t memory = 0;
+	for(const auto& frameBuffer : createdFrameBuffers)
+	{
+		auto sharedFrameBuffer = frameBuffer.lock();
+		if(sharedFrameBuffer) memory += sharedFrameBuffer->GetMemorySize();
+	}
+
+	return memory;
+}
+
+// Get video memory used by textures of released framebuffers (in bytes)
+size_t LUNAFrameBufferPool::GetFreeMemory()
+{
+	size_t memory = 0;
+	for(const auto& entry : freeFrameBuffers)
+	{
+		for(const auto& frameBuffer : entry.second) memory += frameBuffer->GetMemorySize();
+	}
+
+	return memory;
+}
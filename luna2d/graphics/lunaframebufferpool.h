@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunaframebuffer.h"
+
+namespace luna2d{
+
+//-------------------------------------------------------------
+// Pool of framebuffers for transient render targets.
+// Released framebuffers are reused by next requests with same
+// size and color type instead of creating new GL objects
+//-------------------------------------------------------------
+class LUNAFrameBufferPool
+{
+public:
+	~LUNAFrameBufferPool();
+
+private:
+	// Released framebuffers by key made from size and color type
+	std::unordered_map<uint64_t, std::vector<std::shared_ptr<LUNAFrameBuffer>>> freeFrameBuffers;
+
+	// All framebuffers created by pool, including acquired ones
+	std::vector<std::weak_ptr<LUNAFrameBuffer>> createdFrameBuffers;
+
+private:
+	static uint64_t MakeKey(int width, int height, LUNAColorType colorType);
+
+public:
+	// Get framebuffer with given size and color type. Content of framebuffer is undefined
+	// Returns nullptr if color type cannot be used for framebuffer
+	std::shared_ptr<LUNAFrameBuffer> Acquire(int width, int height, LUNAColorType colorType);
+
+	// Return framebuffer to pool for reusing
+	void Release(const std::shared_ptr<LUNAFrameBuffer>& frameBuffer);
+
+	// Delete all released framebuffers
+	void Clear();
+
+	// Get count of framebuffers created by pool and still alive
+	int GetCount();
+
+	// Get video memory used by textures of all alive framebuffers created by pool (in bytes)
+	size_t GetMemoryUsage();
+
+	// Get video memory used by textures of released framebuffers (in bytes)
+	size_t GetFreeMemory();
+};
+
+}
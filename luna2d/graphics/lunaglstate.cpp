@@ -0,0 +1,309 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaglstate.h"
+#include "lunalog.h"
+#include "lunamacro.h"
+#include <array>
+#include <algorithm>
+
+using namespace luna2d;
+
+const GLint UNKNOWN = -1;
+
+namespace{
+
+struct GlState
+{
+	GLint program;
+	GLint activeUnit;
+	std::array<GLint, glstate::MAX_TEXTURE_UNITS> textures;
+	GLint arrayBuffer;
+	GLint elementBuffer;
+	GLint framebuffer;
+
+	unsigned int knownAttribs; // Bit mask of attributes with known state
+	unsigned int enabledAttribs; // Bit mask of enabled attributes
+
+	GLint blending;
+	GLint blendSrc, blendDst;
+
+	GLint scissor;
+	std::array<GLint, 4> scissorBox;
+	std::array<GLint, 4> viewport;
+
+	GlState()
+	{
+		Reset();
+	}
+
+	void Reset()
+	{
+		program = UNKNOWN;
+		activeUnit = UNKNOWN;
+		textures.fill(UNKNOWN);
+		arrayBuffer = UNKNOWN;
+		elementBuffer = UNKNOWN;
+		framebuffer = UNKNOWN;
+		knownAttribs = 0;
+		enabledAttribs = 0;
+		blending = UNKNOWN;
+		blendSrc = UNKNOWN;
+		blendDst = UNKNOWN;
+		scissor = UNKNOWN;
+		scissorBox.fill(UNKNOWN);
+		viewport.fill(UNKNOWN);
+	}
+};
+
+GlState state;
+int issuedCalls = 0;
+int skippedCalls = 0;
+
+// Count state call. Returns "true" if call is redundant and should be skipped
+bool IsRedundant(bool redundant)
+{
+	if(redundant) skippedCalls++;
+	else issuedCalls++;
+
+	return redundant;
+}
+
+bool IsRedundant(std::array<GLint, 4>& cached, GLint x, GLint y, GLint width, GLint height)
+{
+	std::array<GLint, 4> value = {{ x, y, width, height }};
+	if(IsRedundant(cached == value)) return true;
+
+	cached = value;
+	return false;
+}
+
+}
+
+// Forget all cached state. Should be called when GL context was lost
+// or state could be changed bypassing this module
+void glstate::Reset()
+{
+	state.Reset();
+}
+
+// Counters of state calls passed to GL and skipped as redundant
+int glstate::GetIssuedCalls()
+{
+	return issuedCalls;
+}
+
+int glstate::GetSkippedCalls()
+{
+	return skippedCalls;
+}
+
+void glstate::ResetCounters()
+{
+	issuedCalls = 0;
+	skippedCalls = 0;
+}
+
+void glstate::UseProgram(GLuint program)
+{
+	if(IsRedundant(state.program == (GLint)program)) return;
+
+	glUseProgram(program);
+	state.program = program;
+}
+
+// Get count of texture units available in fragment shader, limited by "MAX_TEXTURE_UNITS"
+int glstate::GetMaxTextureUnits()
+{
+	static int maxUnits = 0;
+
+	if(maxUnits == 0)
+	{
+		GLint units = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &units);
+		maxUnits = std::max(1, std::min<int>(units, MAX_TEXTURE_UNITS));
+	}
+
+	return maxUnits;
+}
+
+void glstate::BindTexture(GLuint texture, int unit)
+{
+	if(unit < 0 || unit >= MAX_TEXTURE_UNITS) LUNA_RETURN_ERR("Invalid texture unit %d", unit);
+
+	if(!IsRedundant(state.activeUnit == unit))
+	{
+		glActiveTexture(GL_TEXTURE0 + unit);
+		state.activeUnit = unit;
+	}
+
+	if(IsRedundant(state.textures[unit] == (GLint)texture)) return;
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	state.textures[unit] = texture;
+}
+
+void glstate::BindBuffer(GLenum target, GLuint buffer)
+{
+	GLint& cached = target == GL_ARRAY_BUFFER ? state.arrayBuffer : state.elementBuffer;
+	if(IsRedundant(cached == (GLint)buffer)) return;
+
+	glBindBuffer(target, buffer);
+	cached = buffer;
+}
+
+void glstate::BindFramebuffer(GLuint framebuffer)
+{
+	if(IsRedundant(state.framebuffer == (GLint)framebuffer)) return;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	state.framebuffer = framebuffer;
+}
+
+// Get currently bound framebuffer
+GLuint glstate::GetFramebuffer()
+{
+	// Default framebuffer isn't always 0 (e.g. on iOS), so query it when unknown
+	if(state.framebuffer == UNKNOWN) glGetIntegerv(GL_FRAMEBUFFER_BINDING, &state.framebuffer);
+	return state.framebuffer;
+}
+
+// Attributes with index out of cache range are passed to GL without caching
+void glstate::EnableVertexAttrib(GLuint index)
+{
+	if(index >= static_cast<GLuint>(MAX_VERTEX_ATTRIBS))
+	{
+		IsRedundant(false);
+		glEnableVertexAttribArray(index);
+		return;
+	}
+
+	unsigned int bit = 1u << index;
+	if(IsRedundant((state.knownAttribs & bit) && (state.enabledAttribs & bit))) return;
+
+	glEnableVertexAttribArray(index);
+	state.knownAttribs |= bit;
+	state.enabledAttribs |= bit;
+}
+
+// Attributes with index out of cache range are passed to GL without caching
+void glstate::DisableVertexAttrib(GLuint index)
+{
+	if(index >= static_cast<GLuint>(MAX_VERTEX_ATTRIBS))
+	{
+		IsRedundant(false);
+		glDisableVertexAttribArray(index);
+		return;
+	}
+
+	unsigned int bit = 1u << index;
+	if(IsRedundant((state.knownAttribs & bit) && !(state.enabledAttribs & bit))) return;
+
+	glDisableVertexAttribArray(index);
+	state.knownAttribs |= bit;
+	state.enabledAttribs &= ~bit;
+}
+
+void glstate::EnableBlending(bool enable)
+{
+	if(IsRedundant(state.blending == (GLint)enable)) return;
+
+	if(enable) glEnable(GL_BLEND);
+	else glDisable(GL_BLEND);
+	state.blending = enable;
+}
+
+void glstate::BlendFunc(GLenum srcFactor, GLenum dstFactor)
+{
+	if(IsRedundant(state.blendSrc == (GLint)srcFactor && state.blendDst == (GLint)dstFactor)) return;
+
+	glBlendFunc(srcFactor, dstFactor);
+	state.blendSrc = srcFactor;
+	state.blendDst = dstFactor;
+}
+
+void glstate::EnableScissor(bool enable)
+{
+	if(IsRedundant(state.scissor == (GLint)enable)) return;
+
+	if(enable) glEnable(GL_SCISSOR_TEST);
+	else glDisable(GL_SCISSOR_TEST);
+	state.scissor = enable;
+}
+
+void glstate::Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	if(IsRedundant(state.scissorBox, x, y, width, height)) return;
+
+	glScissor(x, y, width, height);
+}
+
+void glstate::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	if(IsRedundant(state.viewport, x, y, width, height)) return;
+
+	glViewport(x, y, width, height);
+}
+
+// Delete GL objects and remove them from cache
+// GL can reuse ids of deleted objects, so cached bindings must be cleared
+void glstate::DeleteProgram(GLuint program)
+{
+	if(state.program == (GLint)program) state.program = UNKNOWN;
+
+	glDeleteProgram(program);
+}
+
+void glstate::DeleteTextures(GLsizei count, const GLuint* textures)
+{
+	for(int i = 0; i < count; i++)
+	{
+		for(GLint& cached : state.textures)
+		{
+			if(cached == (GLint)textures[i]) cached = UNKNOWN;
+		}
+	}
+
+	glDeleteTextures(count, textures);
+}
+
+void glstate::DeleteBuffers(GLsizei count, const GLuint* buffers)
+{
+	for(int i = 0; i < count; i++)
+	{
+		if(state.arrayBuffer == (GLint)buffers[i]) state.arrayBuffer = UNKNOWN;
+		if(state.elementBuffer == (GLint)buffers[i]) state.elementBuffer = UNKNOWN;
+	}
+
+	glDeleteBuffers(count, buffers);
+}
+
+void glstate::DeleteFramebuffers(GLsizei count, const GLuint* framebuffers)
+{
+	for(int i = 0; i < count; i++)
+	{
+		if(state.framebuffer == (GLint)framebuffers[i]) state.framebuffer = UNKNOWN;
+	}
+
+	glDeleteFramebuffers(count, framebuffers);
+}
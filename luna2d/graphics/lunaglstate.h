@@ -0,0 +1,76 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunagl.h"
+
+namespace luna2d{ namespace glstate{
+
+//-------------------------------------------------------------------
+// Cache of GL state. Calls which don't change cached state are
+// skipped. All state changes in engine should be made through this
+// module, otherwise cache should be invalidated by "glstate::Reset"
+//-------------------------------------------------------------------
+
+const int MAX_TEXTURE_UNITS = 16;
+const int MAX_VERTEX_ATTRIBS = 16;
+
+// Forget all cached state. Should be called when GL context was lost
+// or state could be changed bypassing this module
+void Reset();
+
+// Counters of state calls passed to GL and skipped as redundant
+int GetIssuedCalls();
+int GetSkippedCalls();
+void ResetCounters();
+
+// Get count of texture units available in fragment shader, limited by "MAX_TEXTURE_UNITS"
+int GetMaxTextureUnits();
+
+void UseProgram(GLuint program);
+void BindTexture(GLuint texture, int unit = 0);
+void BindBuffer(GLenum target, GLuint buffer); // "GL_ARRAY_BUFFER" or "GL_ELEMENT_ARRAY_BUFFER"
+void BindFramebuffer(GLuint framebuffer);
+GLuint GetFramebuffer(); // Get currently bound framebuffer
+
+// Attributes with index out of cache range are passed to GL without caching
+void EnableVertexAttrib(GLuint index);
+void DisableVertexAttrib(GLuint index);
+
+void EnableBlending(bool enable);
+void BlendFunc(GLenum srcFactor, GLenum dstFactor);
+
+void EnableScissor(bool enable);
+void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+// Delete GL objects and remove them from cache
+// GL can reuse ids of deleted objects, so cached bindings must be cleared
+void DeleteProgram(GLuint program);
+void DeleteTextures(GLsizei count, const GLuint* textures);
+void DeleteBuffers(GLsizei count, const GLuint* buffers);
+void DeleteFramebuffers(GLsizei count, const GLuint* framebuffers);
+
+}}
@@ -28,10 +28,13 @@
 #include "lunarenderer.h"
 #include "lunaanimation.h"
 #include "lunamesh.h"
+#include "lunanineslice.h"
+#include "lunaspritebatch.h"
 #include "lunatext.h"
 #include "lunaparticlesystem.h"
 #include "lunacurverenderer.h"
 #include "lunaframebuffer.h"
+#include "lunapostprocess.h"
 #include "lunapngformat.h"
 #include "lunajpegformat.h"
 
@@ -58,14 +61,34 @@ LUNAGraphics::LUNAGraphics() :
 	tblGraphics.SetField("getDeltaTime", LuaFunction(lua, this, &LUNAGraphics::GetDeltaTime));
 	tblGraphics.SetField("getRenderCalls", LuaFunction(lua, this, &LUNAGraphics::GetRenderCalls));
 	tblGraphics.SetField("getRenderedVertexes", LuaFunction(lua, this, &LUNAGraphics::GetRenderedVertexes));
+	tblGraphics.SetField("getUploadedBytes", LuaFunction(lua, this, &LUNAGraphics::GetUploadedBytes));
+	tblGraphics.SetField("getMergedDraws", LuaFunction(lua, this, &LUNAGraphics::GetMergedDraws));
+	tblGraphics.SetField("getCulledObjects", LuaFunction(lua, this, &LUNAGraphics::GetCulledObjects));
+	tblGraphics.SetField("getIssuedStateCalls", LuaFunction(lua, this, &LUNAGraphics::GetIssuedStateCalls));
+	tblGraphics.SetField("getSkippedStateCalls", LuaFunction(lua, this, &LUNAGraphics::GetSkippedStateCalls));
+	tblGraphics.SetField("getFrameBufferPoolMemory", LuaFunction(lua, this, &LUNAGraphics::GetFrameBufferPoolMemory));
+	tblGraphics.SetField("getFrameBufferPoolFreeMemory", LuaFunction(lua, this, &LUNAGraphics::GetFrameBufferPoolFreeMemory));
+	tblGraphics.SetField("acquireFrameBuffer", LuaFunction(lua, &frameBufferPool, &LUNAFrameBufferPool::Acquire));
+	tblGraphics.SetField("releaseFrameBuffer", LuaFunction(lua, &frameBufferPool, &LUNAFrameBufferPool::Release));
+	tblGraphics.SetField("clearFrameBufferPool", LuaFunction(lua, &frameBufferPool, &LUNAFrameBufferPool::Clear));
 	tblGraphics.SetField("getCamera", LuaFunction(lua, this, &LUNAGraphics::GetCamera));
 	tblGraphics.SetField("setBackgroundColor", LuaFunction(lua, this, &LUNAGraphics::SetBackgroundColor));
 	tblGraphics.SetField("getDefaultShader", LuaFunction(lua, &renderer, &LUNARenderer::GetDefaultShader));
+	tblGraphics.SetField("pushClipRect", LuaFunction(lua, &renderer, &LUNARenderer::PushClipRect));
+	tblGraphics.SetField("popClipRect", LuaFunction(lua, &renderer, &LUNARenderer::PopClipRect));
 	tblGraphics.SetField("enableScissor", LuaFunction(lua, &renderer, &LUNARenderer::EnableScissor));
 	tblGraphics.SetField("disableScissor", LuaFunction(lua, &renderer, &LUNARenderer::DisableScissor));
 	tblGraphics.SetField("setFrameBuffer", LuaFunction(lua, &renderer, &LUNARenderer::SetFrameBuffer));
 	tblGraphics.SetField("enableDebugRender", LuaFunction(lua, &renderer, &LUNARenderer::EnableDebugRender));
+	tblGraphics.SetField("enableVertexBuffers", LuaFunction(lua, &renderer, &LUNARenderer::EnableVertexBuffers));
+	tblGraphics.SetField("enableDeferredRender", LuaFunction(lua, &renderer, &LUNARenderer::EnableDeferredRender));
+	tblGraphics.SetField("enableCulling", LuaFunction(lua, &renderer, &LUNARenderer::EnableCulling));
+	tblGraphics.SetField("getLayer", LuaFunction(lua, &renderer, &LUNARenderer::GetLayer));
+	tblGraphics.SetField("setLayer", LuaFunction(lua, &renderer, &LUNARenderer::SetLayer));
 	tblGraphics.SetField("renderLine", LuaFunction(lua, &renderer, &LUNARenderer::RenderLine));
+	tblGraphics.SetField("renderPolyline", LuaFunction(lua, &renderer, &LUNARenderer::RenderPolyline));
+	tblGraphics.SetField("renderRectangle", LuaFunction(lua, &renderer, &LUNARenderer::RenderRectangle));
+	tblGraphics.SetField("renderCircle", LuaFunction(lua, &renderer, &LUNARenderer::RenderCircle));
 
 	// Bind camera
 	LuaClass<LUNACamera> clsCamera(lua);
@@ -114,6 +137,8 @@ LUNAGraphics::LUNAGraphics() :
 	clsSprite.SetMethod("getColor", &LUNASprite::GetColor);
 	clsSprite.SetMethod("setAlpha", &LUNASprite::SetAlpha);
 	clsSprite.SetMethod("getAlpha", &LUNASprite::GetAlpha);
+	clsSprite.SetMethod("getLayer", &LUNASprite::GetLayer);
+	clsSprite.SetMethod("setLayer", &LUNASprite::SetLayer);
 	clsSprite.SetMethod("render", &LUNASprite::Render);
 	tblGraphics.SetField("Sprite", clsSprite);
 
@@ -142,9 +167,52 @@ LUNAGraphics::LUNAGraphics() :
 	clsMesh.SetMethod("clear", &LUNAMesh::Clear);
 	clsMesh.SetMethod("setTexture", &LUNAMesh::SetTexture);
 	clsMesh.SetMethod("addVertex", &LUNAMesh::AddVertex);
+	clsMesh.SetMethod("getLayer", &LUNAMesh::GetLayer);
+	clsMesh.SetMethod("setLayer", &LUNAMesh::SetLayer);
 	clsMesh.SetMethod("render", &LUNAMesh::Render);
 	tblGraphics.SetField("Mesh", clsMesh);
 
+	// Bind nine-slice
+	LuaClass<LUNANineSlice> clsNineSlice(lua);
+	clsNineSlice.SetConstructor<const std::weak_ptr<LUNATextureRegion>&, float, float, float, float>();
+	clsNineSlice.SetMethod("setTextureRegion", &LUNANineSlice::SetTextureRegion);
+	clsNineSlice.SetMethod("setShader", &LUNANineSlice::SetShader);
+	clsNineSlice.SetMethod("getBlendingMode", &LUNANineSlice::GetBlendingMode);
+	clsNineSlice.SetMethod("setBlendingMode", &LUNANineSlice::SetBlendingMode);
+	clsNineSlice.SetMethod("setInsets", &LUNANineSlice::SetInsets);
+	clsNineSlice.SetMethod("getX", &LUNANineSlice::GetX);
+	clsNineSlice.SetMethod("getY", &LUNANineSlice::GetY);
+	clsNineSlice.SetMethod("setX", &LUNANineSlice::SetX);
+	clsNineSlice.SetMethod("setY", &LUNANineSlice::SetY);
+	clsNineSlice.SetMethod("getPos", &LUNANineSlice::GetPos);
+	clsNineSlice.SetMethod("setPos", &LUNANineSlice::SetPos);
+	clsNineSlice.SetMethod("getWidth", &LUNANineSlice::GetWidth);
+	clsNineSlice.SetMethod("getHeight", &LUNANineSlice::GetHeight);
+	clsNineSlice.SetMethod("setWidth", &LUNANineSlice::SetWidth);
+	clsNineSlice.SetMethod("setHeight", &LUNANineSlice::SetHeight);
+	clsNineSlice.SetMethod("setSize", &LUNANineSlice::SetSize);
+	clsNineSlice.SetMethod("setColor", &LUNANineSlice::SetColor);
+	clsNineSlice.SetMethod("getColor", &LUNANineSlice::GetColor);
+	clsNineSlice.SetMethod("setAlpha", &LUNANineSlice::SetAlpha);
+	clsNineSlice.SetMethod("getAlpha", &LUNANineSlice::GetAlpha);
+	clsNineSlice.SetMethod("getLayer", &LUNANineSlice::GetLayer);
+	clsNineSlice.SetMethod("setLayer", &LUNANineSlice::SetLayer);
+	clsNineSlice.SetMethod("render", &LUNANineSlice::Render);
+	tblGraphics.SetField("NineSlice", clsNineSlice);
+
+	// Bind sprite batch
+	LuaClass<LUNASpriteBatch> clsSpriteBatch(lua);
+	clsSpriteBatch.SetConstructor<const std::weak_ptr<LUNATexture>&>();
+	clsSpriteBatch.SetMethod("getCount", &LUNASpriteBatch::GetCount);
+	clsSpriteBatch.SetMethod("clear", &LUNASpriteBatch::Clear);
+	clsSpriteBatch.SetMethod("getBlendingMode", &LUNASpriteBatch::GetBlendingMode);
+	clsSpriteBatch.SetMethod("setBlendingMode", &LUNASpriteBatch::SetBlendingMode);
+	clsSpriteBatch.SetMethod("add", &LUNASpriteBatch::Add);
+	clsSpriteBatch.SetMethod("set", &LUNASpriteBatch::Set);
+	clsSpriteBatch.SetMethod("remove", &LUNASpriteBatch::Remove);
+	clsSpriteBatch.SetMethod("render", &LUNASpriteBatch::Render);
+	tblGraphics.SetField("SpriteBatch", clsSpriteBatch);
+
 	// Bind text
 	LuaClass<LUNAText> clsText(lua);
 	clsText.SetConstructor<const std::weak_ptr<LUNAFont>&>();
@@ -167,6 +235,10 @@ LUNAGraphics::LUNAGraphics() :
 	clsText.SetMethod("getAlpha", &LUNAText::GetAlpha);
 	clsText.SetMethod("getText", &LUNAText::GetText);
 	clsText.SetMethod("setText", &LUNAText::SetText);
+	clsText.SetMethod("setNumber", &LUNAText::SetNumber);
+	clsText.SetMethod("setFormatted", &LUNAText::SetFormatted);
+	clsText.SetMethod("getLayer", &LUNAText::GetLayer);
+	clsText.SetMethod("setLayer", &LUNAText::SetLayer);
 	clsText.SetMethod("render", &LUNAText::Render);
 	tblGraphics.SetField("Text", clsText);
 
@@ -185,6 +257,8 @@ LUNAGraphics::LUNAGraphics() :
 	clsParticleSystem.SetMethod("start", &LUNAParticleSystem::Start);
 	clsParticleSystem.SetMethod("pause", &LUNAParticleSystem::Pause);
 	clsParticleSystem.SetMethod("stop", &LUNAParticleSystem::Stop);
+	clsParticleSystem.SetMethod("getLayer", &LUNAParticleSystem::GetLayer);
+	clsParticleSystem.SetMethod("setLayer", &LUNAParticleSystem::SetLayer);
 	clsParticleSystem.SetMethod("update", &LUNAParticleSystem::Update);
 	clsParticleSystem.SetMethod("render", &LUNAParticleSystem::Render);
 	tblGraphics.SetField("ParticleSystem", clsParticleSystem);
@@ -211,6 +285,11 @@ LUNAGraphics::LUNAGraphics() :
 	clsTexture.SetMethod("getHeight", &LUNATexture::GetHeight);
 	clsTexture.SetMethod("getWidthPoints", &LUNATexture::GetWidthPoints);
 	clsTexture.SetMethod("getHeightPoints", &LUNATexture::GetHeightPoints);
+	clsTexture.SetMethod("getFilter", &LUNATexture::GetFilter);
+	clsTexture.SetMethod("setFilter", &LUNATexture::SetFilter);
+	clsTexture.SetMethod("getWrap", &LUNATexture::GetWrap);
+	clsTexture.SetMethod("setWrap", &LUNATexture::SetWrap);
+	clsTexture.SetMethod("generateMipmaps", &LUNATexture::GenerateMipmaps);
 
 	// Bind texture region
 	LuaClass<LUNATextureRegion> clsTextureRegion(lua);
@@ -229,9 +308,51 @@ LUNAGraphics::LUNAGraphics() :
 	// Bind shader
 	LuaClass<LUNAShader> clsShader(lua);
 
+	std::function<void(const std::shared_ptr<LUNAShader>&, const std::string&, float)> fnSetFloat =
+		[](const std::shared_ptr<LUNAShader>& shader, const std::string& name, float x)
+	{
+		shader->SetUniform(name, x);
+	};
+	clsShader.SetExtensionMethod("setFloat", fnSetFloat);
+
+	std::function<void(const std::shared_ptr<LUNAShader>&, const std::string&, float, float)> fnSetVec2 =
+		[](const std::shared_ptr<LUNAShader>& shader, const std::string& name, float x, float y)
+	{
+		shader->SetUniform(name, glm::vec2(x, y));
+	};
+	clsShader.SetExtensionMethod("setVec2", fnSetVec2);
+
+	std::function<void(const std::shared_ptr<LUNAShader>&, const std::string&, float, float, float)> fnSetVec3 =
+		[](const std::shared_ptr<LUNAShader>& shader, const std::string& name, float x, float y, float z)
+	{
+		shader->SetUniform(name, glm::vec3(x, y, z));
+	};
+	clsShader.SetExtensionMethod("setVec3", fnSetVec3);
+
+	std::function<void(const std::shared_ptr<LUNAShader>&, const std::string&, float, float, float, float)> fnSetVec4 =
+		[](const std::shared_ptr<LUNAShader>& shader, const std::string& name, float x, float y, float z, float w)
+	{
+		shader->SetUniform(name, glm::vec4(x, y, z, w));
+	};
+	clsShader.SetExtensionMethod("setVec4", fnSetVec4);
+
+	// Matrix is given as table of 16 numbers in column-major order
+	std::function<void(const std::shared_ptr<LUNAShader>&, const std::string&, const std::vector<float>&)> fnSetMatrix =
+		[](const std::shared_ptr<LUNAShader>& shader, const std::string& name, const std::vector<float>& values)
+	{
+		if(values.size() != 16) LUNA_RETURN_ERR("Matrix for uniform \"%s\" should have 16 values", name.c_str());
+		glm::mat4 matrix;
+		for(int i = 0; i < 16; i++) matrix[i / 4][i % 4] = values[i];
+		shader->SetUniform(name, matrix);
+	};
+	clsShader.SetExtensionMethod("setMatrix", fnSetMatrix);
+
+	clsShader.SetMethod("setTexture", &LUNAShader::SetSamplerUniform);
+
 	// Bind font
 	LuaClass<LUNAFont> clsFont(lua);
 	clsFont.SetMethod("getSize", &LUNAFont::GetSize);
+	clsFont.SetMethod("isSdf", &LUNAFont::IsSdf);
 	clsFont.SetMethod("getStringWidth", &LUNAFont::GetStringWidth);
 	clsFont.SetMethod("getStringHeight", &LUNAFont::GetStringHeight);
 
@@ -314,6 +435,20 @@ LUNAGraphics::LUNAGraphics() :
 	clsFrameBuffer.SetField("fullscreen", LuaFunction(lua, fnFrameBufferConstruct));
 	tblGraphics.SetField("FrameBuffer", clsFrameBuffer);
 
+	// Bind post-process
+	LuaClass<LUNAPostProcess> clsPostProcess(lua);
+	clsPostProcess.SetConstructor<>();
+	clsPostProcess.SetMethod("addPass", &LUNAPostProcess::AddPass);
+	clsPostProcess.SetMethod("getPassesCount", &LUNAPostProcess::GetPassesCount);
+	clsPostProcess.SetMethod("isPassEnabled", &LUNAPostProcess::IsPassEnabled);
+	clsPostProcess.SetMethod("setPassEnabled", &LUNAPostProcess::SetPassEnabled);
+	clsPostProcess.SetMethod("clear", &LUNAPostProcess::Clear);
+	clsPostProcess.SetMethod("getColorType", &LUNAPostProcess::GetColorType);
+	clsPostProcess.SetMethod("setColorType", &LUNAPostProcess::SetColorType);
+	clsPostProcess.SetMethod("begin", &LUNAPostProcess::Begin);
+	clsPostProcess.SetMethod("finish", &LUNAPostProcess::End);
+	tblGraphics.SetField("PostProcess", clsPostProcess);
+
 	tblGraphics.MakeReadOnly();
 	tblLuna.SetField("graphics", tblGraphics);
 }
@@ -330,6 +465,16 @@ LUNARenderer* LUNAGraphics::GetRenderer()
 	return &renderer;
 }
 
+LUNAFrameBufferPool* LUNAGraphics::GetFrameBufferPool()
+{
+	return &frameBufferPool;
+}
+
+LUNAScreenshots* LUNAGraphics::GetScreenshots()
+{
+	return &screenshots;
+}
+
 const std::shared_ptr<LUNACamera>& LUNAGraphics::GetCamera()
 {
 	return camera;
@@ -355,6 +500,43 @@ int LUNAGraphics::GetRenderedVertexes()
 	return renderer.GetRenderedVertexes();
 }
 
+int LUNAGraphics::GetUploadedBytes()
+{
+	return renderer.GetUploadedBytes();
+}
+
+int LUNAGraphics::GetMergedDraws()
+{
+	return renderer.GetMergedDraws();
+}
+
+int LUNAGraphics::GetCulledObjects()
+{
+	return renderer.GetCulledObjects();
+}
+
+// Video memory used by framebuffers from pool (in bytes)
+double LUNAGraphics::GetFrameBufferPoolMemory()
+{
+	return static_cast<double>(frameBufferPool.GetMemoryUsage());
+}
+
+// Video memory used by released framebuffers in pool (in bytes)
+double LUNAGraphics::GetFrameBufferPoolFreeMemory()
+{
+	return static_cast<double>(frameBufferPool.GetFreeMemory());
+}
+
+int LUNAGraphics::GetIssuedStateCalls()
+{
+	return renderer.GetIssuedStateCalls();
+}
+
+int LUNAGraphics::GetSkippedStateCalls()
+{
+	return renderer.GetSkippedStateCalls();
+}
+
 void LUNAGraphics::ResetLastTime()
 {
 	lastTime = LUNAEngine::SharedPlatformUtils()->GetSystemTime();
@@ -393,6 +575,8 @@ void LUNAGraphics::OnUpdate()
 {
 	if(paused) return;
 
+	screenshots.ProcessCompleted();
+
 	// Calculate delta time
 	double curTime = LUNAEngine::SharedPlatformUtils()->GetSystemTime();
 	deltaTime = curTime - lastTime;
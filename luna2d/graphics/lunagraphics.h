@@ -24,6 +24,8 @@
 #pragma once
 
 #include "lunarenderer.h"
+#include "lunaframebufferpool.h"
+#include "lunascreenshots.h"
 
 namespace luna2d{
 
@@ -38,6 +40,7 @@ public:
 
 private:
 	LUNARenderer renderer;
+	LUNAFrameBufferPool frameBufferPool;
 	std::shared_ptr<LUNACamera> camera;
 
 	// For calculating delta time and FPS
@@ -48,16 +51,28 @@ private:
 
 	std::vector<std::function<void()>> afterRenderActions; // Actions running after render current frame
 
+	// Declared last to finish screenshots encoding before destroying other members
+	LUNAScreenshots screenshots;
+
 private:
 	double SmoothDeltaTime(double deltaTime);
 
 public:
 	LUNARenderer* GetRenderer();
+	LUNAFrameBufferPool* GetFrameBufferPool();
+	LUNAScreenshots* GetScreenshots();
 	const std::shared_ptr<LUNACamera>& GetCamera();
 	int GetFps();
 	float GetDeltaTime();
 	int GetRenderCalls();
 	int GetRenderedVertexes();
+	int GetUploadedBytes();
+	int GetMergedDraws();
+	int GetCulledObjects();
+	int GetIssuedStateCalls();
+	int GetSkippedStateCalls();
+	double GetFrameBufferPoolMemory(); // Video memory used by framebuffers from pool (in bytes)
+	double GetFrameBufferPoolFreeMemory(); // Video memory used by released framebuffers in pool (in bytes)
 	void ResetLastTime();
 	void SetBackgroundColor(float r, float g, float b);
 	void RunAfterRender(const std::function<void()>& action); // Run given action after render current frame
@@ -406,6 +406,42 @@ void LUNAImage::DrawRawBuffer(int x, int y,
 	}
 }
 
+// Make image downscaled by half with box filter. Used as next mipmap level
+LUNAImage LUNAImage::MakeMipmap() const
+{
+	int mipWidth = std::max(1, width / 2);
+	int mipHeight = std::max(1, height / 2);
+	int pixelLen = GetBytesPerPixel(colorType);
+	std::vector<unsigned char> mipData(mipWidth * mipHeight * pixelLen);
+
+	for(int y = 0; y < mipHeight; y++)
+	{
+		// Odd sizes are handled by repeating last row/column
+		int y1 = std::min(y * 2, height - 1);
+		int y2 = std::min(y * 2 + 1, height - 1);
+
+		for(int x = 0; x < mipWidth; x++)
+		{
+			int x1 = std::min(x * 2, width - 1);
+			int x2 = std::min(x * 2 + 1, width - 1);
+
+			size_t pos11 = CoordsToPos(x1, y1);
+			size_t pos21 = CoordsToPos(x2, y1);
+			size_t pos12 = CoordsToPos(x1, y2);
+			size_t pos22 = CoordsToPos(x2, y2);
+			size_t mipPos = (y * mipWidth + x) * pixelLen;
+
+			for(int i = 0; i < pixelLen; i++)
+			{
+				int sum = data[pos11 + i] + data[pos21 + i] + data[pos12 + i] + data[pos22 + i];
+				mipData[mipPos + i] = (sum + 2) / 4;
+			}
+		}
+	}
+
+	return LUNAImage(mipWidth, mipHeight, colorType, std::move(mipData));
+}
+
 // Flip image vertically
 void LUNAImage::FlipVertically()
 {
@@ -89,6 +89,9 @@ public:
 	// Set pixmap size without stretching image
 	void SetSize(int width, int height);
 
+	// Make image downscaled by half with box filter. Used as next mipmap level
+	LUNAImage MakeMipmap() const;
+
 	void SetPixel(int x, int y, const LUNAColor& color);
 	LUNAColor GetPixel(int x, int y) const;
 
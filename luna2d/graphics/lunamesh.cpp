@@ -25,6 +25,7 @@
 #include "lunarenderer.h"
 #include "lunaassets.h"
 #include "lunagraphics.h"
+#include "lunalog.h"
 
 using namespace luna2d;
 
@@ -33,9 +34,35 @@ LUNAMesh::LUNAMesh(const std::weak_ptr<LUNATexture>& texture)
 	SetTexture(texture);
 }
 
+// Convert added vertexes to float texture coordinates format
+void LUNAMesh::ConvertToFloatTexCoords()
+{
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	const LUNAVertexFormat& format = renderer->GetVertexFormat();
+	const LUNAVertexFormat& floatFormat = renderer->GetFloatTexCoordsFormat();
+
+	std::vector<unsigned char> packedVertexes;
+	packedVertexes.swap(vertexes);
+
+	size_t count = format.GetVertexCount(packedVertexes);
+	vertexes.reserve(count * floatFormat.GetStride());
+	for(size_t i = 0; i < count; i++)
+	{
+		float x, y, u, v;
+		LUNAColor color;
+		format.ReadVertex(packedVertexes, i, x, y, color, u, v);
+		floatFormat.AppendVertex(vertexes, x, y, color, u, v);
+	}
+
+	floatTexCoords = true;
+}
+
 void LUNAMesh::Clear()
 {
 	vertexes.clear();
+	floatTexCoords = false;
+	minPos = glm::vec2();
+	maxPos = glm::vec2();
 }
 
 void LUNAMesh::SetTexture(const std::weak_ptr<LUNATexture>& texture)
@@ -51,19 +78,39 @@ void LUNAMesh::SetTexture(const std::weak_ptr<LUNATexture>& texture)
 
 void LUNAMesh::AddVertex(float x, float y, float r, float g, float b, float alpha, float u, float v)
 {
-	// Position
-	vertexes.push_back(x);
-	vertexes.push_back(y);
-
-	// Color
-	vertexes.push_back(r);
-	vertexes.push_back(g);
-	vertexes.push_back(b);
-	vertexes.push_back(alpha);
-
-	// Texture coordinates
-	vertexes.push_back(u);
-	vertexes.push_back(v);
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+
+	// Texture coordinates out of range supported by renderer vertex format
+	// are stored as floats instead of clamping them
+	if(!floatTexCoords && !renderer->GetVertexFormat().CanStoreTexCoords(u, v)) ConvertToFloatTexCoords();
+
+	const LUNAVertexFormat& format = floatTexCoords ? renderer->GetFloatTexCoordsFormat() : renderer->GetVertexFormat();
+	format.AppendVertex(vertexes, x, y, LUNAColor::RgbFloat(r, g, b, alpha), u, v);
+
+	if(format.GetVertexCount(vertexes) == 1)
+	{
+		minPos = glm::vec2(x, y);
+		maxPos = glm::vec2(x, y);
+	}
+	else
+	{
+		minPos = glm::min(minPos, glm::vec2(x, y));
+		maxPos = glm::max(maxPos, glm::vec2(x, y));
+	}
+}
+
+// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+// SEE: "LUNARenderer::SetLayer"
+int LUNAMesh::GetLayer()
+{
+	return layer;
+}
+
+void LUNAMesh::SetLayer(int layer)
+{
+	if(layer < RENDER_QUEUE_MIN_LAYER || layer > RENDER_QUEUE_MAX_LAYER) LUNA_RETURN_ERR("Invalid layer %d", layer);
+
+	this->layer = layer;
 }
 
 void LUNAMesh::Render()
@@ -78,5 +125,10 @@ void LUNAMesh::Render()
 	if(vertexes.size() == 0) return;
 
 	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
-	renderer->RenderVertexArray(vertexes, &material);
+	if(renderer->IsCulled(LUNARect(minPos.x, minPos.y, maxPos.x - minPos.x, maxPos.y - minPos.y))) return;
+
+	int baseLayer = renderer->GetLayer();
+	renderer->SetLayer(baseLayer + layer);
+	renderer->RenderVertexArray(vertexes, &material, floatTexCoords);
+	renderer->SetLayer(baseLayer);
 }
@@ -37,12 +37,23 @@ public:
 
 private:
 	LUNAMaterial material;
-	std::vector<float> vertexes;
+	std::vector<unsigned char> vertexes; // Vertexes data in renderer vertex format
+	bool floatTexCoords = false; // Vertexes are in float texture coordinates format. SEE: "LUNAMesh::AddVertex"
+	glm::vec2 minPos, maxPos; // Bounding box of vertexes for camera culling
+	int layer = 0;
+
+private:
+	// Convert added vertexes to float texture coordinates format
+	void ConvertToFloatTexCoords();
 
 public:
 	void Clear();
 	void SetTexture(const std::weak_ptr<LUNATexture>& texture);
 	void AddVertex(float x, float y, float r, float g, float b, float alpha, float u, float v);
+	// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+	// SEE: "LUNARenderer::SetLayer"
+	int GetLayer();
+	void SetLayer(int layer);
 	void Render();
 };
 
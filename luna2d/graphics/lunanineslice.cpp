@@ -0,0 +1,253 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunanineslice.h"
+#include "lunagraphics.h"
+#include "lunalog.h"
+
+using namespace luna2d;
+
+// Insets are sizes of border cells in game points
+LUNANineSlice::LUNANineSlice(const std::weak_ptr<LUNATextureRegion>& region, float left, float right, float top, float bottom)
+{
+	SetTextureRegion(region);
+	SetInsets(left, right, top, bottom);
+
+	width = regionWidth;
+	height = regionHeight;
+}
+
+// Build quads of all cells with non-zero size
+void LUNANineSlice::BuildVertexes()
+{
+	vertexes.clear();
+	dirty = false;
+
+	if(regionWidth <= 0 || regionHeight <= 0) return;
+
+	// Shrink border cells proportionally when they don't fit in nine-slice
+	float scaleX = left + right > width ? width / (left + right) : 1.0f;
+	float scaleY = top + bottom > height ? height / (top + bottom) : 1.0f;
+
+	// Edges of cells in world coordinates and texture coordinates. Rows are ordered from bottom to top
+	float xs[4] = { x, x + left * scaleX, x + width - right * scaleX, x + width };
+	float ys[4] = { y, y + bottom * scaleY, y + height - top * scaleY, y + height };
+	float us[4] = { u1, u1 + (u2 - u1) * left / regionWidth, u2 - (u2 - u1) * right / regionWidth, u2 };
+	float vs[4] = { v2, v2 + (v1 - v2) * bottom / regionHeight, v1 - (v1 - v2) * top / regionHeight, v1 };
+
+	const LUNAVertexFormat& format = LUNAEngine::SharedGraphics()->GetRenderer()->GetVertexFormat();
+	size_t stride = format.GetStride();
+
+	for(int row = 0; row < 3; row++)
+	{
+		if(ys[row + 1] <= ys[row]) continue;
+
+		for(int col = 0; col < 3; col++)
+		{
+			if(xs[col + 1] <= xs[col]) continue;
+
+			// Quad vertexes order is same as in "LUNARenderer::RenderQuad"
+			size_t offset = vertexes.size();
+			vertexes.resize(offset + stride * 4);
+
+			unsigned char* dest = &vertexes[offset];
+			format.WriteVertex(dest, xs[col], ys[row], color, us[col], vs[row]);
+			format.WriteVertex(dest + stride, xs[col], ys[row + 1], color, us[col], vs[row + 1]);
+			format.WriteVertex(dest + stride * 2, xs[col + 1], ys[row + 1], color, us[col + 1], vs[row + 1]);
+			format.WriteVertex(dest + stride * 3, xs[col + 1], ys[row], color, us[col + 1], vs[row]);
+		}
+	}
+}
+
+void LUNANineSlice::SetTextureRegion(const std::weak_ptr<LUNATextureRegion>& region)
+{
+	if(region.expired() || region.lock()->GetTexture().expired())
+	{
+		LUNA_RETURN_ERR("Attempt to set invalid texture region to nine-slice");
+	}
+
+	auto sharedRegion = region.lock();
+	material.texture = sharedRegion->GetTexture();
+
+	u1 = sharedRegion->GetU1();
+	v1 = sharedRegion->GetV1();
+	u2 = sharedRegion->GetU2();
+	v2 = sharedRegion->GetV2();
+
+	// Convert sizes to virtual resolution
+	regionWidth = sharedRegion->GetWidthPoints();
+	regionHeight = sharedRegion->GetHeightPoints();
+
+	dirty = true;
+}
+
+void LUNANineSlice::SetShader(const std::weak_ptr<LUNAShader>& shader)
+{
+	if(shader.expired()) LUNA_RETURN_ERR("Attempt set invalid shader to nine-slice");
+
+	material.shader = shader;
+}
+
+LUNABlendingMode LUNANineSlice::GetBlendingMode()
+{
+	return material.blending;
+}
+
+void LUNANineSlice::SetBlendingMode(LUNABlendingMode blendingMode)
+{
+	material.blending = blendingMode;
+}
+
+// Set sizes of border cells in game points
+// If nine-slice is smaller than sum of insets, border cells are shrinked proportionally
+void LUNANineSlice::SetInsets(float left, float right, float top, float bottom)
+{
+	// Insets cannot exceed sizes of texture region
+	this->left = std::max(0.0f, std::min(left, regionWidth));
+	this->right = std::max(0.0f, std::min(right, regionWidth - this->left));
+	this->top = std::max(0.0f, std::min(top, regionHeight));
+	this->bottom = std::max(0.0f, std::min(bottom, regionHeight - this->top));
+
+	dirty = true;
+}
+
+float LUNANineSlice::GetX()
+{
+	return x;
+}
+
+float LUNANineSlice::GetY()
+{
+	return y;
+}
+
+void LUNANineSlice::SetX(float x)
+{
+	this->x = x;
+	dirty = true;
+}
+
+void LUNANineSlice::SetY(float y)
+{
+	this->y = y;
+	dirty = true;
+}
+
+glm::vec2 LUNANineSlice::GetPos()
+{
+	return glm::vec2(x, y);
+}
+
+void LUNANineSlice::SetPos(float x, float y)
+{
+	this->x = x;
+	this->y = y;
+	dirty = true;
+}
+
+float LUNANineSlice::GetWidth()
+{
+	return width;
+}
+
+float LUNANineSlice::GetHeight()
+{
+	return height;
+}
+
+void LUNANineSlice::SetWidth(float width)
+{
+	this->width = std::max(0.0f, width);
+	dirty = true;
+}
+
+void LUNANineSlice::SetHeight(float height)
+{
+	this->height = std::max(0.0f, height);
+	dirty = true;
+}
+
+void LUNANineSlice::SetSize(float width, float height)
+{
+	SetWidth(width);
+	SetHeight(height);
+}
+
+void LUNANineSlice::SetColor(float r, float g, float b)
+{
+	color.r = r / 255.0f;
+	color.g = g / 255.0f;
+	color.b = b / 255.0f;
+	dirty = true;
+}
+
+LUNAColor LUNANineSlice::GetColor()
+{
+	return color;
+}
+
+void LUNANineSlice::SetAlpha(float alpha)
+{
+	color.a = alpha;
+	dirty = true;
+}
+
+float LUNANineSlice::GetAlpha()
+{
+	return color.a;
+}
+
+// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+// SEE: "LUNARenderer::SetLayer"
+int LUNANineSlice::GetLayer()
+{
+	return layer;
+}
+
+void LUNANineSlice::SetLayer(int layer)
+{
+	if(layer < RENDER_QUEUE_MIN_LAYER || layer > RENDER_QUEUE_MAX_LAYER) LUNA_RETURN_ERR("Invalid layer %d", layer);
+
+	this->layer = layer;
+}
+
+void LUNANineSlice::Render()
+{
+	if(material.texture.expired() || material.shader.expired())
+	{
+		LUNA_LOGE("Attempt to render invalid nine-slice");
+		return;
+	}
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+
+	LUNARect bounds(x, y, width, height);
+	if(renderer->IsCulled(bounds)) return;
+
+	if(dirty) BuildVertexes();
+
+	int baseLayer = renderer->GetLayer();
+	renderer->SetLayer(baseLayer + layer);
+	renderer->RenderQuads(vertexes, bounds, &material);
+	renderer->SetLayer(baseLayer);
+}
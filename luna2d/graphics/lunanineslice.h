@@ -0,0 +1,107 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunatextureregion.h"
+#include "lunamaterial.h"
+#include "lunacolor.h"
+#include "lunalua.h"
+#include "lunarect.h"
+
+namespace luna2d{
+
+//-----------------------------------------------------------------
+// Stretchable sprite made from texture region split to 3x3 cells.
+// Corner cells keep their sizes, edge and center cells are
+// stretched. All cells are rendered as one draw call entry.
+// Geometry is cached until position, size, region or color changes
+//-----------------------------------------------------------------
+class LUNANineSlice
+{
+	LUNA_USERDATA(LUNANineSlice)
+
+public:
+	// Insets are sizes of border cells in game points
+	LUNANineSlice(const std::weak_ptr<LUNATextureRegion>& region, float left, float right, float top, float bottom);
+
+private:
+	LUNAMaterial material;
+	float u1 = 0;
+	float v1 = 0;
+	float u2 = 0;
+	float v2 = 0;
+	float regionWidth = 0;
+	float regionHeight = 0;
+	float left = 0;
+	float right = 0;
+	float top = 0;
+	float bottom = 0;
+	float x = 0;
+	float y = 0;
+	float width = 0;
+	float height = 0;
+	LUNAColor color = LUNAColor::WHITE;
+	int layer = 0;
+	std::vector<unsigned char> vertexes; // Cached quads of cells in renderer vertex format
+	bool dirty = true;
+
+private:
+	// Build quads of all cells with non-zero size
+	void BuildVertexes();
+
+public:
+	void SetTextureRegion(const std::weak_ptr<LUNATextureRegion>& region);
+	void SetShader(const std::weak_ptr<LUNAShader>& shader);
+	LUNABlendingMode GetBlendingMode();
+	void SetBlendingMode(LUNABlendingMode blendingMode);
+
+	// Set sizes of border cells in game points
+	// If nine-slice is smaller than sum of insets, border cells are shrinked proportionally
+	void SetInsets(float left, float right, float top, float bottom);
+
+	float GetX();
+	float GetY();
+	void SetX(float x);
+	void SetY(float y);
+	glm::vec2 GetPos();
+	void SetPos(float x, float y);
+	float GetWidth();
+	float GetHeight();
+	void SetWidth(float width);
+	void SetHeight(float height);
+	void SetSize(float width, float height);
+	void SetColor(float r, float g, float b);
+	LUNAColor GetColor();
+	void SetAlpha(float alpha);
+	float GetAlpha();
+
+	// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+	// SEE: "LUNARenderer::SetLayer"
+	int GetLayer();
+	void SetLayer(int layer);
+
+	void Render();
+};
+
+}
@@ -0,0 +1,208 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunapostprocess.h"
+#include "lunagraphics.h"
+#include "lunasizes.h"
+
+using namespace luna2d;
+
+LUNAPostProcess::LUNAPostProcess()
+{
+}
+
+LUNAPostProcess::~LUNAPostProcess()
+{
+	// Graphics can be already deleted when post-process is collected by Lua at engine deinitializing
+	// In this case pooled targets are deleted with pool
+	LUNAGraphics* graphics = LUNAEngine::SharedGraphics();
+	if(sceneTarget && graphics) graphics->GetFrameBufferPool()->Release(sceneTarget);
+}
+
+bool LUNAPostProcess::CheckIndex(int index)
+{
+	if(index < 0 || index >= (int)passes.size())
+	{
+		LUNA_LOGE("Post-process pass index \"%d\" out of range", index);
+		return false;
+	}
+
+	return true;
+}
+
+bool LUNAPostProcess::HasEnabledPasses()
+{
+	for(const auto& pass : passes)
+	{
+		if(pass.enabled && !pass.shader.expired()) return true;
+	}
+
+	return false;
+}
+
+void LUNAPostProcess::RenderPass(Pass& pass, const std::shared_ptr<LUNAFrameBuffer>& source)
+{
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	const LUNARect& rect = LUNAEngine::SharedGraphics()->GetCamera()->GetVisibleRect();
+	auto region = source->GetTextureRegion();
+
+	float u1 = region->GetU1();
+	float v1 = region->GetV1();
+	float u2 = region->GetU2();
+	float v2 = region->GetV2();
+	float x1 = rect.x;
+	float y1 = rect.y;
+	float x2 = rect.x + rect.width;
+	float y2 = rect.y + rect.height;
+
+	// Material is stored in pass because immediate batch keeps pointer to it until flush
+	pass.material = LUNAMaterial(source->GetTexture(), pass.shader, LUNABlendingMode::NONE);
+	renderer->RenderQuad(x1, y1, u1, v2, x1, y2, u1, v1, x2, y2, u2, v1, x2, y1, u2, v2,
+		&pass.material, LUNAColor::WHITE);
+}
+
+// Add pass with given shader. Returns index of added pass
+int LUNAPostProcess::AddPass(const std::weak_ptr<LUNAShader>& shader, float scale)
+{
+	if(shader.expired())
+	{
+		LUNA_LOGE("Attempt to add post-process pass with invalid shader");
+		return -1;
+	}
+
+	Pass pass;
+	pass.shader = shader;
+	pass.scale = scale > 0 ? std::min(scale, 1.0f) : 1.0f;
+	passes.push_back(pass);
+
+	return passes.size() - 1;
+}
+
+int LUNAPostProcess::GetPassesCount()
+{
+	return passes.size();
+}
+
+bool LUNAPostProcess::IsPassEnabled(int index)
+{
+	if(!CheckIndex(index)) return false;
+	return passes[index].enabled;
+}
+
+// Disabled passes are skipped without using any render target
+void LUNAPostProcess::SetPassEnabled(int index, bool enabled)
+{
+	if(!CheckIndex(index)) return;
+	passes[index].enabled = enabled;
+}
+
+void LUNAPostProcess::Clear()
+{
+	if(inProgress) LUNA_RETURN_ERR("Cannot clear post-process passes between \"begin\" and \"end\"");
+	passes.clear();
+}
+
+LUNAColorType LUNAPostProcess::GetColorType()
+{
+	return colorType;
+}
+
+void LUNAPostProcess::SetColorType(LUNAColorType colorType)
+{
+	this->colorType = colorType;
+}
+
+// Redirect rendering to offscreen target. Does nothing when all passes are disabled
+void LUNAPostProcess::Begin()
+{
+	if(inProgress) LUNA_RETURN_ERR("Post-process already in progress");
+	if(!HasEnabledPasses()) return;
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	prevFrameBuffer = renderer->GetFrameBuffer();
+
+	int width = prevFrameBuffer ? prevFrameBuffer->GetViewportWidth() : LUNAEngine::SharedSizes()->GetPhysicalScreenWidth();
+	int height = prevFrameBuffer ? prevFrameBuffer->GetViewportHeight() : LUNAEngine::SharedSizes()->GetPhysicalScreenHeight();
+
+	sceneTarget = LUNAEngine::SharedGraphics()->GetFrameBufferPool()->Acquire(width, height, colorType);
+	renderer->SetFrameBuffer(sceneTarget);
+
+	// Content of pooled target is undefined
+	LUNAColor backColor = renderer->GetBackgroundColor();
+	glClearColor(backColor.r, backColor.g, backColor.b, backColor.a);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	inProgress = true;
+}
+
+// Apply enabled passes to scene rendered since "Begin"
+void LUNAPostProcess::End()
+{
+	if(!inProgress) return;
+
+	inProgress = false;
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	LUNAFrameBufferPool* pool = LUNAEngine::SharedGraphics()->GetFrameBufferPool();
+	int width = sceneTarget->GetViewportWidth();
+	int height = sceneTarget->GetViewportHeight();
+
+	// Find last enabled pass. It renders directly to previous target
+	int lastPass = -1;
+	for(int i = 0; i < (int)passes.size(); i++)
+	{
+		if(passes[i].enabled && !passes[i].shader.expired()) lastPass = i;
+	}
+
+	std::shared_ptr<LUNAFrameBuffer> source = sceneTarget;
+	sceneTarget = nullptr;
+
+	for(int i = 0; i <= lastPass; i++)
+	{
+		Pass& pass = passes[i];
+		if(!pass.enabled || pass.shader.expired()) continue;
+
+		std::shared_ptr<LUNAFrameBuffer> target = prevFrameBuffer;
+		int targetWidth = width;
+		if(i != lastPass)
+		{
+			targetWidth = std::max(1, (int)(width * pass.scale));
+			int targetHeight = std::max(1, (int)(height * pass.scale));
+			target = pool->Acquire(targetWidth, targetHeight, colorType);
+		}
+
+		// Scaled passes need linear filtering, same size passes are copied texel to texel
+		source->GetTexture()->SetFilter(source->GetViewportWidth() == targetWidth ?
+			LUNATextureFilter::NEAREST : LUNATextureFilter::LINEAR);
+
+		// Switching target flushes previous pass, so released source can be safely reused by next target
+		renderer->SetFrameBuffer(target);
+		RenderPass(pass, source);
+		pool->Release(source);
+		source = target;
+	}
+
+	// Flush last pass while its material and source are alive
+	renderer->Render();
+	prevFrameBuffer = nullptr;
+}
@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunaframebuffer.h"
+#include "lunamaterial.h"
+
+namespace luna2d{
+
+//-------------------------------------------------------------------
+// Chain of fullscreen shader passes applied to rendered scene.
+// Scene is rendered to offscreen target, then each enabled pass draws
+// output of previous pass to next target. Targets are taken from
+// framebuffer pool and returned to it right after reading, so chain
+// ping-pongs between two reused targets. Last pass draws to target
+// which was set before "Begin" (usually screen)
+//-------------------------------------------------------------------
+class LUNAPostProcess
+{
+	LUNA_USERDATA(LUNAPostProcess)
+
+public:
+	struct Pass
+	{
+		std::weak_ptr<LUNAShader> shader;
+		float scale = 1; // Size of pass output relative to scene size. Downsampled targets are filtered linearly
+		bool enabled = true;
+		LUNAMaterial material;
+	};
+
+public:
+	LUNAPostProcess();
+	~LUNAPostProcess();
+
+private:
+	std::vector<Pass> passes;
+	std::shared_ptr<LUNAFrameBuffer> sceneTarget;
+	std::shared_ptr<LUNAFrameBuffer> prevFrameBuffer; // Target bound before "Begin"
+	LUNAColorType colorType = LUNAColorType::RGBA;
+	bool inProgress = false;
+
+private:
+	bool CheckIndex(int index);
+	bool HasEnabledPasses();
+	void RenderPass(Pass& pass, const std::shared_ptr<LUNAFrameBuffer>& source);
+
+public:
+	// Add pass with given shader. Returns index of added pass
+	int AddPass(const std::weak_ptr<LUNAShader>& shader, float scale);
+
+	int GetPassesCount();
+	bool IsPassEnabled(int index);
+
+	// Disabled passes are skipped without using any render target
+	void SetPassEnabled(int index, bool enabled);
+
+	void Clear();
+
+	LUNAColorType GetColorType();
+	void SetColorType(LUNAColorType colorType);
+
+	// Redirect rendering to offscreen target. Does nothing when all passes are disabled
+	void Begin();
+
+	// Apply enabled passes to scene rendered since "Begin"
+	void End();
+};
+
+}
@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaprogramcache.h"
+#include "lunalog.h"
+#include "lunafiles.h"
+#include "lunaconfig.h"
+#include "lunaglstate.h"
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID && !defined(LUNA_HEADLESS_GL)
+	#define LUNA_PROGRAM_BINARY_OES
+	#include <EGL/egl.h>
+#endif
+
+using namespace luna2d;
+
+#ifdef LUNA_PROGRAM_BINARY_OES
+
+// Header of cache file. Binary data follows after header
+struct ProgramBinaryHeader
+{
+	uint32_t magic;
+	uint32_t format;
+};
+
+const uint32_t PROGRAM_BINARY_MAGIC = 0x3142504C; // "LPB1"
+const std::string PROGRAM_CACHE_PREFIX = "program_";
+
+static PFNGLGETPROGRAMBINARYOESPROC getProgramBinary = nullptr;
+static PFNGLPROGRAMBINARYOESPROC programBinary = nullptr;
+static int supported = -1; // -1 when not checked yet
+
+static std::string GetGlString(GLenum name)
+{
+	const GLubyte* str = glGetString(name);
+	return str ? std::string(reinterpret_cast<const char*>(str)) : "";
+}
+
+// Make name of cache file from 64-bit FNV-1a hash of sources and driver strings
+static std::string MakeFilename(const std::string& vertexSource, const std::string& fragmentSource)
+{
+	uint64_t hash = 14695981039346656037ULL;
+	auto hashString = [&hash](const std::string& str)
+	{
+		for(unsigned char c : str)
+		{
+			hash ^= c;
+			hash *= 1099511628211ULL;
+		}
+
+		// Separate strings to make "ab" + "c" and "a" + "bc" different
+		hash ^= 0xFF;
+		hash *= 1099511628211ULL;
+	};
+
+	hashString(vertexSource);
+	hashString(fragmentSource);
+	hashString(GetGlString(GL_VENDOR));
+	hashString(GetGlString(GL_RENDERER));
+	hashString(GetGlString(GL_VERSION));
+
+	char hex[17];
+	snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+	return PROGRAM_CACHE_PREFIX + hex + ".bin";
+}
+
+#endif
+
+// Check whether program binaries are supported by driver and enabled in config
+bool programcache::IsSupported()
+{
+#ifdef LUNA_PROGRAM_BINARY_OES
+	if(supported == -1)
+	{
+		supported = 0;
+
+		if(!LUNAEngine::Shared()->GetConfig()->programCache) return false;
+
+		// Some drivers expose extension without any supported binary format
+		GLint formatsCount = 0;
+		std::string extensions = GetGlString(GL_EXTENSIONS);
+		if(extensions.find("GL_OES_get_program_binary") == std::string::npos) return false;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &formatsCount);
+		if(formatsCount <= 0) return false;
+
+		getProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYOESPROC>(eglGetProcAddress("glGetProgramBinaryOES"));
+		programBinary = reinterpret_cast<PFNGLPROGRAMBINARYOESPROC>(eglGetProcAddress("glProgramBinaryOES"));
+		if(getProgramBinary && programBinary) supported = 1;
+	}
+
+	return supported == 1;
+#else
+	return false;
+#endif
+}
+
+// Create program from cached binary. Returns 0 when binary not found or rejected by driver
+GLuint programcache::LoadProgram(const std::string& vertexSource, const std::string& fragmentSource)
+{
+#ifdef LUNA_PROGRAM_BINARY_OES
+	if(!IsSupported()) return 0;
+
+	auto files = LUNAEngine::SharedFiles();
+	std::string filename = MakeFilename(vertexSource, fragmentSource);
+	if(!files->IsFile(filename, LUNAFileLocation::CACHE)) return 0;
+
+	std::vector<unsigned char> data = files->ReadFile(filename, LUNAFileLocation::CACHE);
+	if(data.size() <= sizeof(ProgramBinaryHeader)) return 0;
+
+	ProgramBinaryHeader header;
+	memcpy(&header, &data[0], sizeof(header));
+	if(header.magic != PROGRAM_BINARY_MAGIC) return 0;
+
+	GLuint program = glCreateProgram();
+	if(!program) return 0;
+
+	programBinary(program, header.format, &data[sizeof(header)], data.size() - sizeof(header));
+
+	// Driver can reject binary after driver update or for any other reason. Shaders will be compiled from source
+	// and binary will be overwritten after successful linking
+	GLint linkStatus = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &linkStatus);
+	if(!linkStatus)
+	{
+		glGetError(); // Clear possible "GL_INVALID_ENUM" for unsupported format
+		glstate::DeleteProgram(program);
+		return 0;
+	}
+
+	return program;
+#else
+	return 0;
+#endif
+}
+
+// Save binary of successfully linked program to cache
+void programcache::SaveProgram(GLuint program, const std::string& vertexSource, const std::string& fragmentSource)
+{
+#ifdef LUNA_PROGRAM_BINARY_OES
+	if(!IsSupported()) return;
+
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+	if(length <= 0) return;
+
+	std::vector<unsigned char> data(sizeof(ProgramBinaryHeader) + length);
+	ProgramBinaryHeader header;
+	GLenum format = 0;
+	getProgramBinary(program, length, nullptr, &format, &data[sizeof(header)]);
+
+	header.magic = PROGRAM_BINARY_MAGIC;
+	header.format = format;
+	memcpy(&data[0], &header, sizeof(header));
+
+	std::string filename = MakeFilename(vertexSource, fragmentSource);
+	if(!LUNAEngine::SharedFiles()->WriteFile(filename, data, LUNAFileLocation::CACHE))
+	{
+		LUNA_LOGE("Cannot write program binary to cache");
+	}
+#endif
+}
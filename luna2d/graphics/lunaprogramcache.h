@@ -0,0 +1,48 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunagl.h"
+#include <string>
+
+namespace luna2d{ namespace programcache{
+
+//-------------------------------------------------------------------
+// Cache of linked shader program binaries stored in cache folder.
+// Cache entries are keyed by hash of preprocessed shader sources
+// and driver strings, so driver updates don't load stale binaries.
+// Uses "GL_OES_get_program_binary" extension, on platforms without
+// it shaders are always compiled from source
+//-------------------------------------------------------------------
+
+// Check whether program binaries are supported by driver and enabled in config
+bool IsSupported();
+
+// Create program from cached binary. Returns 0 when binary not found or rejected by driver
+GLuint LoadProgram(const std::string& vertexSource, const std::string& fragmentSource);
+
+// Save binary of successfully linked program to cache
+void SaveProgram(GLuint program, const std::string& vertexSource, const std::string& fragmentSource);
+
+}}
@@ -22,42 +22,457 @@
 //-----------------------------------------------------------------------------
 
 #include "lunarenderer.h"
+#include "lunaintersect.h"
 #include "lunagraphics.h"
 #include "lunasizes.h"
 #include "lunalog.h"
 #include "lunaassets.h"
 #include "lunaimage.h"
+#include "lunaconfig.h"
+#include "lunaglstate.h"
 
 using namespace luna2d;
 
-LUNARenderer::LUNARenderer()
+LUNARenderer::LUNARenderer() :
+	vertexFormat(LUNAEngine::Shared()->GetConfig()->vertexFormat, LUNAEngine::Shared()->GetConfig()->multiTexture),
+	floatTexCoordsFormat(vertexFormat.GetFloatTexCoordsFormat())
 {
 	// Initialize batch vertex array
-	vertexBatch.reserve(RENDER_RESERVE_BATCH * RENDER_ELEMENT_PER_VERTEX);
+	vertexBatch.reserve(RENDER_RESERVE_BATCH * vertexFormat.GetStride());
 
 	// Initialize default shaders
 	defaultShader = std::make_shared<LUNAShader>(DEFAULT_VERT_SHADER, DEFAULT_FRAG_SHADER);
 	primitivesShader = std::make_shared<LUNAShader>(PRIMITIVES_VERT_SHADER, PRIMITIVES_FRAG_SHADER);
 	fontShader = std::make_shared<LUNAShader>(FONT_VERT_SHADER, FONT_FRAG_SHADER);
+	sdfFontShader = std::make_shared<LUNAShader>(FONT_VERT_SHADER, SDF_FONT_FRAG_SHADER);
+
+	if(vertexFormat.HasTextureIndex()) InitMultiTexture();
+
+	InitQuadIndexes();
+	CreateQuadIndexBuffer();
 
 	SetDefaultViewport();
 }
 
+LUNARenderer::~LUNARenderer()
+{
+	glstate::DeleteBuffers(1, &quadIndexBuffer);
+}
+
+void LUNARenderer::InitQuadIndexes()
+{
+	quadIndexes.reserve(RENDER_MAX_BATCH_QUADS * 6);
+
+	// Each quad consists of two triangles like:
+	// 1-2
+	// |/|
+	// 0-3
+	for(int i = 0; i < RENDER_MAX_BATCH_QUADS; i++)
+	{
+		GLushort first = i * 4;
+
+		quadIndexes.push_back(first);
+		quadIndexes.push_back(first + 1);
+		quadIndexes.push_back(first + 2);
+
+		quadIndexes.push_back(first);
+		quadIndexes.push_back(first + 2);
+		quadIndexes.push_back(first + 3);
+	}
+}
+
+void LUNARenderer::CreateQuadIndexBuffer()
+{
+	glGenBuffers(1, &quadIndexBuffer);
+	if(quadIndexBuffer == 0) return;
+
+	glstate::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBuffer);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, quadIndexes.size() * sizeof(GLushort), &quadIndexes[0], GL_STATIC_DRAW);
+	glstate::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+	LUNA_CHECK_GL_ERROR();
+}
+
+void LUNARenderer::InitMultiTexture()
+{
+	maxBatchTextures = glstate::GetMaxTextureUnits();
+
+	if(maxBatchTextures < 2)
+	{
+		LUNA_LOGW("Multi-texture batching is not supported on this device");
+		return;
+	}
+
+	multiTextureShader = std::make_shared<LUNAShader>(MULTITEXTURE_VERT_SHADER, MakeMultiTextureFragShader());
+	if(!multiTextureShader->IsValid())
+	{
+		LUNA_LOGE("Cannot create shader for multi-texture batching");
+		multiTextureShader = nullptr;
+	}
+}
+
+// Make source of multi-texture fragment shader for supported count of texture units
+std::string LUNARenderer::MakeMultiTextureFragShader()
+{
+	return "#define MAX_TEXTURES " + std::to_string(maxBatchTextures) + "\n" + MULTITEXTURE_FRAG_SHADER;
+}
+
+// Get index of texture unit for given texture in current multi-texture batch
+// Returns -1 if texture isn't in batch and all units are used
+int LUNARenderer::GetBatchTextureIndex(const std::shared_ptr<LUNATexture>& texture)
+{
+	for(size_t i = 0; i < batchTextures.size(); i++)
+	{
+		if(batchTextures[i] == texture) return i;
+	}
+
+	if(batchTextures.size() >= (size_t)maxBatchTextures) return -1;
+
+	batchTextures.push_back(texture);
+	return batchTextures.size() - 1;
+}
+
+// Flush current batch if it cannot be continued with given material, mode and vertex format
+// or cannot fit "vertexSize" bytes of new vertexes
+void LUNARenderer::PrepareBatch(const LUNAMaterial* material, LUNABatchMode mode, size_t vertexSize, bool floatTexCoords)
+{
+	const LUNAVertexFormat* format = floatTexCoords ? &floatTexCoordsFormat : &vertexFormat;
+
+	// Materials with default shader can be batched together regardless of texture
+	bool multiTextureMaterial = multiTextureShader && material->shader.lock() == defaultShader;
+	std::shared_ptr<LUNATexture> texture;
+	if(multiTextureMaterial) texture = material->texture.lock();
+
+	if(vertexBatch.empty()) batchTextures.clear();
+	else
+	{
+		bool canContinue = false;
+
+		if(multiTextureBatch && multiTextureMaterial)
+		{
+			canContinue = curMaterial->blending == material->blending && batchMode == mode &&
+				GetBatchTextureIndex(texture) != -1;
+		}
+		else if(!multiTextureBatch && !multiTextureMaterial)
+		{
+			canContinue = curMaterial && *curMaterial == *material && batchMode == mode;
+		}
+
+		// Vertexes in different formats cannot be rendered with one draw call
+		if(batchFormat->GetType() != format->GetType()) canContinue = false;
+
+		// Quads batch is limited by size of index buffer
+		size_t maxSize = static_cast<size_t>(RENDER_MAX_BATCH_QUADS * 4 * format->GetStride());
+		if(mode == LUNABatchMode::QUADS && vertexBatch.size() + vertexSize > maxSize) canContinue = false;
+
+		if(!canContinue) RenderBatch();
+	}
+
+	curMaterial = material;
+	batchMode = mode;
+	batchFormat = format;
+	multiTextureBatch = multiTextureMaterial;
+	curTextureIndex = multiTextureMaterial ? GetBatchTextureIndex(texture) : 0;
+}
+
 void LUNARenderer::SetVertex(float u, float v, float x, float y, const LUNAColor& color)
 {
-	// Position
-	vertexBatch.push_back(x);
-	vertexBatch.push_back(y);
+	vertexFormat.AppendVertex(vertexBatch, x, y, color, u, v, curTextureIndex);
+}
+
+// Append vertexes in renderer vertex format to current batch
+void LUNARenderer::AppendVertexes(const unsigned char* vertexes, size_t size)
+{
+	size_t offset = vertexBatch.size();
+	vertexBatch.insert(vertexBatch.end(), vertexes, vertexes + size);
+
+	if(multiTextureBatch)
+	{
+		batchFormat->WriteTextureIndex(&vertexBatch[offset], size / batchFormat->GetStride(), curTextureIndex);
+	}
+}
+
+// Upload given vertexes to next stream buffer if vertex buffers enabled
+// Returns pointer to vertex data for setting shader attributes
+const GLvoid* LUNARenderer::UploadVertexes(const std::vector<unsigned char>& vertexes)
+{
+	size_t size = vertexes.size();
+	uploadedBytes += size;
+
+	// Fallback to client-side vertex arrays
+	if(!vertexBuffers || !streamBuffer.IsValid()) return &vertexes[0];
+
+	streamBuffer.Upload(&vertexes[0], size);
+	return nullptr; // Attributes are specifed as offsets in bound buffer
+}
+
+void LUNARenderer::SetBlendingMode(LUNABlendingMode blending)
+{
+	switch(blending)
+	{
+	case LUNABlendingMode::NONE:
+		glstate::EnableBlending(false);
+		break;
+	case LUNABlendingMode::ALPHA:
+		glstate::EnableBlending(true);
+		glstate::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		break;
+	case LUNABlendingMode::ADDITIVE:
+		glstate::EnableBlending(true);
+		glstate::BlendFunc(GL_SRC_ALPHA, GL_ONE);
+		break;
+	}
+}
+
+// Set scissor test to given rect or disable it if rect is nullptr
+void LUNARenderer::ApplyScissor(const LUNARect* rect)
+{
+	// Geometry batched before must be rendered with previous scissor
+	Render();
+
+	scissorEnabled = rect != nullptr;
+	glstate::EnableScissor(scissorEnabled);
+	if(!rect) return;
+
+	scissorRect = *rect;
+
+	auto pos = camera->Project(glm::vec2(rect->x, rect->y));
+	auto size = camera->Project(glm::vec2(rect->x + rect->width, rect->y + rect->height));
+	size -= pos;
+
+	glstate::Scissor((GLint)std::roundf(pos.x), (GLint)std::roundf(pos.y),
+		(GLsizei)std::roundf(size.x), (GLsizei)std::roundf(size.y));
+}
+
+// Update scissor test for rendering geometry with given bounds
+// Scissor test is changed only when it would cut geometry incorrectly
+void LUNARenderer::UpdateScissor(const LUNARect& bounds)
+{
+	if(!clipStack.empty() && !intersect::RectangleInRectangle(bounds, clipStack.back()))
+	{
+		// Geometry crosses edge of clip rect, so it must be cut exactly by clip rect
+		const LUNARect& clipRect = clipStack.back();
+		bool sameRect = scissorRect.x == clipRect.x && scissorRect.y == clipRect.y &&
+			scissorRect.width == clipRect.width && scissorRect.height == clipRect.height;
 
-	// Color
-	vertexBatch.push_back(color.r);
-	vertexBatch.push_back(color.g);
-	vertexBatch.push_back(color.b);
-	vertexBatch.push_back(color.a);
+		if(!scissorEnabled || !sameRect) ApplyScissor(&clipRect);
+	}
 
-	// Texture coordinates
-	vertexBatch.push_back(u);
-	vertexBatch.push_back(v);
+	// Geometry must not be cut by scissor
+	else if(scissorEnabled && !intersect::RectangleInRectangle(bounds, scissorRect)) ApplyScissor(nullptr);
+}
+
+// Trim axis-aligned quad by top clip rect with adjusting texture coordinates
+// Returns false if quad isn't axis-aligned and cannot be trimmed
+bool LUNARenderer::TrimQuad(float& x1, float& y1, float& u1, float& v1,
+	float& x2, float& y2, float& u2, float& v2,
+	float& x3, float& y3, float& u3, float& v3,
+	float& x4, float& y4, float& u4, float& v4)
+{
+	// Quad should have left side "1-2", top side "2-3" with texture coordinates mapped along axes
+	if(x1 != x2 || x3 != x4 || y1 != y4 || y2 != y3) return false;
+	if(u1 != u2 || u3 != u4 || v1 != v4 || v2 != v3) return false;
+
+	const LUNARect& clipRect = clipStack.back();
+
+	// Clamp both ends of segment by range, and interpolate texture coordinate for new ends
+	auto trim = [](float& a, float& b, float& ta, float& tb, float min, float max)
+	{
+		if(a == b) return;
+
+		float newA = std::max(min, std::min(a, max));
+		float newB = std::max(min, std::min(b, max));
+		float newTa = ta + (tb - ta) * (newA - a) / (b - a);
+		float newTb = ta + (tb - ta) * (newB - a) / (b - a);
+
+		a = newA;
+		b = newB;
+		ta = newTa;
+		tb = newTb;
+	};
+
+	trim(x1, x3, u1, u3, clipRect.x, clipRect.x + clipRect.width);
+	trim(y1, y2, v1, v2, clipRect.y, clipRect.y + clipRect.height);
+
+	x2 = x1;
+	x4 = x3;
+	y4 = y1;
+	y3 = y2;
+	u2 = u1;
+	u4 = u3;
+	v4 = v1;
+	v3 = v2;
+
+	return true;
+}
+
+// Get bounding box of vertexes in given format
+LUNARect LUNARenderer::GetVertexesBounds(const std::vector<unsigned char>& vertexes, const LUNAVertexFormat& format)
+{
+	float left, bottom, right, top;
+	format.ReadPosition(vertexes, 0, left, bottom);
+	right = left;
+	top = bottom;
+
+	size_t count = format.GetVertexCount(vertexes);
+	for(size_t i = 1; i < count; i++)
+	{
+		float x, y;
+		format.ReadPosition(vertexes, i, x, y);
+		left = std::min(left, x);
+		bottom = std::min(bottom, y);
+		right = std::max(right, x);
+		top = std::max(top, y);
+	}
+
+	return LUNARect(left, bottom, right - left, top - bottom);
+}
+
+// Render current batch
+void LUNARenderer::RenderBatch()
+{
+	if(vertexBatch.empty()) return;
+
+	int vertexCount = batchFormat->GetVertexCount(vertexBatch);
+
+	SetBlendingMode(curMaterial->blending);
+
+	auto shader = multiTextureBatch ? multiTextureShader : curMaterial->shader.lock();
+
+	const GLvoid* vertexData = UploadVertexes(vertexBatch);
+
+	shader->Bind();
+	shader->SetPositionAttribute(vertexData, *batchFormat);
+	shader->SetColorAttribute(vertexData, *batchFormat);
+	shader->SetTexCoordsAttribute(vertexData, *batchFormat);
+	shader->SetTransformMatrix(camera->GetMatrix(), camera->GetMatrixVersion());
+
+	if(multiTextureBatch)
+	{
+		shader->SetTextureIndexAttribute(vertexData, *batchFormat);
+		shader->SetTextureUnitsUniform(maxBatchTextures);
+		for(size_t i = 0; i < batchTextures.size(); i++) batchTextures[i]->Bind(i);
+	}
+	else shader->SetTextureUniform(*curMaterial->texture.lock());
+
+	if(batchMode == LUNABatchMode::QUADS)
+	{
+		int indexCount = (vertexCount / 4) * 6;
+
+		if(vertexBuffers && quadIndexBuffer != 0)
+		{
+			glstate::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBuffer);
+			glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, nullptr);
+		}
+		else
+		{
+			glstate::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+			glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_SHORT, &quadIndexes[0]);
+		}
+	}
+	else glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+
+	vertexBatch.clear();
+	batchTextures.clear();
+	renderedVertexes += vertexCount;
+	renderCalls++;
+
+	LUNA_CHECK_GL_ERROR();
+}
+
+// Render quads from retained vertex buffer without merging them to current batch
+void LUNARenderer::RenderBuffer(GLuint buffer, size_t vertexSize, const LUNAMaterial* material)
+{
+	int stride = vertexFormat.GetStride();
+	int quadsCount = vertexSize / (stride * 4);
+
+	auto shader = material->shader.lock();
+
+	SetBlendingMode(material->blending);
+	shader->Bind();
+	shader->SetTransformMatrix(camera->GetMatrix(), camera->GetMatrixVersion());
+	shader->SetTextureUniform(*material->texture.lock());
+
+	glstate::BindBuffer(GL_ARRAY_BUFFER, buffer);
+	glstate::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, quadIndexBuffer);
+
+	// Count of quads in one draw call is limited by size of static quad index buffer
+	for(int first = 0; first < quadsCount; first += RENDER_MAX_BATCH_QUADS)
+	{
+		int count = std::min(quadsCount - first, RENDER_MAX_BATCH_QUADS);
+		const GLvoid* vertexData = reinterpret_cast<const GLvoid*>(static_cast<size_t>(first) * 4 * stride);
+
+		shader->SetPositionAttribute(vertexData, vertexFormat);
+		shader->SetColorAttribute(vertexData, vertexFormat);
+		shader->SetTexCoordsAttribute(vertexData, vertexFormat);
+
+		glDrawElements(GL_TRIANGLES, count * 6, GL_UNSIGNED_SHORT, nullptr);
+
+		renderedVertexes += count * 4;
+		renderCalls++;
+	}
+
+	LUNA_CHECK_GL_ERROR();
+}
+
+// Render all batched lines with one draw call
+void LUNARenderer::RenderLines()
+{
+	if(lineBatch.empty()) return;
+
+	int vertexCount = vertexFormat.GetVertexCount(lineBatch);
+
+	SetBlendingMode(LUNABlendingMode::ALPHA);
+
+	const GLvoid* vertexData = UploadVertexes(lineBatch);
+
+	primitivesShader->Bind();
+	primitivesShader->SetPositionAttribute(vertexData, vertexFormat);
+	primitivesShader->SetColorAttribute(vertexData, vertexFormat);
+	primitivesShader->SetTransformMatrix(camera->GetMatrix(), camera->GetMatrixVersion());
+	glDrawArrays(GL_LINES, 0, vertexCount);
+
+	lineBatch.clear();
+	renderedVertexes += vertexCount;
+	renderCalls++;
+
+	LUNA_CHECK_GL_ERROR();
+}
+
+// Sort recorded draw calls and render them with fewest batches
+void LUNARenderer::FlushQueue()
+{
+	if(renderQueue.IsEmpty()) return;
+
+	renderQueue.Sort();
+
+	size_t count = renderQueue.GetCount();
+	for(size_t i = 0; i < count; i++)
+	{
+		const LUNARenderCommand& command = renderQueue.GetCommand(i);
+
+		if(command.buffer != 0)
+		{
+			RenderBatch();
+			RenderBuffer(command.buffer, command.vertexSize, &command.material);
+			continue;
+		}
+
+		const unsigned char* vertexes = renderQueue.GetVertexes(command);
+
+		bool merged = !vertexBatch.empty();
+		int prevRenderCalls = renderCalls;
+
+		PrepareBatch(&command.material, command.mode, command.vertexSize, command.floatTexCoords);
+		if(merged && renderCalls == prevRenderCalls) mergedDraws++;
+
+		AppendVertexes(vertexes, command.vertexSize);
+	}
+
+	// Materials of current batch are stored in queue, so batch must be rendered before queue clearing
+	RenderBatch();
+	renderQueue.Clear();
+	curMaterial = nullptr;
 }
 
 bool LUNARenderer::IsInProgress()
@@ -75,6 +490,43 @@ int LUNARenderer::GetRenderedVertexes()
 	return renderedVertexes;
 }
 
+int LUNARenderer::GetUploadedBytes()
+{
+	return uploadedBytes;
+}
+
+int LUNARenderer::GetMergedDraws()
+{
+	return mergedDraws;
+}
+
+int LUNARenderer::GetCulledObjects()
+{
+	return culledObjects;
+}
+
+int LUNARenderer::GetIssuedStateCalls()
+{
+	return glstate::GetIssuedCalls();
+}
+
+int LUNARenderer::GetSkippedStateCalls()
+{
+	return glstate::GetSkippedCalls();
+}
+
+const LUNAVertexFormat& LUNARenderer::GetVertexFormat()
+{
+	return vertexFormat;
+}
+
+// Get format for vertex arrays with texture coordinates out of range supported by renderer vertex format
+// SEE: "LUNARenderer::RenderVertexArray"
+const LUNAVertexFormat& LUNARenderer::GetFloatTexCoordsFormat()
+{
+	return floatTexCoordsFormat;
+}
+
 std::shared_ptr<LUNAShader> LUNARenderer::GetDefaultShader()
 {
 	return defaultShader;
@@ -90,6 +542,12 @@ std::shared_ptr<LUNAShader> LUNARenderer::GetFontShader()
 	return fontShader;
 }
 
+// Shader for signed distance field fonts
+std::shared_ptr<LUNAShader> LUNARenderer::GetSdfFontShader()
+{
+	return sdfFontShader;
+}
+
 LUNAColor LUNARenderer::GetBackgroundColor()
 {
 	return backColor;
@@ -105,31 +563,61 @@ void LUNARenderer::SetCamera(const std::shared_ptr<LUNACamera>& camera)
 	this->camera = camera;
 }
 
-void LUNARenderer::EnableScissor(float x, float y, float width, float height)
+// Push clip rect in world coordinates. Rect is intersected with current clip rect
+// Geometry fully outside clip rect is skipped, axis-aligned quads are trimmed on CPU,
+// scissor test is used only for other geometry crossing edge of clip rect
+void LUNARenderer::PushClipRect(float x, float y, float width, float height)
 {
-	Render();
+	float left = x;
+	float bottom = y;
+	float right = x + width;
+	float top = y + height;
 
-	const auto& camera = LUNAEngine::SharedGraphics()->GetCamera();
-	auto pos = camera->Project(glm::vec2(x, y));
-	auto size = camera->Project(glm::vec2(x + width, y + height));
-	size -= pos;
+	if(!clipStack.empty())
+	{
+		const LUNARect& curRect = clipStack.back();
+		left = std::max(left, curRect.x);
+		bottom = std::max(bottom, curRect.y);
+		right = std::min(right, curRect.x + curRect.width);
+		top = std::min(top, curRect.y + curRect.height);
+	}
 
-	glEnable(GL_SCISSOR_TEST);
-	glScissor((GLint)std::roundf(pos.x), (GLint)std::roundf(pos.y),
-		(GLsizei)std::roundf(size.x), (GLsizei)std::roundf(size.y));
+	clipStack.push_back(LUNARect(left, bottom, std::max(right - left, 0.0f), std::max(top - bottom, 0.0f)));
+}
+
+void LUNARenderer::PopClipRect()
+{
+	if(clipStack.empty()) LUNA_RETURN_ERR("Attempt to pop clip rect from empty stack");
+
+	clipStack.pop_back();
 }
 
+// Replace all clip rects with given one
+void LUNARenderer::EnableScissor(float x, float y, float width, float height)
+{
+	clipStack.clear();
+	PushClipRect(x, y, width, height);
+}
+
+// Remove all clip rects
 void LUNARenderer::DisableScissor()
 {
-	Render();
+	clipStack.clear();
+}
 
-	glDisable(GL_SCISSOR_TEST);
+std::shared_ptr<LUNAFrameBuffer> LUNARenderer::GetFrameBuffer()
+{
+	return frameBuffer;
 }
 
 void LUNARenderer::SetFrameBuffer(const std::shared_ptr<LUNAFrameBuffer>& frameBuffer)
 {
 	if(inProgress) Render();
 
+	// Scissor rect was set for previous target, so it must not cut clearing and rendering to new target
+	scissorEnabled = false;
+	glstate::EnableScissor(false);
+
 	if(this->frameBuffer) this->frameBuffer->Unbind();
 	if(frameBuffer) frameBuffer->Bind();
 
@@ -138,25 +626,34 @@ void LUNARenderer::SetFrameBuffer(const std::shared_ptr<LUNAFrameBuffer>& frameB
 
 void LUNARenderer::SetDefaultViewport()
 {
-	glViewport(0, 0, LUNAEngine::SharedSizes()->GetPhysicalScreenWidth(), LUNAEngine::SharedSizes()->GetPhysicalScreenHeight());
+	glstate::Viewport(0, 0, LUNAEngine::SharedSizes()->GetPhysicalScreenWidth(), LUNAEngine::SharedSizes()->GetPhysicalScreenHeight());
 }
 
 // Read screen pixels into instance of "LUNAImage"
 std::shared_ptr<LUNAImage> LUNARenderer::ReadPixels()
+{
+	int width, height;
+	std::vector<unsigned char> data;
+	ReadPixels(data, width, height);
+
+	auto image = std::make_shared<LUNAImage>(width, height, LUNAColorType::RGB, data);
+	image->FlipVertically();
+	return image;
+}
+
+// Read screen pixels in RGB format into given buffer. Buffer is reallocated only when it's too small
+// Rows are not flipped, so first row in buffer is bottom row of screen
+void LUNARenderer::ReadPixels(std::vector<unsigned char>& data, int& width, int& height)
 {
 	int viewport[4];
 	glGetIntegerv(GL_VIEWPORT, viewport);
 
-	int width = viewport[2];
-	int height = viewport[3];
+	width = viewport[2];
+	height = viewport[3];
 
-	std::vector<unsigned char> data(width * height * GetBytesPerPixel(LUNAColorType::RGB));
+	data.resize(width * height * GetBytesPerPixel(LUNAColorType::RGB));
 	glPixelStorei(GL_PACK_ALIGNMENT, 1);
 	glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, &data[0]);
-
-	auto image = std::make_shared<LUNAImage>(width, height, LUNAColorType::RGB, data);
-	image->FlipVertically();
-	return image;
 }
 
 bool LUNARenderer::IsEnabledDebugRender()
@@ -169,6 +666,77 @@ void LUNARenderer::EnableDebugRender(bool enable)
 	debugRender = enable;
 }
 
+bool LUNARenderer::IsEnabledVertexBuffers()
+{
+	return vertexBuffers;
+}
+
+void LUNARenderer::EnableVertexBuffers(bool enable)
+{
+	if(vertexBuffers == enable) return;
+
+	if(inProgress) Render();
+
+	// Client-side vertex arrays don't work while any vertex buffer is bound
+	if(!enable) streamBuffer.Unbind();
+
+	vertexBuffers = enable;
+}
+
+// Record draw calls and reorder them by material at flush
+// Draw calls with overlapping geometry keep their relative order
+bool LUNARenderer::IsEnabledDeferredRender()
+{
+	return deferred;
+}
+
+void LUNARenderer::EnableDeferredRender(bool enable)
+{
+	if(deferred == enable) return;
+
+	if(inProgress) Render();
+
+	deferred = enable;
+}
+
+// Layer for draw calls in deferred render mode. Layers are rendered in ascending order
+// Layers can be negative, valid range is ["RENDER_QUEUE_MIN_LAYER", "RENDER_QUEUE_MAX_LAYER"]
+// Has no effect in immediate render mode
+int LUNARenderer::GetLayer()
+{
+	return layer;
+}
+
+void LUNARenderer::SetLayer(int layer)
+{
+	if(layer < RENDER_QUEUE_MIN_LAYER || layer > RENDER_QUEUE_MAX_LAYER) LUNA_RETURN_ERR("Invalid layer %d", layer);
+
+	this->layer = layer;
+}
+
+// Skip objects outside of camera visible area before writing their vertexes
+bool LUNARenderer::IsEnabledCulling()
+{
+	return culling;
+}
+
+void LUNARenderer::EnableCulling(bool enable)
+{
+	culling = enable;
+}
+
+// Check whether object with given bounding box should be skipped by camera culling
+// Culled objects are counted in stats
+bool LUNARenderer::IsCulled(const LUNARect& bounds)
+{
+	// Geometry outside of clip rect is skipped even if culling disabled
+	bool clipped = !clipStack.empty() && !intersect::Rectangles(bounds, clipStack.back());
+	if(!clipped && (!culling || camera->IsVisible(bounds))) return false;
+
+	culledObjects++;
+	return true;
+}
+
 void LUNARenderer::RenderQuad(
 	float x1, float y1, float u1, float v1,
 	float x2, float y2, float u2, float v2,
@@ -176,21 +744,54 @@ void LUNARenderer::RenderQuad(
 	float x4, float y4, float u4, float v4,
 	const LUNAMaterial* material, const LUNAColor& color)
 {
-	if(curMaterial && *curMaterial != *material) Render();
-	curMaterial = material;
+	// Quad vertexes order:
+	// 2-3
+	// | |
+	// 1-4
+	// Triangles are assembled by static quad indexes
+	// SEE: "LUNARenderer::InitQuadIndexes"
+
+	float left = std::min(std::min(x1, x2), std::min(x3, x4));
+	float bottom = std::min(std::min(y1, y2), std::min(y3, y4));
+	float right = std::max(std::max(x1, x2), std::max(x3, x4));
+	float top = std::max(std::max(y1, y2), std::max(y3, y4));
+	LUNARect bounds(left, bottom, right - left, top - bottom);
+
+	if(!clipStack.empty())
+	{
+		if(!intersect::Rectangles(bounds, clipStack.back())) return;
+
+		// Trim quads crossing edge of clip rect to avoid using scissor test
+		if(!intersect::RectangleInRectangle(bounds, clipStack.back()) &&
+			TrimQuad(x1, y1, u1, v1, x2, y2, u2, v2, x3, y3, u3, v3, x4, y4, u4, v4))
+		{
+			bounds = LUNARect(std::min(x1, x3), std::min(y1, y2), std::abs(x3 - x1), std::abs(y2 - y1));
+		}
+	}
+
+	UpdateScissor(bounds);
 
-	// Make quad from two triangles like:
-	// 2-3 5
-	// |/ /|
-	// 1 4-6
+	if(deferred)
+	{
+		if(renderQueue.IsFull()) FlushQueue();
+
+		size_t stride = vertexFormat.GetStride();
+		unsigned char* dest = renderQueue.Add(*material, LUNABatchMode::QUADS, layer, bounds, stride * 4);
 
-	SetVertex(u1, v1, x1, y1, color); // 1
-	SetVertex(u2, v2, x2, y2, color); // 2
-	SetVertex(u3, v3, x3, y3, color); // 3
+		vertexFormat.WriteVertex(dest, x1, y1, color, u1, v1); // 1
+		vertexFormat.WriteVertex(dest + stride, x2, y2, color, u2, v2); // 2
+		vertexFormat.WriteVertex(dest + stride * 2, x3, y3, color, u3, v3); // 3
+		vertexFormat.WriteVertex(dest + stride * 3, x4, y4, color, u4, v4); // 4
+	}
+	else
+	{
+		PrepareBatch(material, LUNABatchMode::QUADS, vertexFormat.GetStride() * 4);
 
-	SetVertex(u1, v1, x1, y1, color); // 4
-	SetVertex(u3, v3, x3, y3, color); // 5
-	SetVertex(u4, v4, x4, y4, color); // 6
+		SetVertex(u1, v1, x1, y1, color); // 1
+		SetVertex(u2, v2, x2, y2, color); // 2
+		SetVertex(u3, v3, x3, y3, color); // 3
+		SetVertex(u4, v4, x4, y4, color); // 4
+	}
 
 	if(debugRender)
 	{
@@ -202,120 +803,245 @@ void LUNARenderer::RenderQuad(
 	}
 }
 
-void LUNARenderer::RenderVertexArray(std::vector<float>& vertexes, const LUNAMaterial* material)
+// Render prepared quads as single draw call entry. Vertexes should be in renderer vertex format
+// More than "RENDER_MAX_BATCH_QUADS" quads are split to several entries. Quads aren't trimmed by clip rects,
+// so scissor test is used when "bounds" cross edge of clip rect
+void LUNARenderer::RenderQuads(const std::vector<unsigned char>& vertexes, const LUNARect& bounds, const LUNAMaterial* material)
 {
-	if(curMaterial && *curMaterial != *material) Render();
-	curMaterial = material;
+	if(vertexes.empty()) return;
+	if(!clipStack.empty() && !intersect::Rectangles(bounds, clipStack.back())) return;
 
-	vertexBatch.insert(vertexBatch.end(), vertexes.begin(), vertexes.end());
+	UpdateScissor(bounds);
+
+	// Size of entry is limited by size of static quad index buffer
+	size_t maxSize = RENDER_MAX_BATCH_QUADS * 4 * vertexFormat.GetStride();
+	for(size_t offset = 0; offset < vertexes.size(); offset += maxSize)
+	{
+		size_t size = std::min(maxSize, vertexes.size() - offset);
+
+		if(deferred)
+		{
+			if(renderQueue.IsFull()) FlushQueue();
+
+			unsigned char* dest = renderQueue.Add(*material, LUNABatchMode::QUADS, layer, bounds, size);
+			std::memcpy(dest, &vertexes[offset], size);
+		}
+		else
+		{
+			PrepareBatch(material, LUNABatchMode::QUADS, size);
+			AppendVertexes(&vertexes[offset], size);
+		}
+	}
 
 	if(debugRender)
 	{
-		int count = vertexes.size();
-		for(int i = 0; i < count; i += RENDER_ELEMENT_PER_VERTEX * 3)
+		size_t count = vertexFormat.GetVertexCount(vertexes);
+		for(size_t i = 0; i + 3 < count; i += 4)
 		{
-			float x1 = vertexes[i];
-			float y1 = vertexes[i + 1];
-			float x2 = vertexes[i + RENDER_ELEMENT_PER_VERTEX];
-			float y2 = vertexes[i + RENDER_ELEMENT_PER_VERTEX + 1];
-			float x3 = vertexes[i + RENDER_ELEMENT_PER_VERTEX * 2];
-			float y3 = vertexes[i + RENDER_ELEMENT_PER_VERTEX * 2 + 1];
+			float x1, y1, x2, y2, x3, y3, x4, y4;
+			vertexFormat.ReadPosition(vertexes, i, x1, y1);
+			vertexFormat.ReadPosition(vertexes, i + 1, x2, y2);
+			vertexFormat.ReadPosition(vertexes, i + 2, x3, y3);
+			vertexFormat.ReadPosition(vertexes, i + 3, x4, y4);
 
 			RenderLine(x1, y1, x2, y2, LUNAColor::WHITE);
 			RenderLine(x1, y1, x3, y3, LUNAColor::WHITE);
 			RenderLine(x2, y2, x3, y3, LUNAColor::WHITE);
+			RenderLine(x1, y1, x4, y4, LUNAColor::WHITE);
+			RenderLine(x3, y3, x4, y4, LUNAColor::WHITE);
 		}
 	}
 }
 
-void LUNARenderer::RenderLine(float x1, float y1, float x2, float y2, const LUNAColor& color)
+// Render triangles list. Vertexes should be in renderer vertex format,
+// or in float texture coordinates format if "floatTexCoords" is true
+// SEE: "LUNARenderer::GetVertexFormat", "LUNARenderer::GetFloatTexCoordsFormat"
+void LUNARenderer::RenderVertexArray(const std::vector<unsigned char>& vertexes, const LUNAMaterial* material,
+	bool floatTexCoords)
 {
-	Render();
-	curMaterial = nullptr;
-	int vertexCount = 2;
+	if(vertexes.empty()) return;
 
-	// Position
-	vertexBatch =
+	// Formats are same when renderer vertex format has float texture coordinates
+	if(!vertexFormat.IsTexCoordsNormalized()) floatTexCoords = false;
+	const LUNAVertexFormat& format = floatTexCoords ? floatTexCoordsFormat : vertexFormat;
+
+	// Bounds are needed only for deferred render and clipping
+	if(deferred || !clipStack.empty() || scissorEnabled)
 	{
-		x1, y1,
-		color.r, color.g, color.b, color.a,
-		0, 0, // Unused texture coords
-		x2, y2,
-		color.r, color.g, color.b, color.a,
-		0, 0, // Unused texture coords
-	};
+		LUNARect bounds = GetVertexesBounds(vertexes, format);
+		if(!clipStack.empty() && !intersect::Rectangles(bounds, clipStack.back())) return;
 
-	primitivesShader->Bind();
-	primitivesShader->SetPositionAttribute(vertexBatch);
-	primitivesShader->SetColorAttribute(vertexBatch);
-	primitivesShader->SetTransformMatrix(camera->GetMatrix());
-	glDrawArrays(GL_LINES, 0, vertexCount);
+		UpdateScissor(bounds);
 
-	vertexBatch.clear();
-	renderedVertexes += vertexCount;
-	renderCalls++;
+		if(deferred)
+		{
+			if(renderQueue.IsFull()) FlushQueue();
 
-	LUNA_CHECK_GL_ERROR();
+			unsigned char* dest = renderQueue.Add(*material, LUNABatchMode::TRIANGLES, layer, bounds, vertexes.size(),
+				floatTexCoords);
+			std::memcpy(dest, &vertexes[0], vertexes.size());
+		}
+	}
+
+	if(!deferred)
+	{
+		PrepareBatch(material, LUNABatchMode::TRIANGLES, vertexes.size(), floatTexCoords);
+
+		AppendVertexes(&vertexes[0], vertexes.size());
+	}
+
+	if(debugRender)
+	{
+		size_t count = format.GetVertexCount(vertexes);
+		for(size_t i = 0; i + 2 < count; i += 3)
+		{
+			float x1, y1, x2, y2, x3, y3;
+			format.ReadPosition(vertexes, i, x1, y1);
+			format.ReadPosition(vertexes, i + 1, x2, y2);
+			format.ReadPosition(vertexes, i + 2, x3, y3);
+
+			RenderLine(x1, y1, x2, y2, LUNAColor::WHITE);
+			RenderLine(x1, y1, x3, y3, LUNAColor::WHITE);
+			RenderLine(x2, y2, x3, y3, LUNAColor::WHITE);
+		}
+	}
 }
 
-void LUNARenderer::BeginRender()
+// Render quads from retained vertex buffer. Vertexes should be in renderer vertex format
+// Client-side "vertexes" are used instead of "buffer" when vertex buffers are disabled
+// In deferred render mode draw call is recorded to queue, so buffer must not be changed until queue is flushed
+// SEE: "LUNARenderer::FlushBuffer"
+void LUNARenderer::RenderQuadsBuffer(GLuint buffer, const std::vector<unsigned char>& vertexes, const LUNARect& bounds,
+	const LUNAMaterial* material)
 {
-	inProgress = true;
-	renderCalls = 0;
-	renderedVertexes = 0;
+	if(vertexes.empty()) return;
 
-	vertexBatch.clear();
+	// Client-side vertexes are batched same as other quads
+	if(!vertexBuffers || buffer == 0 || quadIndexBuffer == 0)
+	{
+		RenderQuads(vertexes, bounds, material);
+		return;
+	}
 
-	glDisable(GL_DEPTH_TEST); // Depth test not needed for 2D
+	if(!clipStack.empty() && !intersect::Rectangles(bounds, clipStack.back())) return;
 
-	glClearColor(backColor.r, backColor.g, backColor.b, backColor.a);
-	glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+	UpdateScissor(bounds);
+
+	if(deferred)
+	{
+		if(renderQueue.IsFull()) FlushQueue();
+		renderQueue.AddBuffer(*material, layer, bounds, buffer, vertexes.size());
+	}
+	else
+	{
+		// Keep order with draw calls batched before
+		RenderBatch();
+		RenderBuffer(buffer, vertexes.size(), material);
+	}
 }
 
-void LUNARenderer::Render()
+// Render queued draw calls using given retained vertex buffer
+// Should be called before changing or deleting buffer passed to "RenderQuadsBuffer"
+void LUNARenderer::FlushBuffer(GLuint buffer)
 {
-	if(vertexBatch.empty()) return;
+	if(renderQueue.HasBuffer(buffer)) Render();
+}
+
+// Lines are batched separately from other geometry and rendered at end of current batch
+// Lines outside of clip rect are skipped, lines crossing its edge are cut by scissor test
+void LUNARenderer::RenderLine(float x1, float y1, float x2, float y2, const LUNAColor& color)
+{
+	// Changing scissor renders lines batched before with previous scissor
+	if(!clipStack.empty() || scissorEnabled)
+	{
+		LUNARect bounds(std::min(x1, x2), std::min(y1, y2), std::abs(x2 - x1), std::abs(y2 - y1));
+		if(!clipStack.empty() && !intersect::Rectangles(bounds, clipStack.back())) return;
+
+		UpdateScissor(bounds);
+	}
+
+	vertexFormat.AppendVertex(lineBatch, x1, y1, color, 0, 0); // Texture coords are unused
+	vertexFormat.AppendVertex(lineBatch, x2, y2, color, 0, 0);
+}
 
-	int vertexCount = vertexBatch.size() / RENDER_ELEMENT_PER_VERTEX;
+// Render lines connecting given points. If "closed" is true, last point is connected with first one
+void LUNARenderer::RenderPolyline(const std::vector<glm::vec2>& points, const LUNAColor& color, bool closed)
+{
+	if(points.size() < 2) return;
 
-	// Set blending mode
-	switch(curMaterial->blending)
+	for(size_t i = 0; i < points.size() - 1; i++)
 	{
-	case LUNABlendingMode::NONE:
-		glDisable(GL_BLEND);
-		break;
-	case LUNABlendingMode::ALPHA:
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-		break;
-	case LUNABlendingMode::ADDITIVE:
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-		break;
+		RenderLine(points[i].x, points[i].y, points[i + 1].x, points[i + 1].y, color);
 	}
 
-	auto shader = curMaterial->shader.lock();
-	auto texture = curMaterial->texture.lock();
+	if(closed) RenderLine(points.back().x, points.back().y, points[0].x, points[0].y, color);
+}
 
-	shader->Bind();
-	shader->SetPositionAttribute(vertexBatch);
-	shader->SetColorAttribute(vertexBatch);
-	shader->SetTexCoordsAttribute(vertexBatch);
-	shader->SetTransformMatrix(camera->GetMatrix());
-	shader->SetTextureUniform(*texture);
+void LUNARenderer::RenderRectangle(float x, float y, float width, float height, const LUNAColor& color)
+{
+	RenderLine(x, y, x, y + height, color);
+	RenderLine(x, y + height, x + width, y + height, color);
+	RenderLine(x + width, y + height, x + width, y, color);
+	RenderLine(x + width, y, x, y, color);
+}
+
+void LUNARenderer::RenderCircle(float x, float y, float radius, const LUNAColor& color)
+{
+	float step = glm::two_pi<float>() / RENDER_CIRCLE_SEGMENTS;
+	float prevX = x + radius;
+	float prevY = y;
+
+	for(int i = 1; i <= RENDER_CIRCLE_SEGMENTS; i++)
+	{
+		float curX = x + radius * std::cos(step * i);
+		float curY = y + radius * std::sin(step * i);
+
+		RenderLine(prevX, prevY, curX, curY, color);
+		prevX = curX;
+		prevY = curY;
+	}
+}
+
+void LUNARenderer::BeginRender()
+{
+	inProgress = true;
+	renderCalls = 0;
+	renderedVertexes = 0;
+	uploadedBytes = 0;
+	mergedDraws = 0;
+	culledObjects = 0;
 
-	glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+	// Platform code can change GL state between frames
+	glstate::Reset();
+	glstate::ResetCounters();
 
 	vertexBatch.clear();
-	renderedVertexes += vertexCount;
-	renderCalls++;
+	lineBatch.clear();
+	batchTextures.clear();
+	renderQueue.Clear();
 
-	LUNA_CHECK_GL_ERROR();
+	clipStack.clear();
+	scissorEnabled = false;
+	glstate::EnableScissor(false);
+
+	glDisable(GL_DEPTH_TEST); // Depth test not needed for 2D
+
+	glClearColor(backColor.r, backColor.g, backColor.b, backColor.a);
+	glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
+}
+
+void LUNARenderer::Render()
+{
+	RenderBatch();
+	FlushQueue();
+	RenderLines();
 }
 
 void LUNARenderer::EndRender()
 {
 	Render();
+	streamBuffer.Unbind();
+	glstate::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 	curMaterial = nullptr;
 	inProgress = false;
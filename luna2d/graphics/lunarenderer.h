@@ -28,6 +28,10 @@
 #include "lunacamera.h"
 #include "lunamaterial.h"
 #include "lunaframebuffer.h"
+#include "lunastreambuffer.h"
+#include "lunavertexformat.h"
+#include "lunarenderqueue.h"
+#include "lunaglstate.h"
 
 // Default shaders
 #include "shaders/default.vert.h"
@@ -36,9 +40,13 @@
 #include "shaders/primitives.frag.h"
 #include "shaders/font.vert.h"
 #include "shaders/font.frag.h"
+#include "shaders/sdffont.frag.h"
+#include "shaders/multitexture.vert.h"
+#include "shaders/multitexture.frag.h"
 
 const int RENDER_RESERVE_BATCH = 1000; // Count of polygons for which allocated memory when renderer initializing
-const int RENDER_ELEMENT_PER_VERTEX = 8; // Count of array elements for each vertex
+const int RENDER_MAX_BATCH_QUADS = 4096; // Max count of quads in one batch. Limited by size of static quad index buffer
+const int RENDER_CIRCLE_SEGMENTS = 36; // Count of lines in circle outline
 
 namespace luna2d{
 
@@ -48,13 +56,50 @@ class LUNARenderer
 {
 public:
 	LUNARenderer();
+	~LUNARenderer();
 
 private:
+	// Format of vertexes in batches and vertex arrays
+	LUNAVertexFormat vertexFormat;
+
+	// Format of vertex arrays with texture coordinates which cannot be stored in "vertexFormat"
+	// SEE: "LUNAVertexFormat::CanStoreTexCoords"
+	LUNAVertexFormat floatTexCoordsFormat;
+
+	// Format of vertexes in current batch
+	const LUNAVertexFormat* batchFormat = &vertexFormat;
+
 	// Vertex array for batching
-	std::vector<float> vertexBatch;
+	std::vector<unsigned char> vertexBatch;
+
+	// Vertex array for batching lines. Lines are rendered over current batch
+	std::vector<unsigned char> lineBatch;
+
+	// Ring of vertex buffers for streaming batches to GPU
+	LUNAStreamBuffer streamBuffer;
+
+	// Static indexes for rendering quads batches
+	std::vector<GLushort> quadIndexes;
+	GLuint quadIndexBuffer = 0;
+
+	LUNABatchMode batchMode = LUNABatchMode::QUADS;
+
+	// Queue of draw calls for deferred render mode
+	LUNARenderQueue renderQueue;
+
+	// Layer for draw calls in deferred render mode
+	int layer = 0;
 
 	// Default shader
-	std::shared_ptr<LUNAShader> defaultShader, primitivesShader, fontShader;
+	std::shared_ptr<LUNAShader> defaultShader, primitivesShader, fontShader, sdfFontShader;
+
+	// Multi-texture batching. Materials with default shader are rendered with "multiTextureShader"
+	// and textures bound to separate units. Enabled by "multiTexture" config value
+	std::shared_ptr<LUNAShader> multiTextureShader;
+	std::vector<std::shared_ptr<LUNATexture>> batchTextures; // Textures of current batch. Index is texture unit
+	int maxBatchTextures = 1;
+	int curTextureIndex = 0; // Texture index for vertexes added to current batch
+	bool multiTextureBatch = false;
 
 	// Background color
 	LUNAColor backColor = LUNAColor::WHITE;
@@ -65,37 +110,125 @@ private:
 	// Material for current render call
 	const LUNAMaterial* curMaterial = nullptr;
 
+	// Stack of clip rects in world coordinates. Each rect is intersected with previous ones
+	std::vector<LUNARect> clipStack;
+
+	// Applied scissor test in world coordinates
+	LUNARect scissorRect;
+	bool scissorEnabled = false;
+
 	// Frame buffer
 	std::shared_ptr<LUNAFrameBuffer> frameBuffer;
 
 	// Info for stats
 	int renderCalls = 0; // Count of render calls on current frame
 	int renderedVertexes = 0; // Count of rendered vertexes on current frame
+	int uploadedBytes = 0; // Count of vertex data bytes uploaded on current frame
+	int mergedDraws = 0; // Count of deferred draw calls merged into batches on current frame
+	int culledObjects = 0; // Count of objects skipped by camera culling on current frame
 
 	bool inProgress = false;
 	bool debugRender = false;
+	bool vertexBuffers = true;
+	bool deferred = false;
+	bool culling = true;
 
 private:
+	void InitQuadIndexes();
+	void CreateQuadIndexBuffer();
+	void InitMultiTexture();
+
+	// Make source of multi-texture fragment shader for supported count of texture units
+	std::string MakeMultiTextureFragShader();
+
+	// Get index of texture unit for given texture in current multi-texture batch
+	// Returns -1 if texture isn't in batch and all units are used
+	int GetBatchTextureIndex(const std::shared_ptr<LUNATexture>& texture);
+
+	// Flush current batch if it cannot be continued with given material, mode and vertex format
+	// or cannot fit "vertexSize" bytes of new vertexes
+	void PrepareBatch(const LUNAMaterial* material, LUNABatchMode mode, size_t vertexSize, bool floatTexCoords = false);
+
 	void SetVertex(float u, float v, float x, float y, const LUNAColor& color);
 
+	// Append vertexes in renderer vertex format to current batch
+	void AppendVertexes(const unsigned char* vertexes, size_t size);
+
+	// Upload given vertexes to next stream buffer if vertex buffers enabled
+	// Returns pointer to vertex data for setting shader attributes
+	const GLvoid* UploadVertexes(const std::vector<unsigned char>& vertexes);
+
+	void SetBlendingMode(LUNABlendingMode blending);
+
+	// Set scissor test to given rect or disable it if rect is nullptr
+	void ApplyScissor(const LUNARect* rect);
+
+	// Update scissor test for rendering geometry with given bounds
+	// Scissor test is changed only when it would cut geometry incorrectly
+	void UpdateScissor(const LUNARect& bounds);
+
+	// Trim axis-aligned quad by top clip rect with adjusting texture coordinates
+	// Returns false if quad isn't axis-aligned and cannot be trimmed
+	bool TrimQuad(float& x1, float& y1, float& u1, float& v1,
+		float& x2, float& y2, float& u2, float& v2,
+		float& x3, float& y3, float& u3, float& v3,
+		float& x4, float& y4, float& u4, float& v4);
+
+	// Get bounding box of vertexes in given format
+	LUNARect GetVertexesBounds(const std::vector<unsigned char>& vertexes, const LUNAVertexFormat& format);
+
+	// Render current batch
+	void RenderBatch();
+
+	// Render quads from retained vertex buffer without merging them to current batch
+	void RenderBuffer(GLuint buffer, size_t vertexSize, const LUNAMaterial* material);
+
+	// Sort recorded draw calls and render them with fewest batches
+	void FlushQueue();
+
+	// Render all batched lines with one draw call
+	void RenderLines();
+
 public:
 	bool IsInProgress();
 
 	int GetRenderCalls();
 	int GetRenderedVertexes();
+	int GetUploadedBytes();
+	int GetMergedDraws();
+	int GetCulledObjects();
+	int GetIssuedStateCalls(); // Count of GL state calls passed to GL on current frame
+	int GetSkippedStateCalls(); // Count of redundant GL state calls skipped on current frame
+
+	const LUNAVertexFormat& GetVertexFormat();
+
+	// Get format for vertex arrays with texture coordinates out of range supported by renderer vertex format
+	// SEE: "LUNARenderer::RenderVertexArray"
+	const LUNAVertexFormat& GetFloatTexCoordsFormat();
 
 	std::shared_ptr<LUNAShader> GetDefaultShader();
 	std::shared_ptr<LUNAShader> GetPrimitvesShader();
 	std::shared_ptr<LUNAShader> GetFontShader();
+	std::shared_ptr<LUNAShader> GetSdfFontShader(); // Shader for signed distance field fonts
 
 	LUNAColor GetBackgroundColor();
 	void SetBackgroundColor(const LUNAColor& backColor);
 
 	void SetCamera(const std::shared_ptr<LUNACamera>& camera);
 
+	// Push clip rect in world coordinates. Rect is intersected with current clip rect
+	// Geometry fully outside clip rect is skipped, axis-aligned quads are trimmed on CPU,
+	// scissor test is used only for other geometry crossing edge of clip rect
+	void PushClipRect(float x, float y, float width, float height);
+	void PopClipRect();
+
+	// Replace all clip rects with given one
 	void EnableScissor(float x, float y, float width, float height);
+
+	// Remove all clip rects
 	void DisableScissor();
 
+	std::shared_ptr<LUNAFrameBuffer> GetFrameBuffer();
 	void SetFrameBuffer(const std::shared_ptr<LUNAFrameBuffer>& frameBuffer);
 
 	void SetDefaultViewport();
@@ -103,19 +236,74 @@ public:
 	// Read screen pixels into instance of "LUNAImage"
 	std::shared_ptr<LUNAImage> ReadPixels();
 
+	// Read screen pixels in RGB format into given buffer. Buffer is reallocated only when it's too small
+	// Rows are not flipped, so first row in buffer is bottom row of screen
+	void ReadPixels(std::vector<unsigned char>& data, int& width, int& height);
+
 	bool IsEnabledDebugRender();
 	void EnableDebugRender(bool enable);
 
+	// Stream batches through ring of vertex buffers instead of client-side vertex arrays
+	bool IsEnabledVertexBuffers();
+	void EnableVertexBuffers(bool enable);
+
+	// Record draw calls and reorder them by material at flush
+	// Draw calls with overlapping geometry keep their relative order
+	bool IsEnabledDeferredRender();
+	void EnableDeferredRender(bool enable);
+
+	// Layer for draw calls in deferred render mode. Layers are rendered in ascending order
+	// Layers can be negative, valid range is ["RENDER_QUEUE_MIN_LAYER", "RENDER_QUEUE_MAX_LAYER"]
+	// Has no effect in immediate render mode
+	int GetLayer();
+	void SetLayer(int layer);
+
+	// Skip objects outside of camera visible area before writing their vertexes
+	bool IsEnabledCulling();
+	void EnableCulling(bool enable);
+
+	// Check whether object with given bounding box should be skipped by camera culling
+	// Culled objects are counted in stats
+	bool IsCulled(const LUNARect& bounds);
+
 	void RenderQuad(float x1, float y1, float u1, float v1,
 		float x2, float y2, float u2, float v2,
 		float x3, float y3, float u3, float v3,
 		float x4, float y4, float u4, float v4,
 		const LUNAMaterial* material, const LUNAColor& color);
 
-	void RenderVertexArray(std::vector<float>& vertexes, const LUNAMaterial* material);
-
+	// Render prepared quads as single draw call entry. Vertexes should be in renderer vertex format
+	// More than "RENDER_MAX_BATCH_QUADS" quads are split to several entries. Quads aren't trimmed by clip rects,
+	// so scissor test is used when "bounds" cross edge of clip rect
+	void RenderQuads(const std::vector<unsigned char>& vertexes, const LUNARect& bounds, const LUNAMaterial* material);
+
+	// Render triangles list. Vertexes should be in renderer vertex format,
+	// or in float texture coordinates format if "floatTexCoords" is true
+	// SEE: "LUNARenderer::GetVertexFormat", "LUNARenderer::GetFloatTexCoordsFormat"
+	void RenderVertexArray(const std::vector<unsigned char>& vertexes, const LUNAMaterial* material,
+		bool floatTexCoords = false);
+
+	// Render quads from retained vertex buffer. Vertexes should be in renderer vertex format
+	// Client-side "vertexes" are used instead of "buffer" when vertex buffers are disabled
+	// In deferred render mode draw call is recorded to queue, so buffer must not be changed until queue is flushed
+	// SEE: "LUNARenderer::FlushBuffer"
+	void RenderQuadsBuffer(GLuint buffer, const std::vector<unsigned char>& vertexes, const LUNARect& bounds,
+		const LUNAMaterial* material);
+
+	// Render queued draw calls using given retained vertex buffer
+	// Should be called before changing or deleting buffer passed to "RenderQuadsBuffer"
+	void FlushBuffer(GLuint buffer);
+
+	// Lines are batched separately from other geometry and rendered at end of current batch
+	// Lines outside of clip rect are skipped, lines crossing its edge are cut by scissor test
 	void RenderLine(float x1, float y1, float x2, float y2, const LUNAColor& color);
 
+	// Render lines connecting given points. If "closed" is true, last point is connected with first one
+	void RenderPolyline(const std::vector<glm::vec2>& points, const LUNAColor& color, bool closed);
+
+	void RenderRectangle(float x, float y, float width, float height, const LUNAColor& color);
+	void RenderCircle(float x, float y, float radius, const LUNAColor& color);
+
 	void BeginRender();
 	void Render();
 	void EndRender();
@@ -126,9 +314,14 @@ public:
 public:
 	inline void ReloadDefaultShaders()
 	{
+		glstate::Reset();
 		defaultShader->Reload(DEFAULT_VERT_SHADER, DEFAULT_FRAG_SHADER);
 		primitivesShader->Reload(PRIMITIVES_VERT_SHADER, PRIMITIVES_FRAG_SHADER);
 		fontShader->Reload(FONT_VERT_SHADER, FONT_FRAG_SHADER);
+		sdfFontShader->Reload(FONT_VERT_SHADER, SDF_FONT_FRAG_SHADER);
+		if(multiTextureShader) multiTextureShader->Reload(MULTITEXTURE_VERT_SHADER, MakeMultiTextureFragShader());
+		streamBuffer.Reload();
+		CreateQuadIndexBuffer();
 	}
 #endif
 };
@@ -0,0 +1,267 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunarenderqueue.h"
+#include "lunaintersect.h"
+
+using namespace luna2d;
+
+const uint64_t ORDER_MASK = RENDER_QUEUE_MAX_COMMANDS - 1;
+const int MAX_CHECKED_COMMANDS = 64; // Max count of commands checked for overlapping when adding command
+
+LUNARenderCommand::LUNARenderCommand(const LUNAMaterial& material, LUNABatchMode mode, const LUNARect& bounds,
+	size_t vertexOffset, size_t vertexSize, int materialId, GLuint buffer, bool floatTexCoords) :
+	material(material),
+	mode(mode),
+	bounds(bounds),
+	vertexOffset(vertexOffset),
+	vertexSize(vertexSize),
+	materialId(materialId),
+	buffer(buffer),
+	floatTexCoords(floatTexCoords)
+{
+}
+
+// Make rectangle covering both given rectangles
+static LUNARect UniteRects(const LUNARect& rect1, const LUNARect& rect2)
+{
+	float left = std::min(rect1.x, rect2.x);
+	float bottom = std::min(rect1.y, rect2.y);
+	float right = std::max(rect1.x + rect1.width, rect2.x + rect2.width);
+	float top = std::max(rect1.y + rect1.height, rect2.y + rect2.height);
+
+	return LUNARect(left, bottom, right - left, top - bottom);
+}
+
+int LUNARenderQueue::GetShaderId(const LUNAShader* shader)
+{
+	auto it = shaderIds.find(shader);
+	if(it != shaderIds.end()) return it->second;
+
+	int id = shaderIds.size();
+	shaderIds[shader] = id;
+	return id;
+}
+
+int LUNARenderQueue::GetTextureId(const LUNATexture* texture)
+{
+	auto it = textureIds.find(texture);
+	if(it != textureIds.end()) return it->second;
+
+	int id = textureIds.size();
+	textureIds[texture] = id;
+	return id;
+}
+
+// Get level for command with given bounds and material on given layer
+// Count of checked commands is limited, when limit is reached command is conservatively placed
+// above currently checked level
+int LUNARenderQueue::FindLevel(std::vector<Level>& levels, const LUNARect& bounds, int materialId)
+{
+	int checkedCommands = 0;
+
+	// Only highest level with overlapping commands matters:
+	// lower levels cannot push command above it
+	for(int i = levels.size() - 1; i >= 0; i--)
+	{
+		const Level& level = levels[i];
+		if(!intersect::Rectangles(level.bounds, bounds)) continue;
+
+		// Command can be merged to level with same material without checking commands,
+		// because no levels above have overlapping commands
+		if(level.materialId == materialId) return i;
+
+		bool overlaps = false;
+		for(size_t index : level.commands)
+		{
+			if(++checkedCommands > MAX_CHECKED_COMMANDS) return i + 1;
+
+			const LUNARenderCommand& command = commands[index];
+			if(!intersect::Rectangles(command.bounds, bounds)) continue;
+
+			// Overlapped command with different material must be rendered before
+			if(command.materialId != materialId) return i + 1;
+			overlaps = true;
+		}
+
+		// Overlapped commands with same material will be merged to same batch in submission order
+		if(overlaps) return i;
+	}
+
+	return 0;
+}
+
+bool LUNARenderQueue::IsEmpty()
+{
+	return commands.empty();
+}
+
+// Check for queue cannot accept new commands and should be flushed
+bool LUNARenderQueue::IsFull()
+{
+	return commands.size() >= RENDER_QUEUE_MAX_COMMANDS ||
+		shaderIds.size() >= RENDER_QUEUE_MAX_SHADERS ||
+		textureIds.size() >= RENDER_QUEUE_MAX_TEXTURES ||
+		maxLevels >= RENDER_QUEUE_MAX_LEVELS;
+}
+
+size_t LUNARenderQueue::GetCount()
+{
+	return commands.size();
+}
+
+// Make command and its sort key
+void LUNARenderQueue::AddCommand(const LUNAMaterial& material, LUNABatchMode mode, int layer, const LUNARect& bounds,
+	size_t vertexSize, GLuint buffer, bool floatTexCoords)
+{
+	uint64_t shaderId = GetShaderId(material.shader.lock().get());
+	uint64_t textureId = GetTextureId(material.texture.lock().get());
+	uint64_t blending = static_cast<uint64_t>(material.blending);
+	uint64_t batchMode = mode == LUNABatchMode::QUADS ? 0 : 1;
+	uint64_t retainedBuffer = buffer != 0 ? 1 : 0;
+
+	// Commands with retained buffers cannot be merged with other commands
+	// Commands with different vertex formats cannot be merged together. Vertex format isn't stored in sort key,
+	// so such commands are only separated by levels where they overlap
+	int materialId = (((((((shaderId * RENDER_QUEUE_MAX_TEXTURES + textureId) << 2 | blending) << 1) | batchMode) << 1) |
+		retainedBuffer) << 1) | (floatTexCoords ? 1 : 0);
+
+	std::vector<Level>& levels = layerLevels[layer];
+	size_t level = FindLevel(levels, bounds, materialId);
+	size_t index = commands.size();
+
+	if(level == levels.size())
+	{
+		levels.push_back(Level());
+		levels[level].bounds = bounds;
+		levels[level].materialId = materialId;
+		maxLevels = std::max(maxLevels, levels.size());
+	}
+	else
+	{
+		levels[level].bounds = UniteRects(levels[level].bounds, bounds);
+		if(levels[level].materialId != materialId) levels[level].materialId = -1;
+	}
+	levels[level].commands.push_back(index);
+
+	uint64_t key = static_cast<uint64_t>(layer - RENDER_QUEUE_MIN_LAYER) << 56;
+	key |= static_cast<uint64_t>(level) << 44;
+	key |= shaderId << 36;
+	key |= textureId << 24;
+	key |= blending << 22;
+	key |= batchMode << 21;
+	key |= retainedBuffer << 20;
+	key |= index;
+	keys.push_back(key);
+
+	commands.emplace_back(material, mode, bounds, vertexes.size(), vertexSize, materialId, buffer, floatTexCoords);
+}
+
+// Add command to queue. Layer should be in range ["RENDER_QUEUE_MIN_LAYER", "RENDER_QUEUE_MAX_LAYER"]
+// Returns pointer to reserved vertex data for command
+unsigned char* LUNARenderQueue::Add(const LUNAMaterial& material, LUNABatchMode mode, int layer, const LUNARect& bounds,
+	size_t vertexSize, bool floatTexCoords)
+{
+	size_t vertexOffset = vertexes.size();
+	AddCommand(material, mode, layer, bounds, vertexSize, 0, floatTexCoords);
+
+	vertexes.resize(vertexOffset + vertexSize);
+	return &vertexes[vertexOffset];
+}
+
+// Add command rendering quads from retained vertex buffer. Buffer must not be changed until queue is cleared
+void LUNARenderQueue::AddBuffer(const LUNAMaterial& material, int layer, const LUNARect& bounds, GLuint buffer,
+	size_t vertexSize)
+{
+	AddCommand(material, LUNABatchMode::QUADS, layer, bounds, vertexSize, buffer, false);
+	if(!HasBuffer(buffer)) buffers.push_back(buffer);
+}
+
+// Check for commands in queue use given retained vertex buffer
+bool LUNARenderQueue::HasBuffer(GLuint buffer)
+{
+	return std::find(buffers.begin(), buffers.end(), buffer) != buffers.end();
+}
+
+// Sort commands by keys using LSD radix sort by bytes of key
+// Bytes which are same in all keys are skipped. Should be called before iterating commands
+void LUNARenderQueue::Sort()
+{
+	if(keys.size() < 2) return;
+
+	// Find bits which differ between keys
+	uint64_t andBits = ~0ull;
+	uint64_t orBits = 0;
+	for(uint64_t key : keys)
+	{
+		andBits &= key;
+		orBits |= key;
+	}
+	uint64_t diffBits = andBits ^ orBits;
+
+	sortBuffer.resize(keys.size());
+
+	for(int shift = 0; shift < 64; shift += 8)
+	{
+		if(((diffBits >> shift) & 0xFF) == 0) continue;
+
+		size_t offsets[256] = {};
+		for(uint64_t key : keys) offsets[(key >> shift) & 0xFF]++;
+
+		size_t sum = 0;
+		for(size_t& offset : offsets)
+		{
+			size_t count = offset;
+			offset = sum;
+			sum += count;
+		}
+
+		// Counting sort keeps order of keys with same byte, so previous passes remain valid
+		for(uint64_t key : keys) sortBuffer[offsets[(key >> shift) & 0xFF]++] = key;
+		keys.swap(sortBuffer);
+	}
+}
+
+// Get command by index in sorted order
+const LUNARenderCommand& LUNARenderQueue::GetCommand(size_t index)
+{
+	return commands[keys[index] & ORDER_MASK];
+}
+
+// Get vertex data of given command
+const unsigned char* LUNARenderQueue::GetVertexes(const LUNARenderCommand& command)
+{
+	return &vertexes[command.vertexOffset];
+}
+
+void LUNARenderQueue::Clear()
+{
+	commands.clear();
+	keys.clear();
+	vertexes.clear();
+	shaderIds.clear();
+	textureIds.clear();
+	layerLevels.clear();
+	buffers.clear();
+	maxLevels = 0;
+}
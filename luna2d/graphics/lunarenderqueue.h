@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunamaterial.h"
+#include "lunarect.h"
+
+namespace luna2d{
+
+// Primitives layout of vertexes in batch
+enum class LUNABatchMode
+{
+	QUADS, // Indexed quads, 4 vertexes per quad
+	TRIANGLES, // Triangles list, 3 vertexes per triangle
+};
+
+// Layout of render command sort key (from most significant bits):
+// layer(8) | level(12) | shader(8) | texture(12) | blending(2) | batch mode(1) | retained buffer(1) | submission order(20)
+// Layers are signed, layer is biased by "RENDER_QUEUE_MIN_LAYER" in key
+const int RENDER_QUEUE_MIN_LAYER = -(1 << 7);
+const int RENDER_QUEUE_MAX_LAYER = (1 << 7) - 1;
+const int RENDER_QUEUE_MAX_LEVELS = 1 << 12;
+const int RENDER_QUEUE_MAX_SHADERS = 1 << 8;
+const int RENDER_QUEUE_MAX_TEXTURES = 1 << 12;
+const int RENDER_QUEUE_MAX_COMMANDS = 1 << 20;
+
+//--------------------------------------------
+// Deferred draw call recorded by render queue
+//--------------------------------------------
+struct LUNARenderCommand
+{
+	LUNARenderCommand(const LUNAMaterial& material, LUNABatchMode mode, const LUNARect& bounds,
+		size_t vertexOffset, size_t vertexSize, int materialId, GLuint buffer, bool floatTexCoords);
+
+	LUNAMaterial material;
+	LUNABatchMode mode;
+	LUNARect bounds; // Bounding box of command geometry
+	size_t vertexOffset; // Offset of command vertexes in queue vertex data (in bytes)
+	size_t vertexSize; // Size of command vertexes (in bytes)
+	int materialId; // Unique id of material, batch mode, retained buffer and vertex format flags combination
+	GLuint buffer; // Retained vertex buffer with command vertexes, or 0 if vertexes are stored in queue
+	bool floatTexCoords; // Vertexes are in float texture coordinates format. SEE: "LUNARenderer::GetFloatTexCoordsFormat"
+};
+
+//---------------------------------------------------------------------
+// Queue of draw calls sorted by material to minimize batch breaks.
+// Commands are ordered by "level": command is placed on level above
+// all earlier overlapping commands with different material, so
+// painter's order is kept wherever geometry overlaps
+//---------------------------------------------------------------------
+class LUNARenderQueue
+{
+private:
+	struct Level
+	{
+		LUNARect bounds; // Union of bounds of all commands on level
+		int materialId; // Material id of all commands on level, or -1 if level has different materials
+		std::vector<size_t> commands;
+	};
+
+private:
+	std::vector<LUNARenderCommand> commands;
+	std::vector<uint64_t> keys;
+	std::vector<uint64_t> sortBuffer; // Temporary buffer for radix sort
+	std::vector<unsigned char> vertexes;
+	std::unordered_map<const LUNAShader*, int> shaderIds;
+	std::unordered_map<const LUNATexture*, int> textureIds;
+	std::unordered_map<int, std::vector<Level>> layerLevels;
+	std::vector<GLuint> buffers; // Retained vertex buffers used by commands
+	size_t maxLevels = 0;
+
+private:
+	int GetShaderId(const LUNAShader* shader);
+	int GetTextureId(const LUNATexture* texture);
+
+	// Get level for command with given bounds and material on given layer
+	// Count of checked commands is limited, when limit is reached command is conservatively placed
+	// above currently checked level
+	int FindLevel(std::vector<Level>& levels, const LUNARect& bounds, int materialId);
+
+	// Make command and its sort key
+	void AddCommand(const LUNAMaterial& material, LUNABatchMode mode, int layer, const LUNARect& bounds,
+		size_t vertexSize, GLuint buffer, bool floatTexCoords);
+
+public:
+	bool IsEmpty();
+
+	// Check for queue cannot accept new commands and should be flushed
+	bool IsFull();
+
+	size_t GetCount();
+
+	// Add command to queue. Layer should be in range ["RENDER_QUEUE_MIN_LAYER", "RENDER_QUEUE_MAX_LAYER"]
+	// Returns pointer to reserved vertex data for command
+	unsigned char* Add(const LUNAMaterial& material, LUNABatchMode mode, int layer, const LUNARect& bounds,
+		size_t vertexSize, bool floatTexCoords = false);
+
+	// Add command rendering quads from retained vertex buffer. Buffer must not be changed until queue is cleared
+	void AddBuffer(const LUNAMaterial& material, int layer, const LUNARect& bounds, GLuint buffer, size_t vertexSize);
+
+	// Check for commands in queue use given retained vertex buffer
+	bool HasBuffer(GLuint buffer);
+
+	// Sort commands by keys using LSD radix sort by bytes of key
+	// Bytes which are same in all keys are skipped. Should be called before iterating commands
+	void Sort();
+
+	// Get command by index in sorted order
+	const LUNARenderCommand& GetCommand(size_t index);
+
+	// Get vertex data of given command
+	const unsigned char* GetVertexes(const LUNARenderCommand& command);
+
+	void Clear();
+};
+
+}
@@ -0,0 +1,144 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunascreenshots.h"
+#include "lunagraphics.h"
+#include "lunafiles.h"
+#include "lunapngformat.h"
+#include "lunajpegformat.h"
+
+using namespace luna2d;
+
+LUNAScreenshots::~LUNAScreenshots()
+{
+	if(!worker.joinable()) return;
+
+	// Worker finishes pending tasks before stopping
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopWorker = true;
+	}
+	condition.notify_one();
+	worker.join();
+}
+
+void LUNAScreenshots::RunWorker()
+{
+	while(true)
+	{
+		Task task;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this]() { return stopWorker || !pendingTasks.empty(); });
+
+			if(pendingTasks.empty()) return;
+
+			task = std::move(pendingTasks.front());
+			pendingTasks.pop_front();
+		}
+
+		std::string ext = LUNAEngine::SharedFiles()->GetExtension(task.filename);
+		std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+		// Rows read from OpenGL are flipped during encoding
+		std::vector<unsigned char> fileData;
+		bool encoded = (ext == "jpg" || ext == "jpeg") ?
+			LUNAJpegFormat().Encode(task.data, fileData, task.width, task.height, LUNAColorType::RGB, true) :
+			LUNAPngFormat().Encode(task.data, fileData, task.width, task.height, LUNAColorType::RGB, true);
+
+		task.success = encoded && LUNAEngine::SharedFiles()->WriteFile(task.filename, fileData, LUNAFileLocation::APP_FOLDER);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		completedTasks.push_back(std::move(task));
+	}
+}
+
+// Capture current framebuffer and push encoding task to worker
+void LUNAScreenshots::Capture(int id, const std::string& filename)
+{
+	Task task;
+	task.id = id;
+	task.filename = filename;
+	task.success = false;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(!freeBuffers.empty())
+		{
+			task.data = std::move(freeBuffers.back());
+			freeBuffers.pop_back();
+		}
+	}
+
+	LUNAEngine::SharedGraphics()->GetRenderer()->ReadPixels(task.data, task.width, task.height);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pendingTasks.push_back(std::move(task));
+	}
+
+	if(!worker.joinable()) worker = std::thread(&LUNAScreenshots::RunWorker, this);
+	condition.notify_one();
+}
+
+// Take screenshot after current frame will be rendered and save it to application folder
+// Image format is selected by file extension: "jpg"/"jpeg" or png for others
+void LUNAScreenshots::Take(const std::string& filename, const std::function<void(bool)>& callback)
+{
+	int id = nextId++;
+	if(callback) callbacks[id] = callback;
+
+	// Take screenshot when current frame will be completely rendered
+	LUNAEngine::SharedGraphics()->RunAfterRender([this, id, filename]()
+	{
+		Capture(id, filename);
+	});
+}
+
+// Call callbacks of completed screenshots. Should be called on main thread
+void LUNAScreenshots::ProcessCompleted()
+{
+	std::vector<Task> tasks;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(completedTasks.empty()) return;
+
+		tasks.swap(completedTasks);
+		// Keep only one buffer, screenshots are rarely taken in series
+		if(freeBuffers.empty()) freeBuffers.push_back(std::move(tasks[0].data));
+	}
+
+	for(const auto& task : tasks)
+	{
+		if(!task.success) LUNA_LOGE("Cannot save screenshot \"%s\"", task.filename.c_str());
+
+		auto it = callbacks.find(task.id);
+		if(it == callbacks.end()) continue;
+
+		auto callback = it->second;
+		callbacks.erase(it);
+		callback(task.success);
+	}
+}
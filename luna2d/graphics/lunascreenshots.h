@@ -0,0 +1,82 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunaengine.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace luna2d{
+
+//-----------------------------------------------------------------
+// Asynchronous screenshots capture. Pixels are read on main thread
+// into reusable buffer, encoding and writing file are performed on
+// worker thread. Completion callbacks are called on main thread
+//-----------------------------------------------------------------
+class LUNAScreenshots
+{
+public:
+	~LUNAScreenshots();
+
+private:
+	struct Task
+	{
+		int id;
+		std::string filename;
+		std::vector<unsigned char> data; // Bottom-up RGB pixels
+		int width, height;
+		bool success;
+	};
+
+private:
+	std::thread worker;
+	std::mutex mutex;
+	std::condition_variable condition;
+	std::deque<Task> pendingTasks; // Tasks waiting for encoding
+	std::vector<Task> completedTasks; // Tasks waiting for calling callback on main thread
+	std::vector<std::vector<unsigned char>> freeBuffers; // Pixel buffers of completed tasks for reusing
+	bool stopWorker = false;
+
+	// Callbacks are kept on main thread only
+	std::unordered_map<int, std::function<void(bool)>> callbacks;
+	int nextId = 0;
+
+private:
+	void RunWorker();
+
+	// Capture current framebuffer and push encoding task to worker
+	void Capture(int id, const std::string& filename);
+
+public:
+	// Take screenshot after current frame will be rendered and save it to application folder
+	// Image format is selected by file extension: "jpg"/"jpeg" or png for others
+	void Take(const std::string& filename, const std::function<void(bool)>& callback);
+
+	// Call callbacks of completed screenshots. Should be called on main thread
+	void ProcessCompleted();
+};
+
+}
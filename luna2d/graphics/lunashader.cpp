@@ -23,7 +23,9 @@
 
 #include "lunashader.h"
 #include "lunaplatform.h"
-#include "lunarenderer.h"
+#include "lunagraphics.h"
+#include "lunaglstate.h"
+#include "lunaprogramcache.h"
 
 using namespace luna2d;
 
@@ -41,6 +43,30 @@ precision mediump float;
 #endif
 )";
 
+// Get position after "#version" and "#extension" directives at beginning of shader source
+// Other directives aren't skipped, because they can depend on default directives (e.g. "#ifdef GL_ES")
+static size_t FindLeadingDirectivesEnd(const std::string& source)
+{
+	size_t pos = 0;
+
+	while(pos < source.size())
+	{
+		size_t lineStart = source.find_first_not_of(" \t\r\n", pos);
+		if(lineStart == std::string::npos || source[lineStart] != '#') break;
+
+		size_t nameStart = source.find_first_not_of(" \t", lineStart + 1);
+		if(nameStart == std::string::npos) break;
+		if(source.compare(nameStart, 7, "version") != 0 && source.compare(nameStart, 9, "extension") != 0) break;
+
+		size_t lineEnd = source.find('\n', lineStart);
+		if(lineEnd == std::string::npos) return source.size();
+
+		pos = lineEnd + 1;
+	}
+
+	return pos;
+}
+
 LUNAShader::LUNAShader(const std::string& vertexSource, const std::string& fragmentSource)
 {
 	CreateGlProgram(vertexSource, fragmentSource);
@@ -52,11 +78,19 @@ LUNAShader::~LUNAShader()
 	if(!program) return;
 
 	Unbind();
-	glDetachShader(program, vertexShader);
-	glDeleteShader(vertexShader);
-	glDetachShader(program, fragmentShader);
-	glDeleteShader(fragmentShader);
-	glDeleteProgram(program);
+
+	// Program loaded from binary cache hasn't attached shaders
+	if(vertexShader)
+	{
+		glDetachShader(program, vertexShader);
+		glDeleteShader(vertexShader);
+	}
+	if(fragmentShader)
+	{
+		glDetachShader(program, fragmentShader);
+		glDeleteShader(fragmentShader);
+	}
+	glstate::DeleteProgram(program);
 }
 
 // Load and compile shader
@@ -98,10 +132,22 @@ GLuint LUNAShader::LoadShader(GLenum shaderType, const std::string& source)
 // Link vertex and fragment shaders into shader program
 void LUNAShader::CreateGlProgram(const std::string& vertexSource, const std::string& fragmentSource)
 {
-	vertexShader = LoadShader(GL_VERTEX_SHADER, PreprocessVertex(vertexSource));
+	std::string preprocessedVertex = PreprocessVertex(vertexSource);
+	std::string preprocessedFragment = PreprocessFragment(fragmentSource);
+
+	// Try to skip compiling by loading program binary from cache
+	program = programcache::LoadProgram(preprocessedVertex, preprocessedFragment);
+	if(program)
+	{
+		vertexShader = 0;
+		fragmentShader = 0;
+		return;
+	}
+
+	vertexShader = LoadShader(GL_VERTEX_SHADER, preprocessedVertex);
 	if(!vertexShader) return;
 
-	fragmentShader = LoadShader(GL_FRAGMENT_SHADER, PreprocessFragment(fragmentSource));
+	fragmentShader = LoadShader(GL_FRAGMENT_SHADER, preprocessedFragment);
 	if(!fragmentShader) return;
 
 	program = glCreateProgram();
@@ -128,11 +174,12 @@ void LUNAShader::CreateGlProgram(const std::string& vertexSource, const std::str
 				LUNA_LOGE("Could not link program:\n%s", info.c_str());
 			}
 
-			glDeleteProgram(program);
+			glstate::DeleteProgram(program);
 			vertexShader = 0;
 			fragmentShader = 0;
 			program = 0;
 		}
+		else programcache::SaveProgram(program, preprocessedVertex, preprocessedFragment);
 	}
 }
 
@@ -146,18 +193,117 @@ void LUNAShader::FetchDefaultAttributes()
 	a_texCoords = glGetAttribLocation(program, "a_texCoords");
 	u_transformMatrix = glGetUniformLocation(program, "u_transformMatrix");
 	u_texture = glGetUniformLocation(program, "u_texture");
+	a_textureIndex = glGetAttribLocation(program, "a_textureIndex");
+	u_textures = glGetUniformLocation(program, "u_textures");
+
+	// Uniform values are stored in program, so cached values are invalid for new program
+	hasTransformMatrix = false;
+	transformMatrixVersion = 0;
+	textureUnit = -1;
+	textureUnitsCount = -1;
+
+	// Custom uniform values are kept and uploaded again to new program
+	for(auto& entry : uniforms)
+	{
+		entry.second.location = glGetUniformLocation(program, entry.first.c_str());
+		entry.second.dirty = true;
+	}
+	hasDirtyUniforms = !uniforms.empty();
 }
 
 // Add default preprocessor directives to vertex shader source
+// "#version" and "#extension" directives at beginning of source are kept before default directives,
+// because they should precede any code
 std::string LUNAShader::PreprocessVertex(const std::string& source)
 {
-	return GLES_PRECISIONS + source;
+	size_t directivesEnd = FindLeadingDirectivesEnd(source);
+	return source.substr(0, directivesEnd) + GLES_PRECISIONS + source.substr(directivesEnd);
 }
 
 // Add default preprocessor directives to fragment shader source
+// "#version" and "#extension" directives at beginning of source are kept before default directives,
+// because they should precede any code
 std::string LUNAShader::PreprocessFragment(const std::string& source)
 {
-	return GLES_DEFAULT_PRECISION + GLES_PRECISIONS + source;
+	size_t directivesEnd = FindLeadingDirectivesEnd(source);
+	return source.substr(0, directivesEnd) + GLES_DEFAULT_PRECISION + GLES_PRECISIONS + source.substr(directivesEnd);
+}
+
+// Update shadow copy of custom uniform. Pending render is flushed only when value is changed
+void LUNAShader::SetUniformValues(const std::string& name, UniformType type, const float* values, int count)
+{
+	auto it = uniforms.find(name);
+
+	if(it == uniforms.end())
+	{
+		Uniform uniform;
+		uniform.location = IsValid() ? glGetUniformLocation(program, name.c_str()) : -1;
+		uniform.type = type;
+		if(uniform.location == -1) LUNA_LOGW("Uniform \"%s\" not found in shader", name.c_str());
+
+		it = uniforms.emplace(name, uniform).first;
+		if(type == UniformType::SAMPLER) samplersCount++;
+	}
+	else
+	{
+		if(it->second.type != type) LUNA_RETURN_ERR("Type of uniform \"%s\" differs from previously set type", name.c_str());
+		if(!it->second.dirty && std::equal(values, values + count, it->second.values)) return;
+	}
+
+	// Geometry batched before change should be rendered with previous value
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	if(renderer->IsInProgress()) renderer->Render();
+
+	std::copy(values, values + count, it->second.values);
+	it->second.dirty = true;
+	hasDirtyUniforms = true;
+}
+
+// Upload changed custom uniforms and bind sampler textures
+void LUNAShader::ApplyUniforms()
+{
+	if(!hasDirtyUniforms && samplersCount == 0) return;
+
+	for(auto& entry : uniforms)
+	{
+		Uniform& uniform = entry.second;
+
+		// Texture units can be rebound by other shaders, so sampler textures are bound every time
+		if(uniform.type == UniformType::SAMPLER)
+		{
+			auto texture = uniform.texture.lock();
+			if(texture) texture->Bind((int)uniform.values[0]);
+		}
+
+		if(!uniform.dirty) continue;
+		uniform.dirty = false;
+
+		if(uniform.location == -1) continue;
+
+		switch(uniform.type)
+		{
+		case UniformType::FLOAT:
+			glUniform1fv(uniform.location, 1, uniform.values);
+			break;
+		case UniformType::VEC2:
+			glUniform2fv(uniform.location, 1, uniform.values);
+			break;
+		case UniformType::VEC3:
+			glUniform3fv(uniform.location, 1, uniform.values);
+			break;
+		case UniformType::VEC4:
+			glUniform4fv(uniform.location, 1, uniform.values);
+			break;
+		case UniformType::MAT4:
+			glUniformMatrix4fv(uniform.location, 1, GL_FALSE, uniform.values);
+			break;
+		case UniformType::SAMPLER:
+			glUniform1i(uniform.location, (GLint)uniform.values[0]);
+			break;
+		}
+	}
+
+	hasDirtyUniforms = false;
 }
 
 bool LUNAShader::IsValid()
@@ -175,48 +321,148 @@ bool LUNAShader::HasTexture()
 	return u_texture != -1 && a_texCoords != -1;
 }
 
+bool LUNAShader::HasTextureIndex()
+{
+	return u_textures != -1 && a_textureIndex != -1;
+}
+
 void LUNAShader::Bind()
 {
-	glUseProgram(program);
+	glstate::UseProgram(program);
+	ApplyUniforms();
 }
 
 void LUNAShader::Unbind()
 {
-	glUseProgram(0);
+	glstate::UseProgram(0);
 }
 
-void LUNAShader::SetPositionAttribute(const std::vector<float>& vertexArray)
+// Set vertex attributes pointers. "vertexData" is pointer to first vertex in client memory
+// or offset in bound "GL_ARRAY_BUFFER" when vertexes streamed through vertex buffer
+void LUNAShader::SetPositionAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format)
 {
-	glEnableVertexAttribArray(a_position);
-	glVertexAttribPointer(a_position, 2, GL_FLOAT, GL_FALSE, RENDER_ELEMENT_PER_VERTEX * sizeof(float), &vertexArray[0]);
+	if(a_position == -1) return;
+
+	glstate::EnableVertexAttrib(a_position);
+	glVertexAttribPointer(a_position, 2, GL_FLOAT, GL_FALSE, format.GetStride(), vertexData);
 }
 
-void LUNAShader::SetColorAttribute(const std::vector<float>& vertexArray)
+void LUNAShader::SetColorAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format)
 {
 	if(!HasColorAttribute()) return;
 
-	glEnableVertexAttribArray(a_color);
-	glVertexAttribPointer(a_color, 4, GL_FLOAT, GL_FALSE, RENDER_ELEMENT_PER_VERTEX * sizeof(float), &vertexArray[0] + 2);
+	glstate::EnableVertexAttrib(a_color);
+	glVertexAttribPointer(a_color, 4, format.GetColorGlType(), format.IsColorNormalized() ? GL_TRUE : GL_FALSE,
+		format.GetStride(), static_cast<const char*>(vertexData) + format.GetColorOffset());
 }
 
-void LUNAShader::SetTexCoordsAttribute(const std::vector<float>& vertexArray)
+void LUNAShader::SetTexCoordsAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format)
 {
 	if(!HasTexture()) return;
 
-	glEnableVertexAttribArray(a_texCoords);
-	glVertexAttribPointer(a_texCoords, 2, GL_FLOAT, GL_FALSE, RENDER_ELEMENT_PER_VERTEX * sizeof(float), &vertexArray[0] + 6);
+	glstate::EnableVertexAttrib(a_texCoords);
+	glVertexAttribPointer(a_texCoords, 2, format.GetTexCoordsGlType(), format.IsTexCoordsNormalized() ? GL_TRUE : GL_FALSE,
+		format.GetStride(), static_cast<const char*>(vertexData) + format.GetTexCoordsOffset());
+}
+
+void LUNAShader::SetTextureIndexAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format)
+{
+	if(!HasTextureIndex() || !format.HasTextureIndex()) return;
+
+	glstate::EnableVertexAttrib(a_textureIndex);
+	glVertexAttribPointer(a_textureIndex, 1, GL_UNSIGNED_BYTE, GL_FALSE,
+		format.GetStride(), static_cast<const char*>(vertexData) + format.GetTextureIndexOffset());
 }
 
+// Set uniforms of currently bound shader. Uniform values which already set to program are skipped
 void LUNAShader::SetTransformMatrix(const glm::mat4& matrix)
 {
+	if(hasTransformMatrix && transformMatrix == matrix) return;
+
 	glUniformMatrix4fv(u_transformMatrix, 1, GL_FALSE, &matrix[0][0]);
+	transformMatrix = matrix;
+	hasTransformMatrix = true;
+	transformMatrixVersion = 0;
+}
+
+// Compare only versions of matrix
+void LUNAShader::SetTransformMatrix(const glm::mat4& matrix, unsigned version)
+{
+	if(hasTransformMatrix && transformMatrixVersion == version) return;
+
+	SetTransformMatrix(matrix);
+	transformMatrixVersion = version;
 }
 
 void LUNAShader::SetTextureUniform(const LUNATexture& texture)
 {
 	if(!HasTexture()) return;
 
-	glActiveTexture(GL_TEXTURE0);
-	texture.Bind();
+	texture.Bind(0);
+
+	if(textureUnit == 0) return;
 	glUniform1i(u_texture, 0);
+	textureUnit = 0;
+}
+
+// Bind samplers array "u_textures" to texture units from 0 to given count
+void LUNAShader::SetTextureUnitsUniform(int count)
+{
+	if(!HasTextureIndex() || textureUnitsCount == count) return;
+
+	std::vector<GLint> units(count);
+	for(int i = 0; i < count; i++) units[i] = i;
+
+	glUniform1iv(u_textures, count, &units[0]);
+	textureUnitsCount = count;
+}
+
+// Set custom uniforms. Values are cached and uploaded to program only when changed
+// Can be called at any time, not only for bound shader
+void LUNAShader::SetUniform(const std::string& name, float value)
+{
+	SetUniformValues(name, UniformType::FLOAT, &value, 1);
+}
+
+void LUNAShader::SetUniform(const std::string& name, const glm::vec2& value)
+{
+	SetUniformValues(name, UniformType::VEC2, &value[0], 2);
+}
+
+void LUNAShader::SetUniform(const std::string& name, const glm::vec3& value)
+{
+	SetUniformValues(name, UniformType::VEC3, &value[0], 3);
+}
+
+void LUNAShader::SetUniform(const std::string& name, const glm::vec4& value)
+{
+	SetUniformValues(name, UniformType::VEC4, &value[0], 4);
+}
+
+void LUNAShader::SetUniform(const std::string& name, const glm::mat4& value)
+{
+	SetUniformValues(name, UniformType::MAT4, &value[0][0], 16);
+}
+
+// Set sampler uniform to given texture unit. Unit 0 is reserved for "u_texture"
+void LUNAShader::SetSamplerUniform(const std::string& name, const std::weak_ptr<LUNATexture>& texture, int unit)
+{
+	if(unit <= 0) LUNA_RETURN_ERR("Texture unit for sampler \"%s\" should be greater than 0", name.c_str());
+	if(unit >= glstate::GetMaxTextureUnits())
+	{
+		LUNA_RETURN_ERR("Texture unit for sampler \"%s\" should be less than %d", name.c_str(), glstate::GetMaxTextureUnits());
+	}
+
+	float value = (float)unit;
+	SetUniformValues(name, UniformType::SAMPLER, &value, 1);
+
+	// Texture change doesn't touch uniform value but changes rendered result
+	auto& uniform = uniforms[name];
+	if(uniform.type != UniformType::SAMPLER) return;
+	if(uniform.texture.lock() != texture.lock())
+	{
+		LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+		if(renderer->IsInProgress()) renderer->Render();
+		uniform.texture = texture;
+	}
 }
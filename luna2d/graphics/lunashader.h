@@ -24,6 +24,7 @@
 #pragma once
 
 #include "lunatexture.h"
+#include "lunavertexformat.h"
 #include "lunaglm.h"
 
 namespace luna2d{
@@ -36,6 +37,27 @@ public:
 	LUNAShader(const std::string& vertexSource, const std::string& fragmentSource);
 	virtual ~LUNAShader();
 
+private:
+	enum class UniformType
+	{
+		FLOAT,
+		VEC2,
+		VEC3,
+		VEC4,
+		MAT4,
+		SAMPLER,
+	};
+
+	// Shadow copy of custom uniform value
+	struct Uniform
+	{
+		GLint location = -1;
+		UniformType type;
+		float values[16];
+		std::weak_ptr<LUNATexture> texture; // Texture bound to unit from "values[0]" for samplers
+		bool dirty = true;
+	};
+
 private:
 	GLuint program = 0;
 	GLuint vertexShader = 0;
@@ -48,6 +70,22 @@ private:
 	GLint u_transformMatrix = -1;
 	GLint u_texture = -1;
 
+	// Attributes and uniforms for multi-texture batching
+	GLint a_textureIndex = -1;
+	GLint u_textures = -1;
+
+	// Cached values of default uniforms
+	glm::mat4 transformMatrix;
+	bool hasTransformMatrix = false;
+	unsigned transformMatrixVersion = 0; // Version of camera matrix, 0 when matrix set without version
+	GLint textureUnit = -1;
+	int textureUnitsCount = -1;
+
+	// Custom uniforms by name. Values are uploaded when shader is bound
+	std::unordered_map<std::string, Uniform> uniforms;
+	bool hasDirtyUniforms = false;
+	int samplersCount = 0;
+
 private:
 	// Load and compile shader
 	GLuint LoadShader(GLenum shaderType, const std::string& source);
@@ -58,22 +96,56 @@ private:
 	// Fetch default attributes and uniforms
 	void FetchDefaultAttributes();
 
+	// Update shadow copy of custom uniform. Pending render is flushed only when value is changed
+	void SetUniformValues(const std::string& name, UniformType type, const float* values, int count);
+
+	// Upload changed custom uniforms and bind sampler textures
+	void ApplyUniforms();
+
+public:
 	// Add default preprocessor directives to vertex shader source
-	std::string PreprocessVertex(const std::string& source);
+	// "#version" and "#extension" directives at beginning of source are kept before default directives,
+	// because they should precede any code
+	static std::string PreprocessVertex(const std::string& source);
 
 	// Add default preprocessor directives to fragment shader source
-	std::string PreprocessFragment(const std::string& source);
+	// "#version" and "#extension" directives at beginning of source are kept before default directives,
+	// because they should precede any code
+	static std::string PreprocessFragment(const std::string& source);
 
 public:
 	bool IsValid();
 	bool HasColorAttribute();
 	bool HasTexture();
-	void SetPositionAttribute(const std::vector<float>& vertexArray);
-	void SetColorAttribute(const std::vector<float>& vertexArray);
-	void SetTexCoordsAttribute(const std::vector<float>& vertexArray);
+	bool HasTextureIndex();
+
+	// Set vertex attributes pointers. "vertexData" is pointer to first vertex in client memory
+	// or offset in bound "GL_ARRAY_BUFFER" when vertexes streamed through vertex buffer
+	void SetPositionAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format);
+	void SetColorAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format);
+	void SetTexCoordsAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format);
+	void SetTextureIndexAttribute(const GLvoid* vertexData, const LUNAVertexFormat& format);
+
+
+	// Set uniforms of currently bound shader. Uniform values which already set to program are skipped
 	void SetTransformMatrix(const glm::mat4& matrix);
+	void SetTransformMatrix(const glm::mat4& matrix, unsigned version); // Compare only versions of matrix
 	void SetTextureUniform(const LUNATexture& texture);
 
+	// Bind samplers array "u_textures" to texture units from 0 to given count
+	void SetTextureUnitsUniform(int count);
+
+	// Set custom uniforms. Values are cached and uploaded to program only when changed
+	// Can be called at any time, not only for bound shader
+	void SetUniform(const std::string& name, float value);
+	void SetUniform(const std::string& name, const glm::vec2& value);
+	void SetUniform(const std::string& name, const glm::vec3& value);
+	void SetUniform(const std::string& name, const glm::vec4& value);
+	void SetUniform(const std::string& name, const glm::mat4& value);
+
+	// Set sampler uniform to given texture unit. Unit 0 is reserved for "u_texture"
+	void SetSamplerUniform(const std::string& name, const std::weak_ptr<LUNATexture>& texture, int unit);
+
 	void Bind();
 	void Unbind();
 
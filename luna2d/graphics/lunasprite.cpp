@@ -73,6 +73,7 @@ LUNASprite::LUNASprite(const LUNASprite& spr)
 	u2 = spr.u2;
 	v2 = spr.v2;
 	color = spr.color;
+	layer = spr.layer;
 }
 
 bool LUNASprite::InitFromTexture(const std::weak_ptr<LUNATexture>& texture)
@@ -90,6 +91,7 @@ bool LUNASprite::InitFromTexture(const std::weak_ptr<LUNATexture>& texture)
 	auto sharedTexture = texture.lock();
 	width = sharedTexture->GetWidthPoints();
 	height = sharedTexture->GetHeightPoints();
+	geometryDirty = true;
 
 	return true;
 }
@@ -110,6 +112,7 @@ bool LUNASprite::InitFromRegion(const std::weak_ptr<LUNATextureRegion>& region)
 	// Convert sizes to virtual resolution
 	width = sharedRegion->GetWidthPoints();
 	height = sharedRegion->GetHeightPoints();
+	geometryDirty = true;
 	return true;
 }
 
@@ -152,6 +155,11 @@ void LUNASprite::SetShader(const std::weak_ptr<LUNAShader>& shader)
 	material.shader = shader;
 }
 
+const LUNAMaterial& LUNASprite::GetMaterial()
+{
+	return material;
+}
+
 LUNABlendingMode LUNASprite::GetBlendingMode()
 {
 	return material.blending;
@@ -206,11 +214,13 @@ float LUNASprite::GetHeight()
 void LUNASprite::SetWidth(float width)
 {
 	this->width = width;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetHeight(float height)
 {
 	this->height = height;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetSize(float width, float height)
@@ -232,11 +242,13 @@ float LUNASprite::GetOriginY()
 void LUNASprite::SetOriginX(float originX)
 {
 	this->originX = originX;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetOriginY(float originY)
 {
 	this->originY = originY;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetOrigin(float originX, float originY)
@@ -264,11 +276,13 @@ float LUNASprite::GetScaleY()
 void LUNASprite::SetScaleX(float scaleX)
 {
 	this->scaleX = scaleX;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetScaleY(float scaleY)
 {
 	this->scaleY = scaleY;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetScale(float scale)
@@ -277,6 +291,57 @@ void LUNASprite::SetScale(float scale)
 	SetScaleY(scale);
 }
 
+void LUNASprite::UpdateGeometry()
+{
+	// Corners with origin at sprite position
+	float left = -originX * scaleX;
+	float bottom = -originY * scaleY;
+	float right = (width - originX) * scaleX;
+	float top = (height - originY) * scaleY;
+
+	localX[0] = left;
+	localY[0] = bottom;
+	localX[1] = left;
+	localY[1] = top;
+	localX[2] = right;
+	localY[2] = top;
+	localX[3] = right;
+	localY[3] = bottom;
+
+	if(angle != cachedAngle)
+	{
+		float radians = math::DegreesToRadians(angle);
+		angleSin = std::sin(radians);
+		angleCos = std::cos(radians);
+		cachedAngle = angle;
+	}
+
+	geometryDirty = false;
+}
+
+// Get positions of sprite corners with applied origin, scale and rotation
+// Corners order: left-bottom, left-top, right-top, right-bottom
+void LUNASprite::GetCorners(glm::vec2* corners)
+{
+	if(geometryDirty) UpdateGeometry();
+
+	math::TransformQuad(localX, localY, angleSin, angleCos, x, y, corners);
+}
+
+// Write transformed quad of sprite in given vertex format
+// Pointer must have at least "4 * format.GetStride()" bytes
+void LUNASprite::WriteQuad(unsigned char* dest, const LUNAVertexFormat& format)
+{
+	glm::vec2 corners[4];
+	GetCorners(corners);
+
+	int stride = format.GetStride();
+	format.WriteVertex(dest, corners[0].x, corners[0].y, color, u1, v2);
+	format.WriteVertex(dest + stride, corners[1].x, corners[1].y, color, u1, v1);
+	format.WriteVertex(dest + stride * 2, corners[2].x, corners[2].y, color, u2, v1);
+	format.WriteVertex(dest + stride * 3, corners[3].x, corners[3].y, color, u2, v2);
+}
+
 void LUNASprite::Render()
 {
 	if(material.texture.expired() || material.shader.expired())
@@ -287,55 +352,19 @@ void LUNASprite::Render()
 
 	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
 
-	// Sprite geometry
-	float x1 = 0;
-	float y1 = 0;
-	float x2 = 0;
-	float y2 = height * scaleY;
-	float x3 = width * scaleX;
-	float y3 = height * scaleY;
-	float x4 = width * scaleX;
-	float y4 = 0;
-
-	// Offset by origin
-	float offsetX = originX * scaleX;
-	float offsetY = originY * scaleY;
-	x1 -= offsetX;
-	y1 -= offsetY;
-	x2 -= offsetX;
-	y2 -= offsetY;
-	x3 -= offsetX;
-	y3 -= offsetY;
-	x4 -= offsetX;
-	y4 -= offsetY;
-
-	// Rotate
-	if(angle != 0)
-	{
-		float sin = std::sin(math::DegreesToRadians(angle));
-		float cos = std::cos(math::DegreesToRadians(angle));
-
-		float rx1 = x1 * cos - y1 * sin;
-		float ry1 = x1 * sin + y1 * cos;
-		float rx2 = x2 * cos - y2 * sin;
-		float ry2 = x2 * sin + y2 * cos;
-		float rx3 = x3 * cos - y3 * sin;
-		float ry3 = x3 * sin + y3 * cos;
-		float rx4 = x4 * cos - y4 * sin;
-		float ry4 = x4 * sin + y4 * cos;
-
-		x1 = rx1;
-		y1 = ry1;
-		x2 = rx2;
-		y2 = ry2;
-		x3 = rx3;
-		y3 = ry3;
-		x4 = rx4;
-		y4 = ry4;
-	}
+	glm::vec2 corners[4];
+	GetCorners(corners);
+
+	// Skip sprite if its bounding box is outside of camera
+	glm::vec2 minPos = glm::min(glm::min(corners[0], corners[1]), glm::min(corners[2], corners[3]));
+	glm::vec2 maxPos = glm::max(glm::max(corners[0], corners[1]), glm::max(corners[2], corners[3]));
+	if(renderer->IsCulled(LUNARect(minPos.x, minPos.y, maxPos.x - minPos.x, maxPos.y - minPos.y))) return;
 
-	renderer->RenderQuad(x + x1, y + y1, u1, v2, x + x2, y + y2, u1, v1, x + x3, y + y3, u2, v1, x + x4, y + y4, u2, v2,
-		&material, color);
+	int baseLayer = renderer->GetLayer();
+	renderer->SetLayer(baseLayer + layer);
+	renderer->RenderQuad(corners[0].x, corners[0].y, u1, v2, corners[1].x, corners[1].y, u1, v1,
+		corners[2].x, corners[2].y, u2, v1, corners[3].x, corners[3].y, u2, v2, &material, color);
+	renderer->SetLayer(baseLayer);
 }
 
 // Get rotation angle (in degrees)
@@ -348,6 +377,7 @@ float LUNASprite::GetAngle()
 void LUNASprite::SetAngle(float angle)
 {
 	this->angle = angle;
+	geometryDirty = true;
 }
 
 void LUNASprite::SetColor(float r, float g, float b)
@@ -371,3 +401,17 @@ float LUNASprite::GetAlpha()
 {
 	return color.a;
 }
+
+// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+// SEE: "LUNARenderer::SetLayer"
+int LUNASprite::GetLayer()
+{
+	return layer;
+}
+
+void LUNASprite::SetLayer(int layer)
+{
+	if(layer < RENDER_QUEUE_MIN_LAYER || layer > RENDER_QUEUE_MAX_LAYER) LUNA_RETURN_ERR("Invalid layer %d", layer);
+
+	this->layer = layer;
+}
@@ -28,6 +28,7 @@
 #include "lunacolor.h"
 #include "lunalua.h"
 #include "lunavector2.h"
+#include "lunavertexformat.h"
 
 namespace luna2d{
 
@@ -58,6 +59,19 @@ protected:
 	float u2 = 0;
 	float v2 = 0;
 	LUNAColor color = LUNAColor::WHITE;
+	int layer = 0;
+
+	// Corners relative to sprite position with applied origin and scale, and sine/cosine of angle
+	// Recalculated only after changing size, origin, scale or angle
+	float localX[4];
+	float localY[4];
+	float cachedAngle = 0;
+	float angleSin = 0;
+	float angleCos = 1;
+	bool geometryDirty = true;
+
+private:
+	void UpdateGeometry();
 
 protected:
 	bool InitFromTexture(const std::weak_ptr<LUNATexture>& texture);
@@ -67,6 +81,7 @@ public:
 	void SetTexture(const std::weak_ptr<LUNATexture>& texture);
 	void SetTextureRegion(const std::weak_ptr<LUNATextureRegion>& region);
 	void SetShader(const std::weak_ptr<LUNAShader>& shader);
+	const LUNAMaterial& GetMaterial();
 	LUNABlendingMode GetBlendingMode();
 	void SetBlendingMode(LUNABlendingMode blendingMode);
 	float GetX();
@@ -91,6 +106,15 @@ public:
 	void SetScaleX(float scaleX);
 	void SetScaleY(float scaleY);
 	void SetScale(float scale);
+
+	// Get positions of sprite corners with applied origin, scale and rotation
+	// Corners order: left-bottom, left-top, right-top, right-bottom
+	void GetCorners(glm::vec2* corners);
+
+	// Write transformed quad of sprite in given vertex format
+	// Pointer must have at least "4 * format.GetStride()" bytes
+	void WriteQuad(unsigned char* dest, const LUNAVertexFormat& format);
+
 	void Render();
 	float GetAngle(); // Get rotation angle (in degrees)
 	void SetAngle(float angle); // Set rotation angle (in degrees)
@@ -98,6 +122,10 @@ public:
 	LUNAColor GetColor();
 	void SetAlpha(float alpha);
 	float GetAlpha();
+	// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+	// SEE: "LUNARenderer::SetLayer"
+	int GetLayer();
+	void SetLayer(int layer);
 };
 
 }
@@ -0,0 +1,291 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaspritebatch.h"
+#include "lunagraphics.h"
+#include "lunaglstate.h"
+#include "lunaglhelpers.h"
+
+using namespace luna2d;
+
+LUNASpriteBatch::LUNASpriteBatch(const std::weak_ptr<LUNATexture>& texture)
+{
+	if(texture.expired()) LUNA_LOGE("Attempt to create sprite batch with invalid texture");
+	material.texture = texture;
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+	// Add sprite batch to reloadable assets list
+	LUNAEngine::SharedAssets()->SetAssetReloadable(this, true);
+#endif
+}
+
+LUNASpriteBatch::~LUNASpriteBatch()
+{
+	if(buffer != 0)
+	{
+		// Queued draw calls can use buffer, graphics can be already deleted when engine is deinitializing
+		LUNAGraphics* graphics = LUNAEngine::SharedGraphics();
+		if(graphics) graphics->GetRenderer()->FlushBuffer(buffer);
+
+		glstate::DeleteBuffers(1, &buffer);
+	}
+
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+	// Remove sprite batch from reloadable assets list
+	LUNAEngine::SharedAssets()->SetAssetReloadable(this, false);
+#endif
+}
+
+size_t LUNASpriteBatch::GetQuadSize()
+{
+	return LUNAEngine::SharedGraphics()->GetRenderer()->GetVertexFormat().GetStride() * 4;
+}
+
+bool LUNASpriteBatch::CheckSprite(const std::shared_ptr<LUNASprite>& sprite)
+{
+	if(!sprite)
+	{
+		LUNA_LOGE("Attempt to add invalid sprite to sprite batch");
+		return false;
+	}
+
+	if(sprite->GetMaterial().texture.lock() != material.texture.lock())
+	{
+		LUNA_LOGE("Texture of sprite doesn't match texture of sprite batch");
+		return false;
+	}
+
+	return true;
+}
+
+bool LUNASpriteBatch::CheckId(int id)
+{
+	if(id < 0 || id >= (int)quadIndexes.size() || quadIndexes[id] == -1)
+	{
+		LUNA_LOGE("Invalid sprite batch quad id \"%d\"", id);
+		return false;
+	}
+
+	return true;
+}
+
+void LUNASpriteBatch::MarkDirty(size_t begin, size_t end)
+{
+	if(dirtyBegin == dirtyEnd)
+	{
+		dirtyBegin = begin;
+		dirtyEnd = end;
+	}
+	else
+	{
+		dirtyBegin = std::min(dirtyBegin, begin);
+		dirtyEnd = std::max(dirtyEnd, end);
+	}
+
+	needUpdateBounds = true;
+}
+
+void LUNASpriteBatch::UpdateBounds()
+{
+	const LUNAVertexFormat& format = LUNAEngine::SharedGraphics()->GetRenderer()->GetVertexFormat();
+	size_t count = format.GetVertexCount(vertexes);
+
+	format.ReadPosition(vertexes, 0, minPos.x, minPos.y);
+	maxPos = minPos;
+
+	for(size_t i = 1; i < count; i++)
+	{
+		glm::vec2 pos;
+		format.ReadPosition(vertexes, i, pos.x, pos.y);
+		minPos = glm::min(minPos, pos);
+		maxPos = glm::max(maxPos, pos);
+	}
+
+	needUpdateBounds = false;
+}
+
+void LUNASpriteBatch::Upload()
+{
+	if(buffer == 0)
+	{
+		glGenBuffers(1, &buffer);
+		if(buffer == 0) return;
+
+		bufferSize = 0;
+	}
+
+	// Nothing changed since last upload
+	dirtyEnd = std::min(dirtyEnd, vertexes.size());
+	if(dirtyBegin >= dirtyEnd && vertexes.size() <= bufferSize)
+	{
+		dirtyBegin = 0;
+		dirtyEnd = 0;
+		return;
+	}
+
+	// Queued draw calls must be rendered with previous buffer data
+	LUNAEngine::SharedGraphics()->GetRenderer()->FlushBuffer(buffer);
+
+	glstate::BindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	// Reallocate storage only when batch grows. Whole data is uploaded in this case
+	if(vertexes.size() > bufferSize)
+	{
+		bufferSize = std::max(vertexes.size(), bufferSize * 2);
+		glBufferData(GL_ARRAY_BUFFER, bufferSize, nullptr, GL_STATIC_DRAW);
+		dirtyBegin = 0;
+		dirtyEnd = vertexes.size();
+	}
+
+	if(dirtyBegin < dirtyEnd) glBufferSubData(GL_ARRAY_BUFFER, dirtyBegin, dirtyEnd - dirtyBegin, &vertexes[dirtyBegin]);
+
+	dirtyBegin = 0;
+	dirtyEnd = 0;
+
+	LUNA_CHECK_GL_ERROR();
+}
+
+int LUNASpriteBatch::GetCount()
+{
+	return vertexes.size() / GetQuadSize();
+}
+
+void LUNASpriteBatch::Clear()
+{
+	vertexes.clear();
+	quadIds.clear();
+	quadIndexes.clear();
+	freeIds.clear();
+	dirtyBegin = 0;
+	dirtyEnd = 0;
+}
+
+LUNABlendingMode LUNASpriteBatch::GetBlendingMode()
+{
+	return material.blending;
+}
+
+void LUNASpriteBatch::SetBlendingMode(LUNABlendingMode blendingMode)
+{
+	material.blending = blendingMode;
+}
+
+// Add quad of given sprite with its current transformations. Returns id of added quad
+// Id stays valid until quad is removed. Ids of removed quads can be reused by next added quads
+// Sprite should use same texture as batch
+int LUNASpriteBatch::Add(const std::shared_ptr<LUNASprite>& sprite)
+{
+	if(!CheckSprite(sprite)) return -1;
+
+	size_t quadSize = GetQuadSize();
+	size_t offset = vertexes.size();
+
+	vertexes.resize(offset + quadSize);
+	sprite->WriteQuad(&vertexes[offset], LUNAEngine::SharedGraphics()->GetRenderer()->GetVertexFormat());
+	MarkDirty(offset, offset + quadSize);
+
+	int id = quadIndexes.size();
+	if(!freeIds.empty())
+	{
+		id = freeIds.back();
+		freeIds.pop_back();
+	}
+	else quadIndexes.push_back(-1);
+
+	quadIndexes[id] = quadIds.size();
+	quadIds.push_back(id);
+
+	return id;
+}
+
+// Replace quad with given id by quad of given sprite
+void LUNASpriteBatch::Set(int id, const std::shared_ptr<LUNASprite>& sprite)
+{
+	if(!CheckId(id) || !CheckSprite(sprite)) return;
+
+	size_t quadSize = GetQuadSize();
+	size_t offset = quadIndexes[id] * quadSize;
+
+	sprite->WriteQuad(&vertexes[offset], LUNAEngine::SharedGraphics()->GetRenderer()->GetVertexFormat());
+	MarkDirty(offset, offset + quadSize);
+}
+
+// Remove quad with given id. Last quad is moved to place of removed quad, so ids of other quads are kept
+void LUNASpriteBatch::Remove(int id)
+{
+	if(!CheckId(id)) return;
+
+	size_t quadSize = GetQuadSize();
+	int index = quadIndexes[id];
+	int lastIndex = quadIds.size() - 1;
+
+	if(index != lastIndex)
+	{
+		size_t offset = index * quadSize;
+		std::copy(vertexes.begin() + lastIndex * quadSize, vertexes.end(), vertexes.begin() + offset);
+		MarkDirty(offset, offset + quadSize);
+
+		int lastId = quadIds[lastIndex];
+		quadIds[index] = lastId;
+		quadIndexes[lastId] = index;
+	}
+
+	vertexes.resize(lastIndex * quadSize);
+	quadIds.pop_back();
+	quadIndexes[id] = -1;
+	freeIds.push_back(id);
+	needUpdateBounds = true;
+}
+
+void LUNASpriteBatch::Render()
+{
+	if(material.texture.expired())
+	{
+		LUNA_LOGE("Attempt to render invalid sprite batch");
+		return;
+	}
+
+	// Do not draw empty batch
+	if(vertexes.empty()) return;
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+
+	if(needUpdateBounds) UpdateBounds();
+	LUNARect bounds(minPos.x, minPos.y, maxPos.x - minPos.x, maxPos.y - minPos.y);
+	if(renderer->IsCulled(bounds)) return;
+
+	if(renderer->IsEnabledVertexBuffers()) Upload();
+	renderer->RenderQuadsBuffer(buffer, vertexes, bounds, &material);
+}
+
+// Recreate vertex buffer when application lost OpenGL context
+// SEE: "lunaassets.h"
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+void LUNASpriteBatch::Reload()
+{
+	buffer = 0;
+	bufferSize = 0;
+	dirtyBegin = 0;
+	dirtyEnd = vertexes.size();
+}
+#endif
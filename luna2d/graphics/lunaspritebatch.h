@@ -0,0 +1,92 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunasprite.h"
+#include "lunaassets.h"
+
+namespace luna2d{
+
+//------------------------------------------------------------------
+// Retained batch of static sprites. Transformed quads of sprites are
+// kept in vertex buffer and rendered with one draw call. Only
+// changed ranges of quads are uploaded again
+//------------------------------------------------------------------
+class LUNASpriteBatch : public LUNAAsset
+{
+	LUNA_USERDATA_DERIVED(LUNAAsset, LUNASpriteBatch)
+
+public:
+	LUNASpriteBatch(const std::weak_ptr<LUNATexture>& texture);
+	~LUNASpriteBatch();
+
+private:
+	LUNAMaterial material;
+	std::vector<unsigned char> vertexes; // Quads of all sprites in renderer vertex format
+	std::vector<int> quadIds; // Id of each quad in "vertexes"
+	std::vector<int> quadIndexes; // Index of quad in "vertexes" by quad id, or -1 for removed quads
+	std::vector<int> freeIds; // Ids of removed quads for reusing
+	GLuint buffer = 0;
+	size_t bufferSize = 0; // Size of allocated buffer storage (in bytes)
+	size_t dirtyBegin = 0; // Range of vertex data changed since last upload (in bytes)
+	size_t dirtyEnd = 0;
+	glm::vec2 minPos, maxPos; // Bounding box of all quads for camera culling
+	bool needUpdateBounds = false;
+
+private:
+	size_t GetQuadSize();
+	bool CheckSprite(const std::shared_ptr<LUNASprite>& sprite);
+	bool CheckId(int id);
+	void MarkDirty(size_t begin, size_t end);
+	void UpdateBounds();
+	void Upload();
+
+public:
+	int GetCount();
+	void Clear();
+	LUNABlendingMode GetBlendingMode();
+	void SetBlendingMode(LUNABlendingMode blendingMode);
+
+	// Add quad of given sprite with its current transformations. Returns id of added quad
+	// Id stays valid until quad is removed. Ids of removed quads can be reused by next added quads
+	// Sprite should use same texture as batch
+	int Add(const std::shared_ptr<LUNASprite>& sprite);
+
+	// Replace quad with given id by quad of given sprite
+	void Set(int id, const std::shared_ptr<LUNASprite>& sprite);
+
+	// Remove quad with given id. Last quad is moved to place of removed quad, so ids of other quads are kept
+	void Remove(int id);
+
+	void Render();
+
+// Recreate vertex buffer when application lost OpenGL context
+// SEE: "lunaassets.h"
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+public:
+	virtual void Reload();
+#endif
+};
+
+}
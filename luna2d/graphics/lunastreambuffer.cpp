@@ -0,0 +1,80 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunastreambuffer.h"
+#include "lunaglhelpers.h"
+#include "lunaglstate.h"
+
+using namespace luna2d;
+
+LUNAStreamBuffer::LUNAStreamBuffer()
+{
+	CreateBuffers();
+}
+
+LUNAStreamBuffer::~LUNAStreamBuffer()
+{
+	glstate::DeleteBuffers(STREAM_BUFFERS_COUNT, &buffers[0]);
+}
+
+void LUNAStreamBuffer::CreateBuffers()
+{
+	buffers.fill(0);
+	capacities.fill(0);
+	curBuffer = 0;
+
+	glGenBuffers(STREAM_BUFFERS_COUNT, &buffers[0]);
+}
+
+bool LUNAStreamBuffer::IsValid()
+{
+	for(GLuint buffer : buffers)
+	{
+		if(buffer == 0) return false;
+	}
+
+	return true;
+}
+
+// Upload given data to next buffer in ring and bind it to "GL_ARRAY_BUFFER" target
+void LUNAStreamBuffer::Upload(const void* data, size_t size)
+{
+	curBuffer = (curBuffer + 1) % STREAM_BUFFERS_COUNT;
+
+	glstate::BindBuffer(GL_ARRAY_BUFFER, buffers[curBuffer]);
+
+	// Grow buffer storage geometrically to avoid reallocations on each bigger batch
+	size_t& capacity = capacities[curBuffer];
+	if(size > capacity) capacity = std::max(size, capacity * 2);
+
+	// Orphan previous storage and fill new one
+	glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+	glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+
+	LUNA_CHECK_GL_ERROR();
+}
+
+void LUNAStreamBuffer::Unbind()
+{
+	glstate::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
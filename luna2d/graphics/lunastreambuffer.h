@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunagl.h"
+#include "lunaengine.h"
+
+namespace luna2d{
+
+const int STREAM_BUFFERS_COUNT = 3; // Count of vertex buffers in ring
+
+//-----------------------------------------------------------------
+// Ring of vertex buffer objects for streaming batched vertex data.
+// Each upload orphans storage of next buffer in ring, so driver
+// doesn't wait while GPU still reads data of previous batches
+//-----------------------------------------------------------------
+class LUNAStreamBuffer
+{
+public:
+	LUNAStreamBuffer();
+	~LUNAStreamBuffer();
+
+private:
+	std::array<GLuint, STREAM_BUFFERS_COUNT> buffers;
+	std::array<size_t, STREAM_BUFFERS_COUNT> capacities; // Allocated storage size for each buffer (in bytes)
+	int curBuffer = 0;
+
+private:
+	void CreateBuffers();
+
+public:
+	bool IsValid();
+
+	// Upload given data to next buffer in ring and bind it to "GL_ARRAY_BUFFER" target
+	void Upload(const void* data, size_t size);
+
+	void Unbind();
+
+// Recreate buffers when application lost OpenGL context
+// SEE: "lunaassets.h"
+#if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
+public:
+	inline void Reload()
+	{
+		CreateBuffers();
+	}
+#endif
+};
+
+}
@@ -24,6 +24,10 @@
 #include "lunatext.h"
 #include "lunautf.h"
 #include "lunagraphics.h"
+#include "lunalog.h"
+#include <cstring>
+#include <cctype>
+#include <limits>
 
 using namespace luna2d;
 
@@ -32,6 +36,120 @@ LUNAText::LUNAText(const std::weak_ptr<LUNAFont>& font)
 	SetFont(font);
 }
 
+// Lay out glyphs of current text starting from given char with current font
+void LUNAText::UpdateGlyphs(size_t first)
+{
+	auto sharedFont = font.lock();
+
+	// Glyphs laid out with previous atlas texture of font have invalid texture coordinates
+	if(sharedFont && sharedFont->GetGeneration() != fontGeneration) first = 0;
+
+	first = std::min(first, glyphs.size());
+	glyphs.resize(first);
+	MarkDirty(first);
+
+	if(sharedFont)
+	{
+		fontGeneration = sharedFont->GetGeneration();
+		material.texture = sharedFont->GetTexture();
+		float glyphScale = sharedFont->GetGlyphScale();
+
+		for(size_t i = first; i < text.size(); i++)
+		{
+			// Glyphs of chars without region are kept empty to match chars by index
+			Glyph glyph = {};
+			auto region = sharedFont->GetRegionForChar(text[i]).lock();
+
+			// Rasterizing of new char has grown font atlas, so all glyphs should be laid out again
+			if(sharedFont->GetGeneration() != fontGeneration)
+			{
+				UpdateGlyphs(0);
+				return;
+			}
+
+			if(region)
+			{
+				glyph.width = region->GetWidthPoints() * glyphScale;
+				glyph.height = region->GetHeightPoints() * glyphScale;
+				glyph.u1 = region->GetU1();
+				glyph.v1 = region->GetV1();
+				glyph.u2 = region->GetU2();
+				glyph.v2 = region->GetV2();
+			}
+			glyphs.push_back(glyph);
+		}
+	}
+
+	width = 0;
+	height = 0;
+	for(const Glyph& glyph : glyphs)
+	{
+		width += glyph.width;
+		height = std::max(height, glyph.height);
+	}
+}
+
+// Write quads of changed glyphs with applied position, scale and color
+void LUNAText::UpdateVertexes()
+{
+	const LUNAVertexFormat& format = LUNAEngine::SharedGraphics()->GetRenderer()->GetVertexFormat();
+	size_t stride = format.GetStride();
+
+	// Vertex array is reallocated only when text becomes longer than before
+	vertexes.resize(glyphs.size() * stride * 4);
+
+	size_t first = std::min(firstDirtyGlyph, glyphs.size());
+	float offset = 0;
+	if(first > 0) offset = glyphs[first - 1].offset + std::roundf(glyphs[first - 1].width * scaleX);
+
+	unsigned char* dest = vertexes.data() + first * stride * 4;
+	for(size_t i = first; i < glyphs.size(); i++)
+	{
+		Glyph& glyph = glyphs[i];
+		glyph.offset = offset;
+
+		float left = x + offset;
+		float right = left + glyph.width * scaleX;
+		float top = y + glyph.height * scaleY;
+
+		// Quad vertexes order is same as in "LUNARenderer::RenderQuad"
+		format.WriteVertex(dest, left, y, color, glyph.u1, glyph.v2);
+		format.WriteVertex(dest + stride, left, top, color, glyph.u1, glyph.v1);
+		format.WriteVertex(dest + stride * 2, right, top, color, glyph.u2, glyph.v1);
+		format.WriteVertex(dest + stride * 3, right, y, color, glyph.u2, glyph.v2);
+		dest += stride * 4;
+
+		offset += std::roundf(glyph.width * scaleX);
+	}
+
+	// Glyph offsets are rounded, so quads can be slightly wider than scaled text
+	const Glyph& last = glyphs.back();
+	float quadsWidth = last.offset + last.width * scaleX;
+	bounds = LUNARect(x, y, std::max(quadsWidth, width * scaleX), height * scaleY);
+
+	firstDirtyGlyph = std::numeric_limits<size_t>::max();
+}
+
+// Mark quads starting from given glyph as dirty
+void LUNAText::MarkDirty(size_t first)
+{
+	firstDirtyGlyph = std::min(firstDirtyGlyph, first);
+}
+
+// Replace text value with "newText". Only glyphs starting from first changed char are laid out again
+void LUNAText::ApplyNewText()
+{
+	size_t common = std::min(text.size(), newText.size());
+	size_t first = 0;
+	while(first < common && text[first] == newText[first]) first++;
+
+	// Text isn't changed
+	if(first == common && text.size() == newText.size()) return;
+
+	text.swap(newText);
+	UpdateGlyphs(first);
+}
+
 float LUNAText::GetX()
 {
 	return x;
@@ -45,11 +163,13 @@ float LUNAText::GetY()
 void LUNAText::SetX(float x)
 {
 	this->x = x;
+	MarkDirty(0);
 }
 
 void LUNAText::SetY(float y)
 {
 	this->y = y;
+	MarkDirty(0);
 }
 
 glm::vec2 LUNAText::GetPos()
@@ -61,6 +181,7 @@ void LUNAText::SetPos(float x, float y)
 {
 	this->x = x;
 	this->y = y;
+	MarkDirty(0);
 }
 
 float LUNAText::GetScaleX()
@@ -76,11 +197,13 @@ float LUNAText::GetScaleY()
 void LUNAText::SetScaleX(float scaleX)
 {
 	this->scaleX = scaleX;
+	MarkDirty(0);
 }
 
 void LUNAText::SetScaleY(float scaleY)
 {
 	this->scaleY = scaleY;
+	MarkDirty(0);
 }
 
 void LUNAText::SetScale(float scale)
@@ -95,6 +218,7 @@ void LUNAText::SetColor(float r, float g, float b)
 	color.r = r / 255.0f;
 	color.g = g / 255.0f;
 	color.b = b / 255.0f;
+	MarkDirty(0);
 }
 
 LUNAColor LUNAText::GetColor()
@@ -105,6 +229,7 @@ LUNAColor LUNAText::GetColor()
 void LUNAText::SetAlpha(float alpha)
 {
 	color.a = alpha;
+	MarkDirty(0);
 }
 
 float LUNAText::GetAlpha()
@@ -121,26 +246,23 @@ void LUNAText::SetFont(const std::weak_ptr<LUNAFont> font)
 	}
 
 	this->font = font;
+	fontGeneration = -1;
+
+	// Glyphs of SDF fonts are crisp with any scale, but they need special shader
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	material.shader = font.lock()->IsSdf() ? renderer->GetSdfFontShader() : renderer->GetFontShader();
+
+	UpdateGlyphs(0);
 }
 
 float LUNAText::GetWidth()
 {
-	if(sprites.empty()) return 0.0f;
-
-	float width = 0;
-	for(auto& spr : sprites) width += spr->GetWidth();
-
 	return width;
 }
 
 float LUNAText::GetHeight()
 {
-	if(sprites.empty()) return 0.0f;
-
-	float maxHeight = 0.0f;
-	for(auto& spr : sprites) maxHeight = std::max(maxHeight, spr->GetHeight());
-
-	return maxHeight;
+	return height;
 }
 
 // Get text value in UTF-8 encoding
@@ -160,17 +282,66 @@ void LUNAText::SetText(const std::string& text)
 	}
 
 	// Convert given string from UTF-8 to UTF-32
-	this->text = utf::ToUtf32(text);
+	utf::ToUtf32(text.c_str(), text.size(), newText);
+	ApplyNewText();
+}
 
-	auto sharedFont = font.lock();
-	sprites.erase(sprites.begin(), sprites.end());
-	sprites.clear();
-	for(char32_t c : this->text)
+// Set text value to number with given count of digits after decimal point
+// Cheaper than "SetText" for frequently changed labels, because Lua string isn't created
+void LUNAText::SetNumber(float value, int decimals)
+{
+	if(font.expired()) LUNA_RETURN_ERR("Attemp to set text value to invalid text object");
+
+	char buffer[64];
+	int length = snprintf(buffer, sizeof(buffer), "%.*f", std::max(0, std::min(decimals, 9)), value);
+	if(length < 0) return;
+
+	// Formatted number contains only ASCII chars
+	newText.assign(buffer, buffer + std::min<size_t>(length, sizeof(buffer) - 1));
+	ApplyNewText();
+}
+
+// Set text value to number formatted by printf-like format in UTF-8 encoding, like "Score: %d"
+// Format should contain exactly one conversion of "d", "i", "u", "x", "X", "f", "F", "e", "E", "g" or "G" type
+void LUNAText::SetFormatted(const std::string& format, float value)
+{
+	if(font.expired()) LUNA_RETURN_ERR("Attemp to set text value to invalid text object");
+
+	// Validate format to avoid reading arguments which aren't passed
+	int conversions = 0;
+	char type = 0;
+	for(size_t i = 0; i < format.size(); i++)
 	{
-		auto sprite = std::make_shared<LUNASprite>(sharedFont->GetRegionForChar(c));
-		sprite->SetShader(LUNAEngine::SharedGraphics()->GetRenderer()->GetFontShader());
-		sprites.push_back(sprite);
+		if(format[i] != '%') continue;
+
+		i++;
+		if(i < format.size() && format[i] == '%') continue; // Escaped "%"
+
+		while(i < format.size() && std::strchr("-+ #0", format[i])) i++; // Flags
+		while(i < format.size() && std::isdigit(static_cast<unsigned char>(format[i]))) i++; // Width
+		if(i < format.size() && format[i] == '.')
+		{
+			i++;
+			while(i < format.size() && std::isdigit(static_cast<unsigned char>(format[i]))) i++; // Precision
+		}
+
+		if(i == format.size() || !std::strchr("diuxXfFeEgG", format[i])) LUNA_RETURN_ERR("Invalid text format \"%s\"", format.c_str());
+
+		type = format[i];
+		conversions++;
 	}
+
+	if(conversions != 1) LUNA_RETURN_ERR("Text format \"%s\" should contain exactly one conversion", format.c_str());
+
+	char buffer[256];
+	int length = 0;
+	if(std::strchr("di", type)) length = snprintf(buffer, sizeof(buffer), format.c_str(), static_cast<int>(value));
+	else if(std::strchr("uxX", type)) length = snprintf(buffer, sizeof(buffer), format.c_str(), static_cast<unsigned int>(std::max(0.0f, value)));
+	else length = snprintf(buffer, sizeof(buffer), format.c_str(), static_cast<double>(value));
+	if(length < 0) return;
+
+	utf::ToUtf32(buffer, std::min<size_t>(length, sizeof(buffer) - 1), newText);
+	ApplyNewText();
 }
 
 void LUNAText::Render()
@@ -181,16 +352,37 @@ void LUNAText::Render()
 		return;
 	}
 
-	int offset = 0;
-	for(auto& spr : sprites)
-	{
-		spr->SetPos(x + offset, y);
-		spr->SetScaleX(scaleX);
-		spr->SetScaleY(scaleY);
-		spr->SetColor(color.GetR(), color.GetG(), color.GetB());
-		spr->SetAlpha(color.a);
-		spr->Render();
-
-		offset += std::roundf(spr->GetWidth() * spr->GetScaleX());
-	}
+	// Chars rasterized since last frame are uploaded to atlas texture of font before rendering
+	// If atlas was recreated by another text, glyphs should be laid out with new atlas
+	auto sharedFont = font.lock();
+	if(sharedFont->GetGeneration() != fontGeneration) UpdateGlyphs(0);
+	sharedFont->UploadChanges();
+
+	// Do not draw empty text
+	if(glyphs.empty()) return;
+
+	if(firstDirtyGlyph != std::numeric_limits<size_t>::max()) UpdateVertexes();
+
+	// Skip whole text if its bounding box is outside of camera
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	if(renderer->IsCulled(bounds)) return;
+
+	int baseLayer = renderer->GetLayer();
+	renderer->SetLayer(baseLayer + layer);
+	renderer->RenderQuads(vertexes, bounds, &material);
+	renderer->SetLayer(baseLayer);
+}
+
+// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+// SEE: "LUNARenderer::SetLayer"
+int LUNAText::GetLayer()
+{
+	return layer;
+}
+
+void LUNAText::SetLayer(int layer)
+{
+	if(layer < RENDER_QUEUE_MIN_LAYER || layer > RENDER_QUEUE_MAX_LAYER) LUNA_RETURN_ERR("Invalid layer %d", layer);
+
+	this->layer = layer;
 }
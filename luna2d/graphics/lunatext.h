@@ -24,10 +24,18 @@
 #pragma once
 
 #include "lunafont.h"
-#include "lunasprite.h"
+#include "lunamaterial.h"
+#include "lunacolor.h"
+#include "lunalua.h"
+#include "lunarect.h"
 
 namespace luna2d{
 
+//---------------------------------------------------------------
+// One-line text. Glyphs are laid out once when text or font is
+// changed. Quads of all glyphs are kept in single vertex array
+// and rendered as one draw call entry
+//---------------------------------------------------------------
 class LUNAText
 {
 	LUNA_USERDATA(LUNAText)
@@ -35,15 +43,46 @@ class LUNAText
 public:
 	LUNAText(const std::weak_ptr<LUNAFont>& font);
 
+private:
+	// Layout of glyph in unscaled text
+	struct Glyph
+	{
+		float width, height;
+		float u1, v1, u2, v2;
+		float offset; // Offset of glyph quad from text position with applied scale
+	};
+
 private:
 	std::weak_ptr<LUNAFont> font;
-	std::vector<std::shared_ptr<LUNASprite>> sprites;
+	int fontGeneration = -1; // Generation of font atlas used for laying out glyphs
+	LUNAMaterial material;
+	std::vector<Glyph> glyphs;
+	std::vector<unsigned char> vertexes; // Quads of glyphs in renderer vertex format
+	LUNARect bounds; // Bounding box of quads
+	size_t firstDirtyGlyph = 0; // Quads starting from this glyph should be written again
+	float width = 0; // Cached sizes of unscaled text
+	float height = 0;
 	std::u32string text; // Text in UTF-32 encoding
+	std::u32string newText; // Buffer for converting new text value to UTF-32 encoding
 	float x = 0;
 	float y = 0;
 	float scaleX = 1;
 	float scaleY = 1;
 	LUNAColor color = LUNAColor::WHITE;
+	int layer = 0;
+
+private:
+	// Lay out glyphs of current text starting from given char with current font
+	void UpdateGlyphs(size_t first);
+
+	// Write quads of changed glyphs with applied position, scale and color
+	void UpdateVertexes();
+
+	// Mark quads starting from given glyph as dirty
+	void MarkDirty(size_t first);
+
+	// Replace text value with "newText". Only glyphs starting from first changed char are laid out again
+	void ApplyNewText();
 
 public:
 	float GetX();
@@ -66,6 +105,18 @@ public:
 	float GetHeight();
 	std::string GetText(); // Get text value in UTF-8 encoding
 	void SetText(const std::string& text); // Set text value. Given text in UTF-8 encoding
+
+	// Set text value to number with given count of digits after decimal point
+	// Cheaper than "SetText" for frequently changed labels, because Lua string isn't created
+	void SetNumber(float value, int decimals);
+
+	// Set text value to number formatted by printf-like format in UTF-8 encoding, like "Score: %d"
+	// Format should contain exactly one conversion of "d", "i", "u", "x", "X", "f", "F", "e", "E", "g" or "G" type
+	void SetFormatted(const std::string& format, float value);
+	// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+	// SEE: "LUNARenderer::SetLayer"
+	int GetLayer();
+	void SetLayer(int layer);
 	void Render();
 };
 
@@ -28,35 +28,71 @@
 using namespace luna2d;
 
 // Construct texture from image data
-LUNATexture::LUNATexture(const LUNAImage& image) :
+// Mipmaps for mipmap filters are built from image on CPU
+LUNATexture::LUNATexture(const LUNAImage& image, const LUNATextureParams& params) :
 	width(image.GetWidth()),
 	height(image.GetHeight()),
-	colorType(image.GetColorType())
+	colorType(image.GetColorType()),
+	filter(params.filter),
+	wrap(params.wrap)
 {
+	if(!IsPowerOfTwo())
+	{
+		if(IsMipmapFilter(filter))
+		{
+			LUNA_LOGE("Mipmaps are not supported for non-power-of-two texture %dx%d", width, height);
+			filter = filter == LUNATextureFilter::NEAREST_MIPMAP ? LUNATextureFilter::NEAREST : LUNATextureFilter::LINEAR;
+		}
+		wrap = LUNATextureWrap::CLAMP;
+	}
+
 	InitFromImageData(image.GetData());
 }
 
-// Construct empty texture
+// Construct texture from compressed image. Format of image should be supported by device
+// All levels of image are uploaded. Mipmap filters can be used only when image contains mipmap levels
+LUNATexture::LUNATexture(const LUNACompressedImage& image, const LUNATextureParams& params) :
+	width(image.GetWidth()),
+	height(image.GetHeight()),
+	colorType(image.HasAlpha() ? LUNAColorType::RGBA : LUNAColorType::RGB),
+	filter(params.filter),
+	wrap(params.wrap)
+{
+	// Mipmaps cannot be generated for compressed textures
+	if(IsMipmapFilter(filter) && (image.GetLevelsCount() <= 1 || !IsPowerOfTwo()))
+	{
+		LUNA_LOGE("Mipmap filter requires mipmap levels in compressed image and power-of-two size");
+		filter = filter == LUNATextureFilter::NEAREST_MIPMAP ? LUNATextureFilter::NEAREST : LUNATextureFilter::LINEAR;
+	}
+	if(!IsPowerOfTwo()) wrap = LUNATextureWrap::CLAMP;
+
+	InitFromCompressedImage(image);
+}
+
+// Construct empty texture. Size can be non-power-of-two,
+// because empty textures use clamping without mipmaps
 LUNATexture::LUNATexture(int width, int height, LUNAColorType colorType) :
 	width(width),
 	height(height),
-	colorType(colorType)
+	colorType(colorType),
+	filter(LUNATextureFilter::NEAREST),
+	wrap(LUNATextureWrap::CLAMP)
 {
 	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_2D, id);
+	glstate::BindTexture(id);
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	// OpenGL ES 2.0 supports non-power-of-two textures only with clamping
+	ApplyParams();
 
 	GLint glColorType = ToGlColorType(colorType);
 	glTexImage2D(GL_TEXTURE_2D, 0, glColorType, width, height, 0, glColorType, GL_UNSIGNED_BYTE, 0);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glstate::BindTexture(0);
 }
 
 LUNATexture::~LUNATexture()
 {
-	glDeleteTextures(1, &id);
+	glstate::DeleteTextures(1, &id);
 
 #if LUNA_PLATFORM == LUNA_PLATFORM_ANDROID
 	// Remove texture from reloadable assets list
@@ -68,15 +104,104 @@ LUNATexture::~LUNATexture()
 void LUNATexture::InitFromImageData(const std::vector<unsigned char>& data)
 {
 	glGenTextures(1, &id);
-	glBindTexture(GL_TEXTURE_2D, id);
+	glstate::BindTexture(id);
 
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	// Rows of image data are tightly packed
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
 	GLint glColorType = ToGlColorType(colorType);
 	glTexImage2D(GL_TEXTURE_2D, 0, glColorType, width, height, 0, glColorType, GL_UNSIGNED_BYTE, &data[0]);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	hasMipmaps = IsMipmapFilter(filter);
+	if(hasMipmaps) UploadMipmaps(LUNAImage(width, height, colorType, data));
+
+	ApplyParams();
+
+	glstate::BindTexture(0);
+}
+
+void LUNATexture::InitFromCompressedImage(const LUNACompressedImage& image)
+{
+	glGenTextures(1, &id);
+	glstate::BindTexture(id);
+
+	compressedSize = 0;
+	int levelsCount = IsPowerOfTwo() ? image.GetLevelsCount() : 1;
+	for(int i = 0; i < levelsCount; i++)
+	{
+		const std::vector<unsigned char>& level = image.GetLevel(i);
+		int levelWidth = std::max(1, width >> i);
+		int levelHeight = std::max(1, height >> i);
+
+		glCompressedTexImage2D(GL_TEXTURE_2D, i, image.GetGlFormat(), levelWidth, levelHeight, 0, level.size(), &level[0]);
+		compressedSize += level.size();
+	}
+
+	hasMipmaps = levelsCount > 1;
+	ApplyParams();
+
+	glstate::BindTexture(0);
+}
+
+// Upload downscaled levels of given image made by box filter
+void LUNATexture::UploadMipmaps(const LUNAImage& image)
+{
+	// 1x1 image is already last level
+	if(image.GetWidth() == 1 && image.GetHeight() == 1) return;
+
+	GLint glColorType = ToGlColorType(colorType);
+	LUNAImage level = image.MakeMipmap();
+
+	// Rows of small levels are shorter than default alignment
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	for(int i = 1; ; i++)
+	{
+		glTexImage2D(GL_TEXTURE_2D, i, glColorType, level.GetWidth(), level.GetHeight(), 0, glColorType,
+			GL_UNSIGNED_BYTE, &level.GetData()[0]);
+
+		if(level.GetWidth() == 1 && level.GetHeight() == 1) break;
+		level = level.MakeMipmap();
+	}
+}
+
+// Set filter and wrap parameters to bound texture
+void LUNATexture::ApplyParams()
+{
+	GLint glMinFilter = GL_LINEAR;
+	GLint glMagFilter = GL_LINEAR;
+
+	switch(filter)
+	{
+	case LUNATextureFilter::NEAREST:
+		glMinFilter = GL_NEAREST;
+		glMagFilter = GL_NEAREST;
+		break;
+	case LUNATextureFilter::LINEAR:
+		break;
+	case LUNATextureFilter::NEAREST_MIPMAP:
+		glMinFilter = GL_NEAREST_MIPMAP_NEAREST;
+		glMagFilter = GL_NEAREST;
+		break;
+	case LUNATextureFilter::LINEAR_MIPMAP:
+		glMinFilter = GL_LINEAR_MIPMAP_LINEAR;
+		break;
+	}
+
+	GLint glWrap = GL_CLAMP_TO_EDGE;
+	if(wrap == LUNATextureWrap::REPEAT) glWrap = GL_REPEAT;
+	else if(wrap == LUNATextureWrap::MIRRORED_REPEAT) glWrap = GL_MIRRORED_REPEAT;
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, glMinFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, glMagFilter);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, glWrap);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, glWrap);
+}
+
+// OpenGL ES 2.0 supports non-power-of-two textures only with clamping and without mipmaps
+bool LUNATexture::IsPowerOfTwo() const
+{
+	return (width & (width - 1)) == 0 && (height & (height - 1)) == 0;
 }
 
 // Get sizes in pixels
@@ -101,6 +226,102 @@ float LUNATexture::GetHeightPoints() const
 	return std::floor(height * LUNAEngine::SharedSizes()->GetTextureScale());
 }
 
+LUNAColorType LUNATexture::GetColorType() const
+{
+	return colorType;
+}
+
+LUNATextureFilter LUNATexture::GetFilter() const
+{
+	return filter;
+}
+
+// Setting mipmap filter generates mipmaps on GPU if texture hasn't them
+void LUNATexture::SetFilter(LUNATextureFilter filter)
+{
+	if(this->filter == filter) return;
+
+	if(IsMipmapFilter(filter) && !hasMipmaps)
+	{
+		GenerateMipmaps();
+		if(!hasMipmaps) return;
+	}
+
+	this->filter = filter;
+
+	glstate::BindTexture(id);
+	ApplyParams();
+}
+
+LUNATextureWrap LUNATexture::GetWrap() const
+{
+	return wrap;
+}
+
+void LUNATexture::SetWrap(LUNATextureWrap wrap)
+{
+	if(this->wrap == wrap) return;
+
+	if(wrap != LUNATextureWrap::CLAMP && !IsPowerOfTwo())
+	{
+		LUNA_RETURN_ERR("Only clamping is supported for non-power-of-two texture %dx%d", width, height);
+	}
+
+	this->wrap = wrap;
+
+	glstate::BindTexture(id);
+	ApplyParams();
+}
+
+// Generate mipmaps from current texture content on GPU
+// Should be called again after changing content of texture, for example by rendering to framebuffer
+void LUNATexture::GenerateMipmaps()
+{
+	if(IsCompressed()) LUNA_RETURN_ERR("Mipmaps cannot be generated for compressed texture");
+	if(!IsPowerOfTwo()) LUNA_RETURN_ERR("Mipmaps are not supported for non-power-of-two texture %dx%d", width, height);
+
+	glstate::BindTexture(id);
+	glGenerateMipmap(GL_TEXTURE_2D);
+	hasMipmaps = true;
+}
+
+// Replace given rows of texture with rows of image. Image should have same width and color type as texture
+// Mipmaps aren't updated, call "GenerateMipmaps" after updating if texture has them
+void LUNATexture::UpdateRows(const LUNAImage& image, int firstRow, int rowsCount)
+{
+	if(IsCompressed()) LUNA_RETURN_ERR("Compressed texture cannot be updated");
+	if(image.GetWidth() != width || image.GetColorType() != colorType) LUNA_RETURN_ERR("Image doesn't match texture");
+	if(firstRow < 0 || rowsCount <= 0 || firstRow + rowsCount > std::min(height, image.GetHeight())) return;
+
+	GLint glColorType = ToGlColorType(colorType);
+	size_t offset = firstRow * width * GetBytesPerPixel(colorType);
+
+	glstate::BindTexture(id);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Rows of image data are tightly packed
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, width, rowsCount, glColorType, GL_UNSIGNED_BYTE, &image.GetData()[offset]);
+}
+
+bool LUNATexture::HasMipmaps() const
+{
+	return hasMipmaps;
+}
+
+// Get size of texture data in video memory including mipmaps (in bytes)
+size_t LUNATexture::GetMemorySize() const
+{
+	if(IsCompressed()) return compressedSize;
+
+	size_t size = width * height * GetBytesPerPixel(colorType);
+
+	// Full chain of mipmaps takes one third of base level
+	return hasMipmaps ? size + size / 3 : size;
+}
+
+bool LUNATexture::IsCompressed() const
+{
+	return compressedSize > 0;
+}
+
 GLuint LUNATexture::GetId() const
 {
 	return id;
@@ -112,12 +333,12 @@ bool LUNATexture::IsValid() const
 	return glIsTexture(id) == GL_TRUE;
 }
 
-void LUNATexture::Bind() const
+void LUNATexture::Bind(int unit) const
 {
-	glBindTexture(GL_TEXTURE_2D, id);
+	glstate::BindTexture(id, unit);
 }
 
-void LUNATexture::Unbind() const
+void LUNATexture::Unbind(int unit) const
 {
-	glBindTexture(GL_TEXTURE_2D, 0);
+	glstate::BindTexture(0, unit);
 }
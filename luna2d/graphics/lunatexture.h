@@ -25,8 +25,11 @@
 
 #include "lunagl.h"
 #include "lunaglhelpers.h"
+#include "lunaglstate.h"
 #include "lunaimage.h"
+#include "lunacompressedimage.h"
 #include "lunaassets.h"
+#include "lunatextureparams.h"
 
 namespace luna2d{
 
@@ -36,9 +39,15 @@ class LUNATexture : public LUNAAsset
 
 public:
 	// Construct texture from image data
-	LUNATexture(const LUNAImage& image);
+	// Mipmaps for mipmap filters are built from image on CPU
+	LUNATexture(const LUNAImage& image, const LUNATextureParams& params = LUNATextureParams());
 
-	// Construct empty texture
+	// Construct texture from compressed image. Format of image should be supported by device
+	// All levels of image are uploaded. Mipmap filters can be used only when image contains mipmap levels
+	LUNATexture(const LUNACompressedImage& image, const LUNATextureParams& params = LUNATextureParams());
+
+	// Construct empty texture. Size can be non-power-of-two,
+	// because empty textures use clamping without mipmaps
 	LUNATexture(int width, int height, LUNAColorType colorType);
 
 	virtual ~LUNATexture();
@@ -46,10 +55,24 @@ public:
 private:
 	int width, height;
 	LUNAColorType colorType;
+	LUNATextureFilter filter = LUNATextureFilter::LINEAR;
+	LUNATextureWrap wrap = LUNATextureWrap::REPEAT;
+	bool hasMipmaps = false;
+	size_t compressedSize = 0; // Size of all levels of compressed texture, 0 for uncompressed textures
 	GLuint id = 0;
 
 private:
 	void InitFromImageData(const std::vector<unsigned char>& data);
+	void InitFromCompressedImage(const LUNACompressedImage& image);
+
+	// Upload downscaled levels of given image made by box filter
+	void UploadMipmaps(const LUNAImage& image);
+
+	// Set filter and wrap parameters to bound texture
+	void ApplyParams();
+
+	// OpenGL ES 2.0 supports non-power-of-two textures only with clamping and without mipmaps
+	bool IsPowerOfTwo() const;
 
 public:
 	// Get sizes in pixels
@@ -60,11 +83,34 @@ public:
 	float GetWidthPoints() const;
 	float GetHeightPoints() const;
 
+	LUNAColorType GetColorType() const;
+
+	// Setting mipmap filter generates mipmaps on GPU if texture hasn't them
+	LUNATextureFilter GetFilter() const;
+	void SetFilter(LUNATextureFilter filter);
+
+	LUNATextureWrap GetWrap() const;
+	void SetWrap(LUNATextureWrap wrap);
+
+	// Generate mipmaps from current texture content on GPU
+	// Should be called again after changing content of texture, for example by rendering to framebuffer
+	void GenerateMipmaps();
+	bool HasMipmaps() const;
+
+	// Replace given rows of texture with rows of image. Image should have same width and color type as texture
+	// Mipmaps aren't updated, call "GenerateMipmaps" after updating if texture has them
+	void UpdateRows(const LUNAImage& image, int firstRow, int rowsCount);
+
+	// Get size of texture data in video memory including mipmaps (in bytes)
+	size_t GetMemorySize() const;
+
+	bool IsCompressed() const;
+
 	GLuint GetId() const;
 	bool IsValid() const; // Check for texture is valid. Can be invalid after loss GL context
 
-	void Bind() const;
-	void Unbind() const;
+	void Bind(int unit = 0) const;
+	void Unbind(int unit = 0) const;
 
 // Reload texture when application lost OpenGL context
 // SEE: "lunaassets.h"
@@ -106,6 +152,27 @@ public:
 			std::string ext = LUNAEngine::SharedFiles()->GetExtension(reloadPath);
 			std::unique_ptr<LUNAImageFormat> format;
 
+			// Compressed textures are reloaded in same way as they were loaded: directly or with decoding on CPU
+			if(ext == "ktx" || ext == "pkm")
+			{
+				LUNACompressedImage image(reloadPath, LUNAFileLocation::ASSETS);
+				if(!image.IsEmpty())
+				{
+					if(IsCompressed())
+					{
+						InitFromCompressedImage(image);
+						return;
+					}
+
+					LUNAImage decodedImage = image.Decode();
+					if(!decodedImage.IsEmpty())
+					{
+						InitFromImageData(decodedImage.GetData());
+						return;
+					}
+				}
+			}
+
 			// Select image format to decode
 			if(ext == "png") format = std::unique_ptr<LUNAPngFormat>(new LUNAPngFormat());
 
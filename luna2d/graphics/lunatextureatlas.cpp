@@ -36,6 +36,12 @@ LUNATextureAtlas::LUNATextureAtlas(const std::shared_ptr<LUNATexture>& texture,
 	Load(texture, atlasFile, location);
 }
 
+// Construct atlas from parsed description. Section "@texture" with texture params is skipped
+LUNATextureAtlas::LUNATextureAtlas(const std::shared_ptr<LUNATexture>& texture, const json11::Json& jsonAtlas)
+{
+	Load(texture, jsonAtlas);
+}
+
 void LUNATextureAtlas::Load(const std::shared_ptr<LUNATexture>& texture, const std::string& atlasFile, LUNAFileLocation location)
 {
 	std::string atlasData = LUNAEngine::SharedFiles()->ReadFileToString(atlasFile, location);
@@ -49,12 +55,19 @@ void LUNATextureAtlas::Load(const std::shared_ptr<LUNATexture>& texture, const s
 		return;
 	}
 
+	Load(texture, jsonAtlas);
+}
+
+void LUNATextureAtlas::Load(const std::shared_ptr<LUNATexture>& texture, const json11::Json& jsonAtlas)
+{
 	std::weak_ptr<LUNATexture> weakTexture = texture;
 	for(auto entry : jsonAtlas.object_items())
 	{
 		const std::string& name = entry.first;
 		const Json& jsonRegion = entry.second;
 
+		if(name == ATLAS_TEXTURE_PARAMS) continue;
+
 		int x = jsonRegion["x"].int_value();
 		int y = jsonRegion["y"].int_value();
 		int width = jsonRegion["width"].int_value();
@@ -26,9 +26,13 @@
 #include "lunatextureregion.h"
 #include <string>
 #include <unordered_map>
+#include <json11.hpp>
 
 namespace luna2d{
 
+// Name of section with texture params in atlas description
+const std::string ATLAS_TEXTURE_PARAMS = "@texture";
+
 class LUNATextureAtlas
 {
 	typedef std::unordered_map<std::string, std::shared_ptr<LUNATextureRegion>> RegionsMap;
@@ -37,11 +41,15 @@ public:
 	LUNATextureAtlas(const std::shared_ptr<LUNATexture>& texture, const std::string& atlasFile,
 		LUNAFileLocation location = LUNAFileLocation::ASSETS);
 
+	// Construct atlas from parsed description. Section "@texture" with texture params is skipped
+	LUNATextureAtlas(const std::shared_ptr<LUNATexture>& texture, const json11::Json& jsonAtlas);
+
 private:
 	RegionsMap regions;
 
 private:
 	void Load(const std::shared_ptr<LUNATexture>&, const std::string& atlasFile, LUNAFileLocation location);
+	void Load(const std::shared_ptr<LUNATexture>&, const json11::Json& jsonAtlas);
 
 public:
 	bool IsLoaded() const;
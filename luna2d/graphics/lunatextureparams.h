@@ -0,0 +1,115 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunastringenum.h"
+#include "lunalua.h"
+
+namespace luna2d{
+
+//-------------------------------------------------------------
+// Filtering used when texture is scaled. Mipmap filters sample
+// precomputed downscaled levels when texture is minified
+//-------------------------------------------------------------
+enum class LUNATextureFilter
+{
+	NEAREST,
+	LINEAR,
+	NEAREST_MIPMAP,
+	LINEAR_MIPMAP,
+};
+
+const LUNAStringEnum<LUNATextureFilter> TEXTURE_FILTER =
+{
+	"nearest",
+	"linear",
+	"nearestMipmap",
+	"linearMipmap",
+};
+
+template<>
+struct LuaStack<LUNATextureFilter>
+{
+	static void Push(lua_State* luaVm, const LUNATextureFilter& filter)
+	{
+		LuaStack<std::string>::Push(luaVm, TEXTURE_FILTER.FromEnum(filter));
+	}
+
+	static LUNATextureFilter Pop(lua_State* luaVm, int index = -1)
+	{
+		auto strFilter = LuaStack<std::string>::Pop(luaVm, index);
+		return TEXTURE_FILTER.FromString(strFilter, LUNATextureFilter::LINEAR);
+	}
+};
+
+
+//------------------------------------------------
+// Wrapping of texture coordinates outside [0, 1]
+//------------------------------------------------
+enum class LUNATextureWrap
+{
+	CLAMP,
+	REPEAT,
+	MIRRORED_REPEAT,
+};
+
+const LUNAStringEnum<LUNATextureWrap> TEXTURE_WRAP =
+{
+	"clamp",
+	"repeat",
+	"mirroredRepeat",
+};
+
+template<>
+struct LuaStack<LUNATextureWrap>
+{
+	static void Push(lua_State* luaVm, const LUNATextureWrap& wrap)
+	{
+		LuaStack<std::string>::Push(luaVm, TEXTURE_WRAP.FromEnum(wrap));
+	}
+
+	static LUNATextureWrap Pop(lua_State* luaVm, int index = -1)
+	{
+		auto strWrap = LuaStack<std::string>::Pop(luaVm, index);
+		return TEXTURE_WRAP.FromString(strWrap, LUNATextureWrap::CLAMP);
+	}
+};
+
+
+//-----------------------------------------------------
+// Sampling parameters of texture. Can be declared in
+// texture metadata or in "@texture" section of atlas
+//-----------------------------------------------------
+struct LUNATextureParams
+{
+	LUNATextureFilter filter = LUNATextureFilter::LINEAR;
+	LUNATextureWrap wrap = LUNATextureWrap::REPEAT;
+};
+
+inline bool IsMipmapFilter(LUNATextureFilter filter)
+{
+	return filter == LUNATextureFilter::NEAREST_MIPMAP || filter == LUNATextureFilter::LINEAR_MIPMAP;
+}
+
+}
@@ -0,0 +1,263 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunavertexformat.h"
+#include <cstring>
+#include <limits>
+
+using namespace luna2d;
+
+// Convert value in range 0.0f-1.0f to normalized integer value
+template<typename T>
+static inline T PackNormalized(float value)
+{
+	const float maxValue = static_cast<float>(std::numeric_limits<T>::max());
+
+	if(value <= 0.0f) return 0;
+	if(value >= 1.0f) return std::numeric_limits<T>::max();
+	return static_cast<T>(value * maxValue + 0.5f);
+}
+
+// Convert normalized integer value to value in range 0.0f-1.0f
+template<typename T>
+static inline float UnpackNormalized(T value)
+{
+	return static_cast<float>(value) / static_cast<float>(std::numeric_limits<T>::max());
+}
+
+LUNAVertexFormat::LUNAVertexFormat(LUNAVertexFormatType type, bool textureIndex) :
+	type(type)
+{
+	colorOffset = 2 * sizeof(float);
+
+	switch(type)
+	{
+	case LUNAVertexFormatType::FLOAT:
+		texCoordsOffset = colorOffset + 4 * sizeof(float);
+		stride = texCoordsOffset + 2 * sizeof(float);
+		break;
+	case LUNAVertexFormatType::PACKED_COLOR:
+		texCoordsOffset = colorOffset + 4 * sizeof(GLubyte);
+		stride = texCoordsOffset + 2 * sizeof(float);
+		break;
+	case LUNAVertexFormatType::PACKED:
+		texCoordsOffset = colorOffset + 4 * sizeof(GLubyte);
+		stride = texCoordsOffset + 2 * sizeof(GLushort);
+		break;
+	}
+
+	if(textureIndex)
+	{
+		textureIndexOffset = stride;
+		stride += 4 * sizeof(GLubyte);
+	}
+}
+
+LUNAVertexFormatType LUNAVertexFormat::GetType() const
+{
+	return type;
+}
+
+int LUNAVertexFormat::GetStride() const
+{
+	return stride;
+}
+
+int LUNAVertexFormat::GetColorOffset() const
+{
+	return colorOffset;
+}
+
+int LUNAVertexFormat::GetTexCoordsOffset() const
+{
+	return texCoordsOffset;
+}
+
+int LUNAVertexFormat::GetTextureIndexOffset() const
+{
+	return textureIndexOffset;
+}
+
+// Check for vertexes have texture index for multi-texture batching
+bool LUNAVertexFormat::HasTextureIndex() const
+{
+	return textureIndexOffset != -1;
+}
+
+GLenum LUNAVertexFormat::GetColorGlType() const
+{
+	return IsColorNormalized() ? GL_UNSIGNED_BYTE : GL_FLOAT;
+}
+
+GLenum LUNAVertexFormat::GetTexCoordsGlType() const
+{
+	return IsTexCoordsNormalized() ? GL_UNSIGNED_SHORT : GL_FLOAT;
+}
+
+bool LUNAVertexFormat::IsColorNormalized() const
+{
+	return type != LUNAVertexFormatType::FLOAT;
+}
+
+bool LUNAVertexFormat::IsTexCoordsNormalized() const
+{
+	return type == LUNAVertexFormatType::PACKED;
+}
+
+// Check for given texture coordinates can be stored without clamping
+// Normalized texture coordinates are limited by range [0.0f, 1.0f], so repeated textures need float texture coordinates
+bool LUNAVertexFormat::CanStoreTexCoords(float u, float v) const
+{
+	if(!IsTexCoordsNormalized()) return true;
+	return u >= 0.0f && u <= 1.0f && v >= 0.0f && v <= 1.0f;
+}
+
+// Get format with same layout of position, color and texture index, but with float texture coordinates
+LUNAVertexFormat LUNAVertexFormat::GetFloatTexCoordsFormat() const
+{
+	if(!IsTexCoordsNormalized()) return *this;
+	return LUNAVertexFormat(LUNAVertexFormatType::PACKED_COLOR, HasTextureIndex());
+}
+
+// Get count of vertexes in given vertex data
+size_t LUNAVertexFormat::GetVertexCount(const std::vector<unsigned char>& vertexData) const
+{
+	return vertexData.size() / stride;
+}
+
+// Write vertex to given pointer. Pointer must have at least "GetStride()" bytes
+void LUNAVertexFormat::WriteVertex(unsigned char* dest, float x, float y, const LUNAColor& color, float u, float v,
+	int textureIndex) const
+{
+	// Position
+	float pos[2] = { x, y };
+	std::memcpy(dest, pos, sizeof(pos));
+
+	// Color
+	if(IsColorNormalized())
+	{
+		GLubyte packedColor[4] =
+		{
+			PackNormalized<GLubyte>(color.r),
+			PackNormalized<GLubyte>(color.g),
+			PackNormalized<GLubyte>(color.b),
+			PackNormalized<GLubyte>(color.a),
+		};
+		std::memcpy(dest + colorOffset, packedColor, sizeof(packedColor));
+	}
+	else
+	{
+		float floatColor[4] = { color.r, color.g, color.b, color.a };
+		std::memcpy(dest + colorOffset, floatColor, sizeof(floatColor));
+	}
+
+	// Texture coordinates
+	if(IsTexCoordsNormalized())
+	{
+		GLushort packedTexCoords[2] = { PackNormalized<GLushort>(u), PackNormalized<GLushort>(v) };
+		std::memcpy(dest + texCoordsOffset, packedTexCoords, sizeof(packedTexCoords));
+	}
+	else
+	{
+		float texCoords[2] = { u, v };
+		std::memcpy(dest + texCoordsOffset, texCoords, sizeof(texCoords));
+	}
+
+	// Texture index
+	if(HasTextureIndex())
+	{
+		GLubyte packedIndex[4] = { static_cast<GLubyte>(textureIndex), 0, 0, 0 };
+		std::memcpy(dest + textureIndexOffset, packedIndex, sizeof(packedIndex));
+	}
+}
+
+// Append vertex to end of given vertex data
+void LUNAVertexFormat::AppendVertex(std::vector<unsigned char>& vertexData, float x, float y, const LUNAColor& color,
+	float u, float v, int textureIndex) const
+{
+	size_t pos = vertexData.size();
+	vertexData.resize(pos + stride);
+	WriteVertex(&vertexData[pos], x, y, color, u, v, textureIndex);
+}
+
+// Set texture index for given count of vertexes starting from given pointer
+void LUNAVertexFormat::WriteTextureIndex(unsigned char* dest, size_t count, int textureIndex) const
+{
+	if(!HasTextureIndex()) return;
+
+	for(size_t i = 0; i < count; i++) dest[i * stride + textureIndexOffset] = static_cast<unsigned char>(textureIndex);
+}
+
+// Read position of vertex with given index
+void LUNAVertexFormat::ReadPosition(const std::vector<unsigned char>& vertexData, size_t index, float& x, float& y) const
+{
+	float pos[2];
+	std::memcpy(pos, &vertexData[index * stride], sizeof(pos));
+
+	x = pos[0];
+	y = pos[1];
+}
+
+// Read vertex with given index
+void LUNAVertexFormat::ReadVertex(const std::vector<unsigned char>& vertexData, size_t index, float& x, float& y,
+	LUNAColor& color, float& u, float& v) const
+{
+	const unsigned char* src = &vertexData[index * stride];
+
+	// Position
+	float pos[2];
+	std::memcpy(pos, src, sizeof(pos));
+	x = pos[0];
+	y = pos[1];
+
+	// Color
+	if(IsColorNormalized())
+	{
+		GLubyte packedColor[4];
+		std::memcpy(packedColor, src + colorOffset, sizeof(packedColor));
+		color = LUNAColor::RgbFloat(UnpackNormalized(packedColor[0]), UnpackNormalized(packedColor[1]),
+			UnpackNormalized(packedColor[2]), UnpackNormalized(packedColor[3]));
+	}
+	else
+	{
+		float floatColor[4];
+		std::memcpy(floatColor, src + colorOffset, sizeof(floatColor));
+		color = LUNAColor::RgbFloat(floatColor[0], floatColor[1], floatColor[2], floatColor[3]);
+	}
+
+	// Texture coordinates
+	if(IsTexCoordsNormalized())
+	{
+		GLushort packedTexCoords[2];
+		std::memcpy(packedTexCoords, src + texCoordsOffset, sizeof(packedTexCoords));
+		u = UnpackNormalized(packedTexCoords[0]);
+		v = UnpackNormalized(packedTexCoords[1]);
+	}
+	else
+	{
+		float texCoords[2];
+		std::memcpy(texCoords, src + texCoordsOffset, sizeof(texCoords));
+		u = texCoords[0];
+		v = texCoords[1];
+	}
+}
@@ -0,0 +1,95 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunagl.h"
+#include "lunacolor.h"
+#include "lunavertexformattype.h"
+
+namespace luna2d{
+
+//-------------------------------------------------------
+// Layout of vertex data in batches and vertex arrays.
+// Position is always stored as two floats at offset 0
+// Optional texture index is stored as unsigned byte
+// padded to 4 bytes at the end of vertex
+//-------------------------------------------------------
+class LUNAVertexFormat
+{
+public:
+	LUNAVertexFormat(LUNAVertexFormatType type = LUNAVertexFormatType::PACKED_COLOR, bool textureIndex = false);
+
+private:
+	LUNAVertexFormatType type;
+	int stride; // Size of one vertex (in bytes)
+	int colorOffset;
+	int texCoordsOffset;
+	int textureIndexOffset = -1;
+
+public:
+	LUNAVertexFormatType GetType() const;
+	int GetStride() const;
+	int GetColorOffset() const;
+	int GetTexCoordsOffset() const;
+	int GetTextureIndexOffset() const;
+
+	// Check for vertexes have texture index for multi-texture batching
+	bool HasTextureIndex() const;
+
+	// GL types of attributes
+	GLenum GetColorGlType() const;
+	GLenum GetTexCoordsGlType() const;
+	bool IsColorNormalized() const;
+	bool IsTexCoordsNormalized() const;
+
+	// Check for given texture coordinates can be stored without clamping
+	// Normalized texture coordinates are limited by range [0.0f, 1.0f], so repeated textures need float texture coordinates
+	bool CanStoreTexCoords(float u, float v) const;
+
+	// Get format with same layout of position, color and texture index, but with float texture coordinates
+	LUNAVertexFormat GetFloatTexCoordsFormat() const;
+
+	// Get count of vertexes in given vertex data
+	size_t GetVertexCount(const std::vector<unsigned char>& vertexData) const;
+
+	// Write vertex to given pointer. Pointer must have at least "GetStride()" bytes
+	void WriteVertex(unsigned char* dest, float x, float y, const LUNAColor& color, float u, float v,
+		int textureIndex = 0) const;
+
+	// Append vertex to end of given vertex data
+	void AppendVertex(std::vector<unsigned char>& vertexData, float x, float y, const LUNAColor& color, float u, float v,
+		int textureIndex = 0) const;
+
+	// Set texture index for given count of vertexes starting from given pointer
+	void WriteTextureIndex(unsigned char* dest, size_t count, int textureIndex) const;
+
+	// Read position of vertex with given index
+	void ReadPosition(const std::vector<unsigned char>& vertexData, size_t index, float& x, float& y) const;
+
+	// Read vertex with given index
+	void ReadVertex(const std::vector<unsigned char>& vertexData, size_t index, float& x, float& y, LUNAColor& color,
+		float& u, float& v) const;
+};
+
+}
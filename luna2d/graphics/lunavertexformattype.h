@@ -0,0 +1,46 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "lunastringenum.h"
+
+namespace luna2d{
+
+enum class LUNAVertexFormatType
+{
+	FLOAT, // Position, color and texture coordinates as floats (32 bytes per vertex)
+	PACKED_COLOR, // Color as normalized unsigned bytes (20 bytes per vertex)
+	// Color as normalized unsigned bytes, texture coordinates as normalized unsigned shorts (16 bytes per vertex)
+	// Meshes with texture coordinates out of range [0, 1] are stored in "PACKED_COLOR" layout
+	PACKED,
+};
+
+const LUNAStringEnum<LUNAVertexFormatType> VERTEX_FORMAT =
+{
+	"float",
+	"packedColor",
+	"packed",
+};
+
+}
@@ -149,7 +149,26 @@ void LUNAParticleSystem::Update(float dt)
 	}
 }
 
+// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+// SEE: "LUNARenderer::SetLayer"
+int LUNAParticleSystem::GetLayer()
+{
+	return layer;
+}
+
+void LUNAParticleSystem::SetLayer(int layer)
+{
+	if(layer < RENDER_QUEUE_MIN_LAYER || layer > RENDER_QUEUE_MAX_LAYER) LUNA_RETURN_ERR("Invalid layer %d", layer);
+
+	this->layer = layer;
+}
+
 void LUNAParticleSystem::Render()
 {
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	int baseLayer = renderer->GetLayer();
+
+	renderer->SetLayer(baseLayer + layer);
 	for(auto& emitter : emitters) emitter->Render();
+	renderer->SetLayer(baseLayer);
 }
@@ -40,6 +40,7 @@ private:
 	glm::vec2 pos;
 	bool loop = false;
 	bool running = true;
+	int layer = 0;
 	std::vector<std::shared_ptr<LUNAParticleEmitter>> emitters;
 
 public:
@@ -56,6 +57,10 @@ public:
 	void Start(); // Start or resume emitting
 	void Pause(); // Stop emitting without reset duration
 	void Stop(); // Stop emitting
+	// Layer of object relative to current renderer layer, can be negative. Used only in deferred render mode
+	// SEE: "LUNARenderer::SetLayer"
+	int GetLayer();
+	void SetLayer(int layer);
 	void Update(float dt);
 	void Render();
 };
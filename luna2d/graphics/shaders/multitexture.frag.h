@@ -0,0 +1,47 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+//--------------------------------------------------------------
+// Fragment shader for multi-texture batching.
+// "MAX_TEXTURES" should be defined before compiling the shader.
+// Samplers can be indexed only by loop index in GLSL ES
+//--------------------------------------------------------------
+const std::string MULTITEXTURE_FRAG_SHADER =
+R"(uniform sampler2D u_textures[MAX_TEXTURES];
+
+varying lowp vec4 v_color;
+varying vec2 v_texCoords;
+varying float v_textureIndex;
+
+void main()
+{
+	vec4 texColor = vec4(0.0);
+	for(int i = 0; i < MAX_TEXTURES; i++)
+	{
+		if(abs(float(i) - v_textureIndex) < 0.5) texColor = texture2D(u_textures[i], v_texCoords);
+	}
+
+	gl_FragColor = v_color * texColor;
+})";
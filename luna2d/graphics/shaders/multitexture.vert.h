@@ -0,0 +1,48 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------
+// Vertex shader for multi-texture batching.
+// Same as default shader with texture index added
+//------------------------------------------------
+const std::string MULTITEXTURE_VERT_SHADER =
+R"(uniform mat4 u_transformMatrix;
+
+attribute vec4 a_position;
+attribute vec4 a_color;
+attribute vec2 a_texCoords;
+attribute float a_textureIndex;
+
+varying vec4 v_color;
+varying vec2 v_texCoords;
+varying float v_textureIndex;
+
+void main()
+{
+	v_color = a_color;
+	v_texCoords = a_texCoords;
+	v_textureIndex = a_textureIndex;
+	gl_Position = u_transformMatrix * a_position;
+})";
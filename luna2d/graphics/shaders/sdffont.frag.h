@@ -0,0 +1,62 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+//-----------------------------------------------------------
+// Fragment shader for signed distance field fonts
+// Used with vertex shader for fonts. Edge of glyph is stored
+// in texture as 0.5. Edge is smoothed by one screen pixel
+// when derivatives are supported, otherwise by fixed width
+// Extension directive is unconditional and goes first, because
+// it must precede default precision inserted to source
+//-----------------------------------------------------------
+const std::string SDF_FONT_FRAG_SHADER =
+R"(#extension GL_OES_standard_derivatives : enable
+
+#ifdef GL_ES
+#ifdef GL_OES_standard_derivatives
+#define HAS_DERIVATIVES
+#endif
+#else
+#define HAS_DERIVATIVES
+#endif
+
+uniform sampler2D u_texture;
+
+varying lowp vec4 v_color;
+varying vec2 v_texCoords;
+
+void main()
+{
+	float distance = texture2D(u_texture, v_texCoords).a;
+
+#ifdef HAS_DERIVATIVES
+	float smoothing = max(fwidth(distance) * 0.7, 0.001);
+#else
+	float smoothing = 0.05;
+#endif
+
+	float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+	gl_FragColor = v_color * vec4(1.0, 1.0, 1.0, alpha);
+})";
@@ -89,6 +89,21 @@ struct LuaStack<float>
 	}
 };
 
+template<>
+struct LuaStack<double>
+{
+	static void Push(lua_State* luaVm, double arg)
+	{
+		lua_pushnumber(luaVm, arg);
+	}
+
+	static double Pop(lua_State* luaVm, int index = -1)
+	{
+		if(!lua_isnumber(luaVm, index)) return 0;
+		return lua_tonumber(luaVm, index);
+	}
+};
+
 template<>
 struct LuaStack<bool>
 {
@@ -124,6 +124,10 @@ void LUNAEngine::Deinitialize()
 	delete services;
 	delete assets;
 	delete graphics;
+
+	// Lua objects collected on deleting Lua state check for graphics is still alive
+	graphics = nullptr;
+
 	delete scenes;
 	delete audio;
 	delete sizes;
@@ -141,7 +145,6 @@ void LUNAEngine::Deinitialize()
 	delete log;
 
 	assets = nullptr;
-	graphics = nullptr;
 	scenes = nullptr;
 	audio = nullptr;
 	sizes = nullptr;
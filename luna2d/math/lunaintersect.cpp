@@ -40,6 +40,13 @@ bool luna2d::intersect::PointInCircle(const glm::vec2& point, const glm::vec2& c
 	return glm::distance2(point, circleCenter) <= r * r;
 }
 
+// Check for rectangle fully inside other rectangle
+bool luna2d::intersect::RectangleInRectangle(const LUNARect& rect, const LUNARect& outerRect)
+{
+	return rect.x >= outerRect.x && rect.x + rect.width <= outerRect.x + outerRect.width &&
+		rect.y >= outerRect.y && rect.y + rect.height <= outerRect.y + outerRect.height;
+}
+
 // Check for point inside polygon
 bool luna2d::intersect::PointInPolygon(const glm::vec2& point, const std::vector<glm::vec2>& polygon)
 {
@@ -34,6 +34,9 @@ namespace luna2d{ namespace intersect{
 // Check for point insinde in rectangle
 bool PointInRectangle(const glm::vec2& point, const LUNARect& rect);
 
+// Check for rectangle fully inside other rectangle
+bool RectangleInRectangle(const LUNARect& rect, const LUNARect& outerRect);
+
 // Check for point insinde in cirle
 bool PointInCircle(const glm::vec2& point, const glm::vec2& circleCenter, float r);
 
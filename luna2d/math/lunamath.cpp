@@ -25,6 +25,14 @@
 #include "lunalog.h"
 #include <random>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#include <xmmintrin.h>
+	#define LUNA_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#include <arm_neon.h>
+	#define LUNA_SIMD_NEON
+#endif
+
 using namespace luna2d;
 using namespace luna2d::math;
 
@@ -131,3 +139,41 @@ float luna2d::math::AngleBetweenr(const glm::vec2& vec1, const glm::vec2& vec2)
 	else
 		return glm::orientedAngle(glm::vec2(1.0f, 0.0f), glm::normalize(angleVec));
 }
+
+// Rotate four corners of quad by angle given with its sine and cosine, then translate them by (x,y)
+// Input corners are given as separate arrays of X and Y coordinates. Uses SSE or NEON when available
+void luna2d::math::TransformQuad(const float* xs, const float* ys, float sin, float cos, float x, float y, glm::vec2* out)
+{
+	static_assert(sizeof(glm::vec2) == sizeof(float) * 2, "Array of glm::vec2 is written as array of floats");
+
+#if defined(LUNA_SIMD_SSE)
+	__m128 vx = _mm_loadu_ps(xs);
+	__m128 vy = _mm_loadu_ps(ys);
+	__m128 vsin = _mm_set1_ps(sin);
+	__m128 vcos = _mm_set1_ps(cos);
+
+	__m128 rx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vx, vcos), _mm_mul_ps(vy, vsin)), _mm_set1_ps(x));
+	__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vsin), _mm_mul_ps(vy, vcos)), _mm_set1_ps(y));
+
+	// Interleave coordinates to pairs
+	float* dest = &out[0].x;
+	_mm_storeu_ps(dest, _mm_unpacklo_ps(rx, ry));
+	_mm_storeu_ps(dest + 4, _mm_unpackhi_ps(rx, ry));
+#elif defined(LUNA_SIMD_NEON)
+	float32x4_t vx = vld1q_f32(xs);
+	float32x4_t vy = vld1q_f32(ys);
+
+	float32x4x2_t result;
+	result.val[0] = vaddq_f32(vmlsq_n_f32(vmulq_n_f32(vx, cos), vy, sin), vdupq_n_f32(x));
+	result.val[1] = vaddq_f32(vmlaq_n_f32(vmulq_n_f32(vx, sin), vy, cos), vdupq_n_f32(y));
+
+	// Interleave coordinates to pairs
+	vst2q_f32(&out[0].x, result);
+#else
+	for(int i = 0; i < 4; i++)
+	{
+		out[i].x = xs[i] * cos - ys[i] * sin + x;
+		out[i].y = xs[i] * sin + ys[i] * cos + y;
+	}
+#endif
+}
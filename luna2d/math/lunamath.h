@@ -84,4 +84,8 @@ float AngleBetween(const glm::vec2& vec1, const glm::vec2& vec2);
 // Get angle between given vectors (in radians)
 float AngleBetweenr(const glm::vec2& vec1, const glm::vec2& vec2);
 
+// Rotate four corners of quad by angle given with its sine and cosine, then translate them by (x,y)
+// Input corners are given as separate arrays of X and Y coordinates. Uses SSE or NEON when available
+void TransformQuad(const float* xs, const float* ys, float sin, float cos, float x, float y, glm::vec2* out);
+
 }}
@@ -26,7 +26,6 @@
 #include "lunaengine.h"
 #include "lunagraphics.h"
 #include "lunalog.h"
-#include "lunamath.h"
 
 using namespace luna2d;
 
@@ -63,22 +62,16 @@ void LUNAPhysicsDebugRenderer::DrawPolygon(const b2Vec2* vertexes, int32 vertexC
 
 void LUNAPhysicsDebugRenderer::DrawSolidPolygon(const b2Vec2* vertexes, int32 vertexCount, const b2Color& b2dColor)
 {
-	LUNAColor color = FromB2Color(b2dColor);
-	for(int i = 0; i < vertexCount - 1; i++)
-	{
-		float x1 = LUNAPhysicsUtils::MetersToPixels(vertexes[i].x);
-		float y1 = LUNAPhysicsUtils::MetersToPixels(vertexes[i].y);
-		float x2 = LUNAPhysicsUtils::MetersToPixels(vertexes[i + 1].x);
-		float y2 = LUNAPhysicsUtils::MetersToPixels(vertexes[i + 1].y);
+	std::vector<glm::vec2> points;
+	points.reserve(vertexCount);
 
-		LUNAEngine::SharedGraphics()->GetRenderer()->RenderLine(x1, y1, x2, y2, color);
+	for(int i = 0; i < vertexCount; i++)
+	{
+		points.push_back(glm::vec2(LUNAPhysicsUtils::MetersToPixels(vertexes[i].x),
+			LUNAPhysicsUtils::MetersToPixels(vertexes[i].y)));
 	}
-	LUNAEngine::SharedGraphics()->GetRenderer()->RenderLine(
-		LUNAPhysicsUtils::MetersToPixels(vertexes[vertexCount - 1].x),
-		LUNAPhysicsUtils::MetersToPixels(vertexes[vertexCount - 1].y),
-		LUNAPhysicsUtils::MetersToPixels(vertexes[0].x),
-		LUNAPhysicsUtils::MetersToPixels(vertexes[0].y),
-		color);
+
+	LUNAEngine::SharedGraphics()->GetRenderer()->RenderPolyline(points, FromB2Color(b2dColor), true);
 }
 
 void LUNAPhysicsDebugRenderer::DrawCircle(const b2Vec2& center, float32 radius, const b2Color& b2dColor)
@@ -88,19 +81,8 @@ void LUNAPhysicsDebugRenderer::DrawCircle(const b2Vec2& center, float32 radius,
 
 void LUNAPhysicsDebugRenderer::DrawSolidCircle(const b2Vec2& center, float32 radius, const b2Vec2& axis, const b2Color& b2dColor)
 {
-	LUNAColor color = FromB2Color(b2dColor);
-
-	for(int angle = 0; angle < 360; angle += 10)
-	{
-		float angle1 = math::DegreesToRadians(angle);
-		float angle2 = math::DegreesToRadians(angle + 10);
-		float x1 = LUNAPhysicsUtils::MetersToPixels(center.x + radius * std::cos(angle1));
-		float y1 = LUNAPhysicsUtils::MetersToPixels(center.y + radius * std::sin(angle1));
-		float x2 = LUNAPhysicsUtils::MetersToPixels(center.x + radius * std::cos(angle2));
-		float y2 = LUNAPhysicsUtils::MetersToPixels(center.y + radius * std::sin(angle2));
-
-		LUNAEngine::SharedGraphics()->GetRenderer()->RenderLine(x1, y1, x2, y2, color);
-	}
+	LUNAEngine::SharedGraphics()->GetRenderer()->RenderCircle(LUNAPhysicsUtils::MetersToPixels(center.x),
+		LUNAPhysicsUtils::MetersToPixels(center.y), LUNAPhysicsUtils::MetersToPixels(radius), FromB2Color(b2dColor));
 }
 
 void LUNAPhysicsDebugRenderer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& b2dColor)
@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaal.h"
+
+//-------------------------------------------------------------------
+// Silent OpenAL implementation for headless platform
+// Implements only functions used by audio module. Sources are never
+// playing, so audio module releases them as stopped
+//-------------------------------------------------------------------
+
+namespace{
+
+char dummyDevice;
+char dummyContext;
+ALuint lastId = 0;
+
+}
+
+extern "C"{
+
+ALCdevice* ALC_APIENTRY alcOpenDevice(const ALCchar* devicename)
+{
+	return reinterpret_cast<ALCdevice*>(&dummyDevice);
+}
+
+ALCboolean ALC_APIENTRY alcCloseDevice(ALCdevice* device)
+{
+	return ALC_TRUE;
+}
+
+ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice* device, const ALCint* attrlist)
+{
+	return reinterpret_cast<ALCcontext*>(&dummyContext);
+}
+
+ALCboolean ALC_APIENTRY alcMakeContextCurrent(ALCcontext* context)
+{
+	return ALC_TRUE;
+}
+
+void ALC_APIENTRY alcDestroyContext(ALCcontext* context)
+{
+}
+
+void AL_APIENTRY alGenSources(ALsizei n, ALuint* sources)
+{
+	for(int i = 0; i < n; i++) sources[i] = ++lastId;
+}
+
+void AL_APIENTRY alDeleteSources(ALsizei n, const ALuint* sources)
+{
+}
+
+ALboolean AL_APIENTRY alIsSource(ALuint source)
+{
+	return source != 0 && source <= lastId ? AL_TRUE : AL_FALSE;
+}
+
+void AL_APIENTRY alSourcef(ALuint source, ALenum param, ALfloat value)
+{
+}
+
+void AL_APIENTRY alSourcei(ALuint source, ALenum param, ALint value)
+{
+}
+
+void AL_APIENTRY alGetSourcei(ALuint source, ALenum param, ALint* value)
+{
+	if(param == AL_SOURCE_STATE) *value = AL_STOPPED;
+	else *value = 0;
+}
+
+void AL_APIENTRY alSourcePlay(ALuint source)
+{
+}
+
+void AL_APIENTRY alSourceStop(ALuint source)
+{
+}
+
+void AL_APIENTRY alSourceRewind(ALuint source)
+{
+}
+
+void AL_APIENTRY alSourcePause(ALuint source)
+{
+}
+
+void AL_APIENTRY alGenBuffers(ALsizei n, ALuint* buffers)
+{
+	for(int i = 0; i < n; i++) buffers[i] = ++lastId;
+}
+
+void AL_APIENTRY alDeleteBuffers(ALsizei n, const ALuint* buffers)
+{
+}
+
+void AL_APIENTRY alBufferData(ALuint buffer, ALenum format, const ALvoid* data, ALsizei size, ALsizei freq)
+{
+}
+
+}
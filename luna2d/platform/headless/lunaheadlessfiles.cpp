@@ -0,0 +1,238 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaheadlessfiles.h"
+#include "lunalog.h"
+#include <cstdio>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <zlib.h>
+
+using namespace luna2d;
+
+LUNAHeadlessFiles::LUNAHeadlessFiles(const std::string& gamePath, const std::string& appPath) :
+	gamePath(gamePath),
+	appPath(appPath)
+{
+	// Append slash to end of paths if it not exists in given paths
+	if(this->gamePath.empty() || this->gamePath.back() != '/') this->gamePath.append("/");
+	if(this->appPath.empty() || this->appPath.back() != '/') this->appPath.append("/");
+}
+
+// Convert given path in a path relative to root directory of given location
+std::string LUNAHeadlessFiles::GetPathInLocation(const std::string& path, LUNAFileLocation location)
+{
+	return GetRootFolder(location) + path;
+}
+
+// Create all missing folders in path of given file
+bool LUNAHeadlessFiles::MakeFolders(const std::string& filePath)
+{
+	for(size_t pos = filePath.find('/', 1); pos != std::string::npos; pos = filePath.find('/', pos + 1))
+	{
+		std::string folder = filePath.substr(0, pos);
+
+		struct stat info;
+		if(stat(folder.c_str(), &info) == 0) continue;
+		if(mkdir(folder.c_str(), 0755) != 0) return false;
+	}
+
+	return true;
+}
+
+// Get root folder for file location
+std::string LUNAHeadlessFiles::GetRootFolder(LUNAFileLocation location)
+{
+	switch(location)
+	{
+	case LUNAFileLocation::ASSETS:
+		return gamePath;
+
+	case LUNAFileLocation::APP_FOLDER:
+		return appPath;
+
+	case LUNAFileLocation::CACHE:
+		return appPath + "cache/";
+	}
+
+	return "";
+}
+
+// Check for given path is file
+bool LUNAHeadlessFiles::IsFile(const std::string& path, LUNAFileLocation location)
+{
+	struct stat info;
+	if(stat(GetPathInLocation(path, location).c_str(), &info) != 0) return false;
+
+	return S_ISREG(info.st_mode);
+}
+
+// Check for given path is directory
+bool LUNAHeadlessFiles::IsDirectory(const std::string& path, LUNAFileLocation location)
+{
+	struct stat info;
+	if(stat(GetPathInLocation(path, location).c_str(), &info) != 0) return false;
+
+	return S_ISDIR(info.st_mode);
+}
+
+// Check for path is exists
+bool LUNAHeadlessFiles::IsExists(const std::string& path, LUNAFileLocation location)
+{
+	struct stat info;
+	return stat(GetPathInLocation(path, location).c_str(), &info) == 0;
+}
+
+// Get list of files and subdirectories in given directory
+std::vector<std::string> LUNAHeadlessFiles::GetFileList(const std::string& path, LUNAFileLocation location)
+{
+	std::vector<std::string> ret;
+
+	std::string folder = GetPathInLocation(path, location);
+	DIR* dir = opendir(folder.c_str());
+	if(!dir) return ret; // Return empty file list
+
+	if(!folder.empty() && folder.back() != '/') folder.append("/");
+
+	while(dirent* entry = readdir(dir))
+	{
+		std::string name = entry->d_name;
+		if(name == "." || name == "..") continue;
+
+		struct stat info;
+		if(stat((folder + name).c_str(), &info) == 0 && S_ISDIR(info.st_mode)) ret.push_back(name + "/");
+		else ret.push_back(name);
+	}
+
+	closedir(dir);
+
+	return ret;
+}
+
+// Get size of file
+ssize_t LUNAHeadlessFiles::GetFileSize(const std::string& path, LUNAFileLocation location)
+{
+	struct stat info;
+	if(stat(GetPathInLocation(path, location).c_str(), &info) != 0 || !S_ISREG(info.st_mode)) return -1;
+
+	return info.st_size;
+}
+
+// Read all file data
+std::vector<unsigned char> LUNAHeadlessFiles::ReadFile(const std::string& path, LUNAFileLocation location)
+{
+	std::vector<unsigned char> ret;
+
+	ssize_t size = GetFileSize(path, location);
+	if(size <= 0) return ret;
+
+	FILE* file = fopen(GetPathInLocation(path, location).c_str(), "rb");
+	if(!file) return ret;
+
+	ret.resize(size);
+	if(fread(&ret[0], sizeof(unsigned char), size, file) != (size_t)size) ret.clear();
+	fclose(file);
+
+	return ret;
+}
+
+// Read all file data as string
+std::string LUNAHeadlessFiles::ReadFileToString(const std::string& path, LUNAFileLocation location)
+{
+	std::vector<unsigned char> data = ReadFile(path, location);
+	return std::string(data.begin(), data.end());
+}
+
+// Write given byte buffer to file
+bool LUNAHeadlessFiles::WriteFile(const std::string& path, const std::vector<unsigned char>& data, LUNAFileLocation location)
+{
+	// Assets folder is readonly
+	if(location == LUNAFileLocation::ASSETS) return false;
+
+	std::string filePath = GetPathInLocation(path, location);
+	if(!MakeFolders(filePath)) return false;
+
+	FILE* file = fopen(filePath.c_str(), "wb");
+	if(!file) return false;
+
+	bool success = fwrite(data.data(), sizeof(unsigned char), data.size(), file) == data.size();
+	fclose(file);
+
+	return success;
+}
+
+// Write given text data to file
+bool LUNAHeadlessFiles::WriteFileFromString(const std::string& path, const std::string& data, LUNAFileLocation location)
+{
+	return WriteFile(path, std::vector<unsigned char>(data.begin(), data.end()), location);
+}
+
+// Read all data from file compressed using "Deflate" algorithm
+std::vector<unsigned char> LUNAHeadlessFiles::ReadCompressedFile(const std::string& path, LUNAFileLocation location)
+{
+	const int BLOCK_SIZE = 4096;
+	std::vector<unsigned char> ret;
+
+	gzFile file = gzopen(GetPathInLocation(path, location).c_str(), "rb");
+	if(!file) return ret;
+
+	// Size of decompressed data is unknown, so data is read per block until end of file
+	while(true)
+	{
+		ret.resize(ret.size() + BLOCK_SIZE);
+		int bytesRead = gzread(file, &ret[ret.size() - BLOCK_SIZE], BLOCK_SIZE);
+
+		if(bytesRead < 0)
+		{
+			ret.clear();
+			break;
+		}
+
+		if(bytesRead < BLOCK_SIZE)
+		{
+			ret.resize(ret.size() - BLOCK_SIZE + bytesRead);
+			break;
+		}
+	}
+
+	gzclose(file);
+	return ret;
+}
+
+// Write given byte buffer to file and compress it with "Deflate" algorithm
+bool LUNAHeadlessFiles::WriteCompressedFile(const std::string& path, const std::vector<unsigned char>& data, LUNAFileLocation location)
+{
+	// Assets folder is readonly
+	if(location == LUNAFileLocation::ASSETS) return false;
+
+	std::string filePath = GetPathInLocation(path, location);
+	if(!MakeFolders(filePath)) return false;
+
+	gzFile file = gzopen(filePath.c_str(), "wb");
+	if(!file) return false;
+
+	bool success = gzwrite(file, data.data(), data.size()) == (int)data.size();
+	gzclose(file);
+
+	return success;
+}
@@ -0,0 +1,1554 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaheadlessgl.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace luna2d;
+
+namespace{
+
+const int MAX_TEXTURE_UNITS = 16;
+const int MAX_VERTEX_ATTRIBS = 16;
+const int MAX_TEXTURE_SIZE = 4096;
+const GLint UNIFORM_LOCATIONS_STEP = 64; // Reserved locations for each uniform to fit arrays
+
+struct Texture
+{
+	int width = 0;
+	int height = 0;
+	GLenum format = GL_RGBA;
+	bool compressed = false;
+	std::vector<unsigned char> pixels; // RGBA pixels starting from bottom row. Empty for compressed textures
+};
+
+struct Shader
+{
+	GLenum type = GL_VERTEX_SHADER;
+	std::string source;
+	bool compiled = false;
+};
+
+struct Program
+{
+	std::vector<GLuint> shaders;
+	bool linked = false;
+	std::unordered_map<std::string, GLint> attribs;
+	std::unordered_map<std::string, GLint> uniforms;
+	std::unordered_map<GLint, std::vector<float>> uniformValues;
+};
+
+struct VertexAttrib
+{
+	bool enabled = false;
+	GLint size = 4;
+	GLenum type = GL_FLOAT;
+	bool normalized = false;
+	GLsizei stride = 0;
+	const GLvoid* pointer = nullptr;
+	GLuint buffer = 0;
+};
+
+struct Context
+{
+	GLuint nextId = 1;
+	GLenum error = GL_NO_ERROR;
+
+	std::unordered_map<GLuint, Texture> textures;
+	std::unordered_map<GLuint, std::vector<unsigned char>> buffers;
+	std::unordered_map<GLuint, Shader> shaders;
+	std::unordered_map<GLuint, Program> programs;
+	std::unordered_map<GLuint, GLuint> framebuffers; // Id of attached texture for each framebuffer
+
+	GLuint program = 0;
+	int activeUnit = 0;
+	GLuint textureUnits[MAX_TEXTURE_UNITS] = {};
+	GLuint arrayBuffer = 0;
+	GLuint elementBuffer = 0;
+	GLuint framebuffer = 0;
+	VertexAttrib attribs[MAX_VERTEX_ATTRIBS];
+
+	bool blend = false;
+	bool scissorTest = false;
+	bool depthTest = false;
+	bool cullFace = false;
+	bool stencilTest = false;
+	GLenum blendSrc = GL_ONE;
+	GLenum blendDst = GL_ZERO;
+
+	GLint viewport[4] = {};
+	GLint scissorBox[4] = {};
+	float clearColor[4] = {};
+	GLint packAlignment = 4;
+	GLint unpackAlignment = 4;
+};
+
+// Vertex after fetching attributes and transforming to window coordinates
+struct RasterVertex
+{
+	float x, y;
+	float color[4];
+	float u, v;
+	float textureIndex;
+};
+
+std::unique_ptr<Context> context(new Context());
+LUNAHeadlessGl::Stats stats;
+bool rasterization = false;
+int defaultWidth = 0;
+int defaultHeight = 0;
+std::vector<unsigned char> defaultPixels;
+
+void RecordCall(bool stateChange = false)
+{
+	stats.calls++;
+	if(stateChange) stats.stateChanges++;
+}
+
+void SetError(GLenum error)
+{
+	if(context->error == GL_NO_ERROR) context->error = error;
+}
+
+GLuint GenId()
+{
+	return context->nextId++;
+}
+
+int GetBytesPerPixel(GLenum format)
+{
+	switch(format)
+	{
+	case GL_ALPHA:
+	case GL_LUMINANCE:
+		return 1;
+	case GL_LUMINANCE_ALPHA:
+		return 2;
+	case GL_RGB:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+// Get size of row in client memory with given alignment
+size_t GetRowSize(int width, GLenum format, GLint alignment)
+{
+	size_t size = width * GetBytesPerPixel(format);
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+// Convert pixel in given format to RGBA
+void UnpackPixel(const unsigned char* src, GLenum format, unsigned char* dest)
+{
+	switch(format)
+	{
+	case GL_ALPHA:
+		dest[0] = dest[1] = dest[2] = 0;
+		dest[3] = src[0];
+		break;
+	case GL_LUMINANCE:
+		dest[0] = dest[1] = dest[2] = src[0];
+		dest[3] = 255;
+		break;
+	case GL_LUMINANCE_ALPHA:
+		dest[0] = dest[1] = dest[2] = src[0];
+		dest[3] = src[1];
+		break;
+	case GL_RGB:
+		std::memcpy(dest, src, 3);
+		dest[3] = 255;
+		break;
+	default:
+		std::memcpy(dest, src, 4);
+		break;
+	}
+}
+
+// Convert RGBA pixel to given format
+void PackPixel(const unsigned char* src, GLenum format, unsigned char* dest)
+{
+	switch(format)
+	{
+	case GL_ALPHA:
+		dest[0] = src[3];
+		break;
+	case GL_LUMINANCE:
+		dest[0] = src[0];
+		break;
+	case GL_LUMINANCE_ALPHA:
+		dest[0] = src[0];
+		dest[1] = src[3];
+		break;
+	case GL_RGB:
+		std::memcpy(dest, src, 3);
+		break;
+	default:
+		std::memcpy(dest, src, 4);
+		break;
+	}
+}
+
+// Copy client pixels into region of texture
+void WriteTexturePixels(Texture& texture, int x, int y, int width, int height, GLenum format, const GLvoid* pixels)
+{
+	if(!pixels) return;
+
+	size_t rowSize = GetRowSize(width, format, context->unpackAlignment);
+	int bpp = GetBytesPerPixel(format);
+	const unsigned char* src = static_cast<const unsigned char*>(pixels);
+
+	for(int row = 0; row < height; row++)
+	{
+		for(int col = 0; col < width; col++)
+		{
+			int destX = x + col;
+			int destY = y + row;
+			if(destX < 0 || destY < 0 || destX >= texture.width || destY >= texture.height) continue;
+
+			UnpackPixel(src + row * rowSize + col * bpp, format, &texture.pixels[(destY * texture.width + destX) * 4]);
+		}
+	}
+}
+
+Texture* GetBoundTexture()
+{
+	auto it = context->textures.find(context->textureUnits[context->activeUnit]);
+	return it != context->textures.end() ? &it->second : nullptr;
+}
+
+std::vector<unsigned char>* GetBoundBuffer(GLenum target)
+{
+	GLuint id = target == GL_ARRAY_BUFFER ? context->arrayBuffer : context->elementBuffer;
+	auto it = context->buffers.find(id);
+	return it != context->buffers.end() ? &it->second : nullptr;
+}
+
+Program* GetProgram(GLuint id)
+{
+	auto it = context->programs.find(id);
+	return it != context->programs.end() ? &it->second : nullptr;
+}
+
+// Get color buffer of currently bound framebuffer
+// Returns nullptr if framebuffer has no storage
+unsigned char* GetColorBuffer(int& width, int& height)
+{
+	if(context->framebuffer == 0)
+	{
+		width = defaultWidth;
+		height = defaultHeight;
+		return defaultPixels.empty() ? nullptr : &defaultPixels[0];
+	}
+
+	auto fbIt = context->framebuffers.find(context->framebuffer);
+	if(fbIt == context->framebuffers.end()) return nullptr;
+
+	auto texIt = context->textures.find(fbIt->second);
+	if(texIt == context->textures.end() || texIt->second.pixels.empty()) return nullptr;
+
+	width = texIt->second.width;
+	height = texIt->second.height;
+	return &texIt->second.pixels[0];
+}
+
+// Collect names of declarations with given qualifier ("attribute" or "uniform") from shader source
+void ParseDeclarations(const std::string& source, const std::string& qualifier, std::vector<std::string>& names)
+{
+	std::string text = source;
+	std::replace_if(text.begin(), text.end(), [](char c) { return c == ';' || c == '{' || c == '}' || c == ','; }, ' ');
+
+	std::istringstream stream(text);
+	std::string token;
+	while(stream >> token)
+	{
+		if(token != qualifier) continue;
+
+		// Skip precision qualifier and type
+		std::string type, name;
+		stream >> type;
+		if(type == "lowp" || type == "mediump" || type == "highp") stream >> type;
+		stream >> name;
+
+		name = name.substr(0, name.find('['));
+		if(!name.empty()) names.push_back(name);
+	}
+}
+
+std::vector<float>& GetUniformValue(GLint location)
+{
+	static std::vector<float> dummy;
+
+	Program* program = GetProgram(context->program);
+	if(!program || location < 0)
+	{
+		dummy.clear();
+		return dummy;
+	}
+
+	return program->uniformValues[location];
+}
+
+void SetUniform(GLint location, GLsizei count, int components, const float* values)
+{
+	RecordCall(true);
+
+	for(int i = 0; i < count; i++)
+	{
+		std::vector<float>& value = GetUniformValue(location + i);
+		value.assign(values + i * components, values + (i + 1) * components);
+	}
+}
+
+float GetUniform(const Program& program, const std::string& name, int element, float defaultValue)
+{
+	auto it = program.uniforms.find(name);
+	if(it == program.uniforms.end()) return defaultValue;
+
+	auto valueIt = program.uniformValues.find(it->second + element);
+	if(valueIt == program.uniformValues.end() || valueIt->second.empty()) return defaultValue;
+
+	return valueIt->second[0];
+}
+
+// Read attribute of given vertex. Missing components are filled with (0, 0, 0, 1)
+void FetchAttrib(const Program& program, const std::string& name, GLuint vertex, float* out)
+{
+	out[0] = out[1] = out[2] = 0;
+	out[3] = 1;
+
+	auto it = program.attribs.find(name);
+	if(it == program.attribs.end() || it->second >= MAX_VERTEX_ATTRIBS) return;
+
+	const VertexAttrib& attrib = context->attribs[it->second];
+	if(!attrib.enabled) return;
+
+	const unsigned char* base = static_cast<const unsigned char*>(attrib.pointer);
+	if(attrib.buffer != 0)
+	{
+		auto bufferIt = context->buffers.find(attrib.buffer);
+		if(bufferIt == context->buffers.end() || bufferIt->second.empty()) return;
+		base = &bufferIt->second[0] + reinterpret_cast<size_t>(attrib.pointer);
+	}
+	if(!base) return;
+
+	int componentSize = attrib.type == GL_FLOAT ? 4 : (attrib.type == GL_SHORT || attrib.type == GL_UNSIGNED_SHORT ? 2 : 1);
+	int stride = attrib.stride != 0 ? attrib.stride : attrib.size * componentSize;
+	const unsigned char* data = base + vertex * stride;
+
+	for(int i = 0; i < attrib.size && i < 4; i++)
+	{
+		const unsigned char* component = data + i * componentSize;
+
+		switch(attrib.type)
+		{
+		case GL_FLOAT:
+			std::memcpy(&out[i], component, sizeof(float));
+			break;
+		case GL_UNSIGNED_BYTE:
+			out[i] = attrib.normalized ? *component / 255.0f : *component;
+			break;
+		case GL_BYTE:
+		{
+			signed char value = static_cast<signed char>(*component);
+			out[i] = attrib.normalized ? std::max(value / 127.0f, -1.0f) : value;
+			break;
+		}
+		case GL_UNSIGNED_SHORT:
+		{
+			GLushort value;
+			std::memcpy(&value, component, sizeof(value));
+			out[i] = attrib.normalized ? value / 65535.0f : value;
+			break;
+		}
+		case GL_SHORT:
+		{
+			GLshort value;
+			std::memcpy(&value, component, sizeof(value));
+			out[i] = attrib.normalized ? std::max(value / 32767.0f, -1.0f) : value;
+			break;
+		}
+		}
+	}
+}
+
+RasterVertex FetchVertex(const Program& program, GLuint vertex)
+{
+	float pos[4], color[4], texCoords[4], textureIndex[4];
+	FetchAttrib(program, "a_position", vertex, pos);
+	FetchAttrib(program, "a_color", vertex, color);
+	FetchAttrib(program, "a_texCoords", vertex, texCoords);
+	FetchAttrib(program, "a_textureIndex", vertex, textureIndex);
+
+	// Transform position by column-major matrix
+	float matrix[16] = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+	auto matrixIt = program.uniforms.find("u_transformMatrix");
+	if(matrixIt != program.uniforms.end())
+	{
+		auto valueIt = program.uniformValues.find(matrixIt->second);
+		if(valueIt != program.uniformValues.end() && valueIt->second.size() == 16)
+		{
+			std::copy(valueIt->second.begin(), valueIt->second.end(), matrix);
+		}
+	}
+
+	float clip[4];
+	for(int row = 0; row < 4; row++)
+	{
+		clip[row] = 0;
+		for(int col = 0; col < 4; col++) clip[row] += matrix[col * 4 + row] * pos[col];
+	}
+	if(clip[3] == 0) clip[3] = 1;
+
+	const GLint* viewport = context->viewport;
+	RasterVertex ret;
+	ret.x = viewport[0] + (clip[0] / clip[3] + 1.0f) * viewport[2] * 0.5f;
+	ret.y = viewport[1] + (clip[1] / clip[3] + 1.0f) * viewport[3] * 0.5f;
+	std::copy(color, color + 4, ret.color);
+	ret.u = texCoords[0];
+	ret.v = texCoords[1];
+	ret.textureIndex = textureIndex[0];
+
+	return ret;
+}
+
+// Sample texture with nearest filtering and repeat wrapping
+void SampleTexture(const Program& program, float textureIndex, float u, float v, float* out)
+{
+	out[0] = out[1] = out[2] = out[3] = 1;
+
+	int unit;
+	if(program.uniforms.count("u_textures") == 1)
+	{
+		unit = (int)GetUniform(program, "u_textures", (int)std::floor(textureIndex + 0.5f), 0);
+	}
+	else if(program.uniforms.count("u_texture") == 1) unit = (int)GetUniform(program, "u_texture", 0, 0);
+	else return;
+
+	if(unit < 0 || unit >= MAX_TEXTURE_UNITS) return;
+
+	auto it = context->textures.find(context->textureUnits[unit]);
+	if(it == context->textures.end() || it->second.pixels.empty()) return;
+
+	const Texture& texture = it->second;
+	u -= std::floor(u);
+	v -= std::floor(v);
+	int x = std::min((int)(u * texture.width), texture.width - 1);
+	int y = std::min((int)(v * texture.height), texture.height - 1);
+	const unsigned char* texel = &texture.pixels[(y * texture.width + x) * 4];
+
+	// Alpha textures are used only by fonts, where they are sampled as white with alpha
+	bool alphaOnly = texture.format == GL_ALPHA;
+	for(int i = 0; i < 3; i++) out[i] = alphaOnly ? 1.0f : texel[i] / 255.0f;
+	out[3] = texel[3] / 255.0f;
+}
+
+float GetBlendFactor(GLenum factor, const float* src, const float* dst, int component)
+{
+	switch(factor)
+	{
+	case GL_ZERO:
+		return 0;
+	case GL_ONE:
+		return 1;
+	case GL_SRC_COLOR:
+		return src[component];
+	case GL_ONE_MINUS_SRC_COLOR:
+		return 1 - src[component];
+	case GL_SRC_ALPHA:
+		return src[3];
+	case GL_ONE_MINUS_SRC_ALPHA:
+		return 1 - src[3];
+	case GL_DST_ALPHA:
+		return dst[3];
+	case GL_ONE_MINUS_DST_ALPHA:
+		return 1 - dst[3];
+	case GL_DST_COLOR:
+		return dst[component];
+	case GL_ONE_MINUS_DST_COLOR:
+		return 1 - dst[component];
+	default:
+		return 1;
+	}
+}
+
+float Edge(const RasterVertex& a, const RasterVertex& b, float x, float y)
+{
+	return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+}
+
+// Top-left fill rule for counter-clockwise triangles, so pixels on shared edges are drawn once
+bool IsTopLeft(const RasterVertex& a, const RasterVertex& b)
+{
+	float dx = b.x - a.x;
+	float dy = b.y - a.y;
+	return dy < 0 || (dy == 0 && dx < 0);
+}
+
+void RasterizeTriangle(const Program& program, RasterVertex v0, RasterVertex v1, RasterVertex v2,
+	unsigned char* target, int width, int height)
+{
+	float area = Edge(v0, v1, v2.x, v2.y);
+	if(area == 0) return;
+
+	// Make triangle counter-clockwise
+	if(area < 0)
+	{
+		std::swap(v1, v2);
+		area = -area;
+	}
+
+	int minX = std::max(0, (int)std::floor(std::min({ v0.x, v1.x, v2.x })));
+	int minY = std::max(0, (int)std::floor(std::min({ v0.y, v1.y, v2.y })));
+	int maxX = std::min(width - 1, (int)std::ceil(std::max({ v0.x, v1.x, v2.x })));
+	int maxY = std::min(height - 1, (int)std::ceil(std::max({ v0.y, v1.y, v2.y })));
+
+	if(context->scissorTest)
+	{
+		const GLint* box = context->scissorBox;
+		minX = std::max(minX, box[0]);
+		minY = std::max(minY, box[1]);
+		maxX = std::min(maxX, box[0] + box[2] - 1);
+		maxY = std::min(maxY, box[1] + box[3] - 1);
+	}
+
+	bool topLeft0 = IsTopLeft(v1, v2);
+	bool topLeft1 = IsTopLeft(v2, v0);
+	bool topLeft2 = IsTopLeft(v0, v1);
+
+	for(int y = minY; y <= maxY; y++)
+	{
+		for(int x = minX; x <= maxX; x++)
+		{
+			float px = x + 0.5f;
+			float py = y + 0.5f;
+			float w0 = Edge(v1, v2, px, py);
+			float w1 = Edge(v2, v0, px, py);
+			float w2 = Edge(v0, v1, px, py);
+
+			if(w0 < 0 || w1 < 0 || w2 < 0) continue;
+			if((w0 == 0 && !topLeft0) || (w1 == 0 && !topLeft1) || (w2 == 0 && !topLeft2)) continue;
+
+			float l0 = w0 / area;
+			float l1 = w1 / area;
+			float l2 = w2 / area;
+
+			float texel[4];
+			SampleTexture(program, v0.textureIndex,
+				l0 * v0.u + l1 * v1.u + l2 * v2.u, l0 * v0.v + l1 * v1.v + l2 * v2.v, texel);
+
+			float src[4];
+			for(int i = 0; i < 4; i++) src[i] = (l0 * v0.color[i] + l1 * v1.color[i] + l2 * v2.color[i]) * texel[i];
+
+			unsigned char* pixel = target + (y * width + x) * 4;
+			float dst[4];
+			for(int i = 0; i < 4; i++) dst[i] = pixel[i] / 255.0f;
+
+			for(int i = 0; i < 4; i++)
+			{
+				float value = src[i];
+				if(context->blend)
+				{
+					value = src[i] * GetBlendFactor(context->blendSrc, src, dst, i) +
+						dst[i] * GetBlendFactor(context->blendDst, src, dst, i);
+				}
+
+				pixel[i] = (unsigned char)(std::max(0.0f, std::min(value, 1.0f)) * 255.0f + 0.5f);
+			}
+
+			stats.rasterizedPixels++;
+		}
+	}
+}
+
+// Record draw call and rasterize triangles if rasterization enabled
+// "getIndex" returns index of vertex for given element
+template<typename IndexGetter>
+void Draw(GLenum mode, GLsizei count, IndexGetter getIndex)
+{
+	stats.drawCalls++;
+	stats.drawnVertexes += count;
+
+	if(!rasterization) return;
+	if(mode != GL_TRIANGLES && mode != GL_TRIANGLE_STRIP && mode != GL_TRIANGLE_FAN) return;
+
+	Program* program = GetProgram(context->program);
+	if(!program || !program->linked) return;
+
+	int width, height;
+	unsigned char* target = GetColorBuffer(width, height);
+	if(!target) return;
+
+	std::vector<RasterVertex> vertexes;
+	vertexes.reserve(count);
+	for(GLsizei i = 0; i < count; i++) vertexes.push_back(FetchVertex(*program, getIndex(i)));
+
+	if(mode == GL_TRIANGLES)
+	{
+		for(GLsizei i = 0; i + 2 < count; i += 3)
+		{
+			RasterizeTriangle(*program, vertexes[i], vertexes[i + 1], vertexes[i + 2], target, width, height);
+		}
+	}
+	else if(mode == GL_TRIANGLE_STRIP)
+	{
+		for(GLsizei i = 0; i + 2 < count; i++)
+		{
+			RasterizeTriangle(*program, vertexes[i], vertexes[i + 1], vertexes[i + 2], target, width, height);
+		}
+	}
+	else
+	{
+		for(GLsizei i = 1; i + 1 < count; i++)
+		{
+			RasterizeTriangle(*program, vertexes[0], vertexes[i], vertexes[i + 1], target, width, height);
+		}
+	}
+}
+
+}
+
+const LUNAHeadlessGl::Stats& LUNAHeadlessGl::GetStats()
+{
+	return stats;
+}
+
+void LUNAHeadlessGl::ResetStats()
+{
+	stats = Stats();
+}
+
+// Rasterize triangles to CPU buffers of framebuffers and textures
+// Fragments are shaded like default shader: vertex color multiplied by nearest texel
+// Alpha textures are sampled as white with alpha, same as in font shader
+bool LUNAHeadlessGl::IsEnabledRasterization()
+{
+	return rasterization;
+}
+
+void LUNAHeadlessGl::EnableRasterization(bool enable)
+{
+	rasterization = enable;
+}
+
+// Set size of default framebuffer. Default framebuffer has no storage until size is set
+void LUNAHeadlessGl::SetDefaultFramebufferSize(int width, int height)
+{
+	defaultWidth = width;
+	defaultHeight = height;
+	defaultPixels.assign(width * height * 4, 0);
+}
+
+// Delete all objects and reset state, same as after losing GL context
+void LUNAHeadlessGl::Reset()
+{
+	context.reset(new Context());
+}
+
+void LUNAHeadlessGl::ActiveTexture(GLenum texture)
+{
+	RecordCall(true);
+
+	int unit = texture - GL_TEXTURE0;
+	if(unit < 0 || unit >= MAX_TEXTURE_UNITS) SetError(GL_INVALID_ENUM);
+	else context->activeUnit = unit;
+}
+
+void LUNAHeadlessGl::AttachShader(GLuint program, GLuint shader)
+{
+	RecordCall();
+
+	Program* prog = GetProgram(program);
+	if(!prog || context->shaders.count(shader) == 0) SetError(GL_INVALID_VALUE);
+	else prog->shaders.push_back(shader);
+}
+
+void LUNAHeadlessGl::BindBuffer(GLenum target, GLuint buffer)
+{
+	RecordCall(true);
+
+	if(buffer != 0 && context->buffers.count(buffer) == 0) context->buffers[buffer] = std::vector<unsigned char>();
+
+	if(target == GL_ARRAY_BUFFER) context->arrayBuffer = buffer;
+	else if(target == GL_ELEMENT_ARRAY_BUFFER) context->elementBuffer = buffer;
+	else SetError(GL_INVALID_ENUM);
+}
+
+void LUNAHeadlessGl::BindFramebuffer(GLenum target, GLuint framebuffer)
+{
+	RecordCall(true);
+
+	if(target != GL_FRAMEBUFFER) SetError(GL_INVALID_ENUM);
+	else
+	{
+		if(framebuffer != 0 && context->framebuffers.count(framebuffer) == 0) context->framebuffers[framebuffer] = 0;
+		context->framebuffer = framebuffer;
+	}
+}
+
+void LUNAHeadlessGl::BindTexture(GLenum target, GLuint texture)
+{
+	RecordCall(true);
+
+	if(target != GL_TEXTURE_2D) SetError(GL_INVALID_ENUM);
+	else
+	{
+		if(texture != 0 && context->textures.count(texture) == 0) context->textures[texture] = Texture();
+		context->textureUnits[context->activeUnit] = texture;
+	}
+}
+
+void LUNAHeadlessGl::BlendFunc(GLenum sfactor, GLenum dfactor)
+{
+	RecordCall(true);
+
+	context->blendSrc = sfactor;
+	context->blendDst = dfactor;
+}
+
+void LUNAHeadlessGl::BufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
+{
+	RecordCall();
+
+	auto buffer = GetBoundBuffer(target);
+	if(!buffer)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if(data)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		buffer->assign(bytes, bytes + size);
+		stats.uploadedBytes += size;
+	}
+	else buffer->assign(size, 0);
+}
+
+void LUNAHeadlessGl::BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data)
+{
+	RecordCall();
+
+	auto buffer = GetBoundBuffer(target);
+	if(!buffer)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if(offset < 0 || size < 0 || (size_t)(offset + size) > buffer->size())
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	std::memcpy(&(*buffer)[offset], data, size);
+	stats.uploadedBytes += size;
+}
+
+GLenum LUNAHeadlessGl::CheckFramebufferStatus(GLenum target)
+{
+	RecordCall();
+
+	if(context->framebuffer == 0) return GL_FRAMEBUFFER_COMPLETE;
+
+	GLuint texture = context->framebuffers[context->framebuffer];
+	return context->textures.count(texture) == 1 ? GL_FRAMEBUFFER_COMPLETE : GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT;
+}
+
+void LUNAHeadlessGl::Clear(GLbitfield mask)
+{
+	RecordCall();
+
+	if(!rasterization || !(mask & GL_COLOR_BUFFER_BIT)) return;
+
+	int width, height;
+	unsigned char* target = GetColorBuffer(width, height);
+	if(!target) return;
+
+	unsigned char color[4];
+	for(int i = 0; i < 4; i++) color[i] = (unsigned char)(std::max(0.0f, std::min(context->clearColor[i], 1.0f)) * 255.0f + 0.5f);
+
+	int minX = 0, minY = 0, maxX = width, maxY = height;
+	if(context->scissorTest)
+	{
+		const GLint* box = context->scissorBox;
+		minX = std::max(minX, box[0]);
+		minY = std::max(minY, box[1]);
+		maxX = std::min(maxX, box[0] + box[2]);
+		maxY = std::min(maxY, box[1] + box[3]);
+	}
+
+	for(int y = minY; y < maxY; y++)
+	{
+		for(int x = minX; x < maxX; x++) std::memcpy(target + (y * width + x) * 4, color, 4);
+	}
+}
+
+void LUNAHeadlessGl::ClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha)
+{
+	RecordCall(true);
+
+	context->clearColor[0] = red;
+	context->clearColor[1] = green;
+	context->clearColor[2] = blue;
+	context->clearColor[3] = alpha;
+}
+
+void LUNAHeadlessGl::CompileShader(GLuint shader)
+{
+	RecordCall();
+
+	auto it = context->shaders.find(shader);
+	if(it == context->shaders.end()) SetError(GL_INVALID_VALUE);
+	else it->second.compiled = !it->second.source.empty();
+}
+
+void LUNAHeadlessGl::CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height,
+	GLint border, GLsizei imageSize, const GLvoid* data)
+{
+	RecordCall();
+
+	Texture* texture = GetBoundTexture();
+	if(!texture)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	stats.textureUploads++;
+	stats.uploadedBytes += imageSize;
+	if(level != 0) return;
+
+	// Compressed data isn't decoded, such textures are sampled as white
+	texture->width = width;
+	texture->height = height;
+	texture->format = internalformat;
+	texture->compressed = true;
+	texture->pixels.clear();
+}
+
+GLuint LUNAHeadlessGl::CreateProgram()
+{
+	RecordCall();
+
+	GLuint id = GenId();
+	context->programs[id] = Program();
+	return id;
+}
+
+GLuint LUNAHeadlessGl::CreateShader(GLenum type)
+{
+	RecordCall();
+
+	GLuint id = GenId();
+	context->shaders[id].type = type;
+	return id;
+}
+
+void LUNAHeadlessGl::DeleteBuffers(GLsizei n, const GLuint* buffers)
+{
+	RecordCall();
+
+	for(int i = 0; i < n; i++)
+	{
+		if(buffers[i] == 0) continue;
+
+		context->buffers.erase(buffers[i]);
+		if(context->arrayBuffer == buffers[i]) context->arrayBuffer = 0;
+		if(context->elementBuffer == buffers[i]) context->elementBuffer = 0;
+	}
+}
+
+void LUNAHeadlessGl::DeleteFramebuffers(GLsizei n, const GLuint* framebuffers)
+{
+	RecordCall();
+
+	for(int i = 0; i < n; i++)
+	{
+		if(framebuffers[i] == 0) continue;
+
+		context->framebuffers.erase(framebuffers[i]);
+		if(context->framebuffer == framebuffers[i]) context->framebuffer = 0;
+	}
+}
+
+void LUNAHeadlessGl::DeleteProgram(GLuint program)
+{
+	RecordCall();
+
+	context->programs.erase(program);
+	if(context->program == program) context->program = 0;
+}
+
+void LUNAHeadlessGl::DeleteShader(GLuint shader)
+{
+	RecordCall();
+
+	context->shaders.erase(shader);
+}
+
+void LUNAHeadlessGl::DeleteTextures(GLsizei n, const GLuint* textures)
+{
+	RecordCall();
+
+	for(int i = 0; i < n; i++)
+	{
+		if(textures[i] == 0) continue;
+
+		context->textures.erase(textures[i]);
+		for(GLuint& unit : context->textureUnits)
+		{
+			if(unit == textures[i]) unit = 0;
+		}
+	}
+}
+
+void LUNAHeadlessGl::DetachShader(GLuint program, GLuint shader)
+{
+	RecordCall();
+
+	Program* prog = GetProgram(program);
+	if(!prog) return;
+
+	auto& shaders = prog->shaders;
+	shaders.erase(std::remove(shaders.begin(), shaders.end(), shader), shaders.end());
+}
+
+static bool* GetCapability(GLenum cap)
+{
+	switch(cap)
+	{
+	case GL_BLEND:
+		return &context->blend;
+	case GL_SCISSOR_TEST:
+		return &context->scissorTest;
+	case GL_DEPTH_TEST:
+		return &context->depthTest;
+	case GL_CULL_FACE:
+		return &context->cullFace;
+	case GL_STENCIL_TEST:
+		return &context->stencilTest;
+	default:
+		return nullptr;
+	}
+}
+
+void LUNAHeadlessGl::Disable(GLenum cap)
+{
+	RecordCall(true);
+
+	bool* capability = GetCapability(cap);
+	if(capability) *capability = false;
+	else SetError(GL_INVALID_ENUM);
+}
+
+void LUNAHeadlessGl::DisableVertexAttribArray(GLuint index)
+{
+	RecordCall(true);
+
+	if(index >= MAX_VERTEX_ATTRIBS) SetError(GL_INVALID_VALUE);
+	else context->attribs[index].enabled = false;
+}
+
+void LUNAHeadlessGl::DrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+	RecordCall();
+
+	Draw(mode, count, [first](GLsizei i) { return (GLuint)(first + i); });
+}
+
+void LUNAHeadlessGl::DrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices)
+{
+	RecordCall();
+
+	const unsigned char* data = static_cast<const unsigned char*>(indices);
+	if(context->elementBuffer != 0)
+	{
+		auto buffer = GetBoundBuffer(GL_ELEMENT_ARRAY_BUFFER);
+		if(!buffer || buffer->empty())
+		{
+			SetError(GL_INVALID_OPERATION);
+			return;
+		}
+		data = &(*buffer)[0] + reinterpret_cast<size_t>(indices);
+	}
+
+	if(!data)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	Draw(mode, count, [data, type](GLsizei i)
+	{
+		if(type == GL_UNSIGNED_BYTE) return (GLuint)data[i];
+		if(type == GL_UNSIGNED_SHORT)
+		{
+			GLushort index;
+			std::memcpy(&index, data + i * sizeof(GLushort), sizeof(index));
+			return (GLuint)index;
+		}
+
+		GLuint index;
+		std::memcpy(&index, data + i * sizeof(GLuint), sizeof(index));
+		return index;
+	});
+}
+
+void LUNAHeadlessGl::Enable(GLenum cap)
+{
+	RecordCall(true);
+
+	bool* capability = GetCapability(cap);
+	if(capability) *capability = true;
+	else SetError(GL_INVALID_ENUM);
+}
+
+void LUNAHeadlessGl::EnableVertexAttribArray(GLuint index)
+{
+	RecordCall(true);
+
+	if(index >= MAX_VERTEX_ATTRIBS) SetError(GL_INVALID_VALUE);
+	else context->attribs[index].enabled = true;
+}
+
+void LUNAHeadlessGl::Finish()
+{
+	RecordCall();
+}
+
+void LUNAHeadlessGl::Flush()
+{
+	RecordCall();
+}
+
+void LUNAHeadlessGl::FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+	RecordCall(true);
+
+	if(context->framebuffer == 0 || attachment != GL_COLOR_ATTACHMENT0) SetError(GL_INVALID_OPERATION);
+	else context->framebuffers[context->framebuffer] = texture;
+}
+
+void LUNAHeadlessGl::GenBuffers(GLsizei n, GLuint* buffers)
+{
+	RecordCall();
+
+	for(int i = 0; i < n; i++)
+	{
+		buffers[i] = GenId();
+		context->buffers[buffers[i]] = std::vector<unsigned char>();
+	}
+}
+
+void LUNAHeadlessGl::GenerateMipmap(GLenum target)
+{
+	RecordCall();
+}
+
+void LUNAHeadlessGl::GenFramebuffers(GLsizei n, GLuint* framebuffers)
+{
+	RecordCall();
+
+	for(int i = 0; i < n; i++)
+	{
+		framebuffers[i] = GenId();
+		context->framebuffers[framebuffers[i]] = 0;
+	}
+}
+
+void LUNAHeadlessGl::GenTextures(GLsizei n, GLuint* textures)
+{
+	RecordCall();
+
+	for(int i = 0; i < n; i++)
+	{
+		textures[i] = GenId();
+		context->textures[textures[i]] = Texture();
+	}
+}
+
+int LUNAHeadlessGl::GetAttribLocation(GLuint program, const GLchar* name)
+{
+	RecordCall();
+
+	Program* prog = GetProgram(program);
+	if(!prog || !prog->linked) return -1;
+
+	auto it = prog->attribs.find(name);
+	return it != prog->attribs.end() ? it->second : -1;
+}
+
+GLenum LUNAHeadlessGl::GetError()
+{
+	GLenum error = context->error;
+	context->error = GL_NO_ERROR;
+	return error;
+}
+
+void LUNAHeadlessGl::GetIntegerv(GLenum pname, GLint* params)
+{
+	RecordCall();
+
+	switch(pname)
+	{
+	case GL_VIEWPORT:
+		std::copy(context->viewport, context->viewport + 4, params);
+		break;
+	case GL_SCISSOR_BOX:
+		std::copy(context->scissorBox, context->scissorBox + 4, params);
+		break;
+	case GL_FRAMEBUFFER_BINDING:
+		*params = context->framebuffer;
+		break;
+	case GL_ARRAY_BUFFER_BINDING:
+		*params = context->arrayBuffer;
+		break;
+	case GL_ELEMENT_ARRAY_BUFFER_BINDING:
+		*params = context->elementBuffer;
+		break;
+	case GL_CURRENT_PROGRAM:
+		*params = context->program;
+		break;
+	case GL_ACTIVE_TEXTURE:
+		*params = GL_TEXTURE0 + context->activeUnit;
+		break;
+	case GL_MAX_TEXTURE_IMAGE_UNITS:
+		*params = MAX_TEXTURE_UNITS;
+		break;
+	case GL_MAX_TEXTURE_SIZE:
+		*params = MAX_TEXTURE_SIZE;
+		break;
+	case GL_PACK_ALIGNMENT:
+		*params = context->packAlignment;
+		break;
+	case GL_UNPACK_ALIGNMENT:
+		*params = context->unpackAlignment;
+		break;
+	case GL_NUM_COMPRESSED_TEXTURE_FORMATS:
+		*params = 0;
+		break;
+	default:
+		SetError(GL_INVALID_ENUM);
+		break;
+	}
+}
+
+void LUNAHeadlessGl::GetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* length, GLchar* infolog)
+{
+	RecordCall();
+
+	if(length) *length = 0;
+	if(infolog && bufsize > 0) infolog[0] = '\0';
+}
+
+void LUNAHeadlessGl::GetProgramiv(GLuint program, GLenum pname, GLint* params)
+{
+	RecordCall();
+
+	Program* prog = GetProgram(program);
+	if(!prog)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if(pname == GL_LINK_STATUS) *params = prog->linked ? GL_TRUE : GL_FALSE;
+	else if(pname == GL_INFO_LOG_LENGTH) *params = 0;
+	else SetError(GL_INVALID_ENUM);
+}
+
+void LUNAHeadlessGl::GetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* length, GLchar* infolog)
+{
+	RecordCall();
+
+	if(length) *length = 0;
+	if(infolog && bufsize > 0) infolog[0] = '\0';
+}
+
+void LUNAHeadlessGl::GetShaderiv(GLuint shader, GLenum pname, GLint* params)
+{
+	RecordCall();
+
+	auto it = context->shaders.find(shader);
+	if(it == context->shaders.end())
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	if(pname == GL_COMPILE_STATUS) *params = it->second.compiled ? GL_TRUE : GL_FALSE;
+	else if(pname == GL_INFO_LOG_LENGTH) *params = 0;
+	else SetError(GL_INVALID_ENUM);
+}
+
+const GLubyte* LUNAHeadlessGl::GetString(GLenum name)
+{
+	RecordCall();
+
+	switch(name)
+	{
+	case GL_VENDOR:
+		return reinterpret_cast<const GLubyte*>("luna2d");
+	case GL_RENDERER:
+		return reinterpret_cast<const GLubyte*>("luna2d headless");
+	case GL_VERSION:
+		return reinterpret_cast<const GLubyte*>("OpenGL ES 2.0 luna2d headless");
+	case GL_EXTENSIONS:
+		return reinterpret_cast<const GLubyte*>("");
+	default:
+		SetError(GL_INVALID_ENUM);
+		return nullptr;
+	}
+}
+
+int LUNAHeadlessGl::GetUniformLocation(GLuint program, const GLchar* name)
+{
+	RecordCall();
+
+	Program* prog = GetProgram(program);
+	if(!prog || !prog->linked) return -1;
+
+	// Support both "name" and "name[index]" for arrays
+	std::string uniformName = name;
+	int element = 0;
+	size_t bracket = uniformName.find('[');
+	if(bracket != std::string::npos)
+	{
+		element = std::atoi(uniformName.c_str() + bracket + 1);
+		uniformName = uniformName.substr(0, bracket);
+	}
+
+	auto it = prog->uniforms.find(uniformName);
+	if(it == prog->uniforms.end() || element < 0 || element >= UNIFORM_LOCATIONS_STEP) return -1;
+
+	return it->second + element;
+}
+
+GLboolean LUNAHeadlessGl::IsEnabled(GLenum cap)
+{
+	RecordCall();
+
+	bool* capability = GetCapability(cap);
+	return capability && *capability ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean LUNAHeadlessGl::IsProgram(GLuint program)
+{
+	RecordCall();
+
+	return GetProgram(program) ? GL_TRUE : GL_FALSE;
+}
+
+GLboolean LUNAHeadlessGl::IsTexture(GLuint texture)
+{
+	RecordCall();
+
+	return context->textures.count(texture) == 1 ? GL_TRUE : GL_FALSE;
+}
+
+void LUNAHeadlessGl::LinkProgram(GLuint program)
+{
+	RecordCall();
+
+	Program* prog = GetProgram(program);
+	if(!prog)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	bool hasVertex = false, hasFragment = false;
+	std::vector<std::string> attribs, uniforms;
+
+	for(GLuint id : prog->shaders)
+	{
+		auto it = context->shaders.find(id);
+		if(it == context->shaders.end() || !it->second.compiled) continue;
+
+		const Shader& shader = it->second;
+		if(shader.type == GL_VERTEX_SHADER)
+		{
+			hasVertex = true;
+			ParseDeclarations(shader.source, "attribute", attribs);
+		}
+		else hasFragment = true;
+
+		ParseDeclarations(shader.source, "uniform", uniforms);
+	}
+
+	prog->linked = hasVertex && hasFragment;
+	prog->attribs.clear();
+	prog->uniforms.clear();
+	prog->uniformValues.clear();
+	if(!prog->linked) return;
+
+	// Locations are assigned in order of declaration
+	for(const std::string& name : attribs)
+	{
+		if(prog->attribs.count(name) == 0) prog->attribs[name] = prog->attribs.size();
+	}
+
+	for(const std::string& name : uniforms)
+	{
+		if(prog->uniforms.count(name) == 0) prog->uniforms[name] = prog->uniforms.size() * UNIFORM_LOCATIONS_STEP;
+	}
+}
+
+void LUNAHeadlessGl::PixelStorei(GLenum pname, GLint param)
+{
+	RecordCall(true);
+
+	if(param != 1 && param != 2 && param != 4 && param != 8) SetError(GL_INVALID_VALUE);
+	else if(pname == GL_PACK_ALIGNMENT) context->packAlignment = param;
+	else if(pname == GL_UNPACK_ALIGNMENT) context->unpackAlignment = param;
+	else SetError(GL_INVALID_ENUM);
+}
+
+void LUNAHeadlessGl::ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* pixels)
+{
+	RecordCall();
+
+	if(type != GL_UNSIGNED_BYTE)
+	{
+		SetError(GL_INVALID_ENUM);
+		return;
+	}
+
+	size_t rowSize = GetRowSize(width, format, context->packAlignment);
+	int bpp = GetBytesPerPixel(format);
+	unsigned char* dest = static_cast<unsigned char*>(pixels);
+	std::memset(dest, 0, rowSize * height);
+
+	int targetWidth, targetHeight;
+	const unsigned char* target = GetColorBuffer(targetWidth, targetHeight);
+	if(!target) return;
+
+	for(int row = 0; row < height; row++)
+	{
+		for(int col = 0; col < width; col++)
+		{
+			int srcX = x + col;
+			int srcY = y + row;
+			if(srcX < 0 || srcY < 0 || srcX >= targetWidth || srcY >= targetHeight) continue;
+
+			PackPixel(target + (srcY * targetWidth + srcX) * 4, format, dest + row * rowSize + col * bpp);
+		}
+	}
+}
+
+void LUNAHeadlessGl::Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	RecordCall(true);
+
+	context->scissorBox[0] = x;
+	context->scissorBox[1] = y;
+	context->scissorBox[2] = width;
+	context->scissorBox[3] = height;
+}
+
+void LUNAHeadlessGl::ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length)
+{
+	RecordCall();
+
+	auto it = context->shaders.find(shader);
+	if(it == context->shaders.end())
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	std::string& source = it->second.source;
+	source.clear();
+	for(int i = 0; i < count; i++)
+	{
+		if(length && length[i] >= 0) source.append(string[i], length[i]);
+		else source.append(string[i]);
+	}
+}
+
+void LUNAHeadlessGl::TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+	GLint border, GLenum format, GLenum type, const GLvoid* pixels)
+{
+	RecordCall();
+
+	Texture* texture = GetBoundTexture();
+	if(!texture)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	if(width < 0 || height < 0 || width > MAX_TEXTURE_SIZE || height > MAX_TEXTURE_SIZE)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	stats.textureUploads++;
+	if(pixels) stats.uploadedBytes += GetRowSize(width, format, context->unpackAlignment) * height;
+
+	// Only base level is stored
+	if(level != 0) return;
+
+	texture->width = width;
+	texture->height = height;
+	texture->format = format;
+	texture->compressed = false;
+	texture->pixels.assign(width * height * 4, 0);
+
+	if(type == GL_UNSIGNED_BYTE) WriteTexturePixels(*texture, 0, 0, width, height, format, pixels);
+}
+
+void LUNAHeadlessGl::TexParameteri(GLenum target, GLenum pname, GLint param)
+{
+	RecordCall(true);
+}
+
+void LUNAHeadlessGl::TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const GLvoid* pixels)
+{
+	RecordCall();
+
+	Texture* texture = GetBoundTexture();
+	if(!texture || texture->compressed)
+	{
+		SetError(GL_INVALID_OPERATION);
+		return;
+	}
+
+	stats.textureUploads++;
+	stats.uploadedBytes += GetRowSize(width, format, context->unpackAlignment) * height;
+
+	if(level == 0 && type == GL_UNSIGNED_BYTE) WriteTexturePixels(*texture, xoffset, yoffset, width, height, format, pixels);
+}
+
+void LUNAHeadlessGl::Uniform1f(GLint location, GLfloat x)
+{
+	SetUniform(location, 1, 1, &x);
+}
+
+void LUNAHeadlessGl::Uniform1fv(GLint location, GLsizei count, const GLfloat* v)
+{
+	SetUniform(location, count, 1, v);
+}
+
+void LUNAHeadlessGl::Uniform1i(GLint location, GLint x)
+{
+	float value = x;
+	SetUniform(location, 1, 1, &value);
+}
+
+void LUNAHeadlessGl::Uniform1iv(GLint location, GLsizei count, const GLint* v)
+{
+	std::vector<float> values(v, v + count);
+	SetUniform(location, count, 1, values.empty() ? nullptr : &values[0]);
+}
+
+void LUNAHeadlessGl::Uniform2f(GLint location, GLfloat x, GLfloat y)
+{
+	float values[] = { x, y };
+	SetUniform(location, 1, 2, values);
+}
+
+void LUNAHeadlessGl::Uniform2fv(GLint location, GLsizei count, const GLfloat* v)
+{
+	SetUniform(location, count, 2, v);
+}
+
+void LUNAHeadlessGl::Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z)
+{
+	float values[] = { x, y, z };
+	SetUniform(location, 1, 3, values);
+}
+
+void LUNAHeadlessGl::Uniform3fv(GLint location, GLsizei count, const GLfloat* v)
+{
+	SetUniform(location, count, 3, v);
+}
+
+void LUNAHeadlessGl::Uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w)
+{
+	float values[] = { x, y, z, w };
+	SetUniform(location, 1, 4, values);
+}
+
+void LUNAHeadlessGl::Uniform4fv(GLint location, GLsizei count, const GLfloat* v)
+{
+	SetUniform(location, count, 4, v);
+}
+
+void LUNAHeadlessGl::UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+	RecordCall(true);
+
+	// Matrix arrays aren't used by engine, only first matrix is stored
+	if(count > 0) GetUniformValue(location).assign(value, value + 16);
+}
+
+void LUNAHeadlessGl::UseProgram(GLuint program)
+{
+	RecordCall(true);
+
+	if(program != 0 && !GetProgram(program)) SetError(GL_INVALID_VALUE);
+	else context->program = program;
+}
+
+void LUNAHeadlessGl::VertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+	const GLvoid* ptr)
+{
+	RecordCall(true);
+
+	if(indx >= MAX_VERTEX_ATTRIBS)
+	{
+		SetError(GL_INVALID_VALUE);
+		return;
+	}
+
+	VertexAttrib& attrib = context->attribs[indx];
+	attrib.size = size;
+	attrib.type = type;
+	attrib.normalized = normalized == GL_TRUE;
+	attrib.stride = stride;
+	attrib.pointer = ptr;
+	attrib.buffer = context->arrayBuffer;
+}
+
+void LUNAHeadlessGl::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	RecordCall(true);
+
+	context->viewport[0] = x;
+	context->viewport[1] = y;
+	context->viewport[2] = width;
+	context->viewport[3] = height;
+}
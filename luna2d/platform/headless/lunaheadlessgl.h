@@ -0,0 +1,332 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+//-------------------------------------------------------------------
+// Headless GL backend. Implements subset of OpenGL ES 2.0 used by
+// engine as command recorder without GPU. Records counters of draw
+// calls, state changes and uploaded bytes, and optionally rasterizes
+// triangles to CPU buffers. Enabled by "LUNA_HEADLESS_GL" build option
+//-------------------------------------------------------------------
+
+// GL types
+typedef unsigned int GLenum;
+typedef unsigned char GLboolean;
+typedef unsigned int GLbitfield;
+typedef void GLvoid;
+typedef signed char GLbyte;
+typedef short GLshort;
+typedef int GLint;
+typedef int GLsizei;
+typedef unsigned char GLubyte;
+typedef unsigned short GLushort;
+typedef unsigned int GLuint;
+typedef float GLfloat;
+typedef float GLclampf;
+typedef char GLchar;
+typedef ptrdiff_t GLintptr;
+typedef ptrdiff_t GLsizeiptr;
+
+// GL constants. Values are same as in OpenGL ES 2.0 headers
+#ifndef GL_TEXTURE_2D
+	#define GL_FALSE 0
+	#define GL_TRUE 1
+	#define GL_NO_ERROR 0
+	#define GL_INVALID_ENUM 0x0500
+	#define GL_INVALID_VALUE 0x0501
+	#define GL_INVALID_OPERATION 0x0502
+	#define GL_OUT_OF_MEMORY 0x0505
+
+	#define GL_DEPTH_BUFFER_BIT 0x00000100
+	#define GL_STENCIL_BUFFER_BIT 0x00000400
+	#define GL_COLOR_BUFFER_BIT 0x00004000
+
+	#define GL_POINTS 0x0000
+	#define GL_LINES 0x0001
+	#define GL_LINE_LOOP 0x0002
+	#define GL_LINE_STRIP 0x0003
+	#define GL_TRIANGLES 0x0004
+	#define GL_TRIANGLE_STRIP 0x0005
+	#define GL_TRIANGLE_FAN 0x0006
+
+	#define GL_ZERO 0
+	#define GL_ONE 1
+	#define GL_SRC_COLOR 0x0300
+	#define GL_ONE_MINUS_SRC_COLOR 0x0301
+	#define GL_SRC_ALPHA 0x0302
+	#define GL_ONE_MINUS_SRC_ALPHA 0x0303
+	#define GL_DST_ALPHA 0x0304
+	#define GL_ONE_MINUS_DST_ALPHA 0x0305
+	#define GL_DST_COLOR 0x0306
+	#define GL_ONE_MINUS_DST_COLOR 0x0307
+
+	#define GL_CULL_FACE 0x0B44
+	#define GL_DEPTH_TEST 0x0B71
+	#define GL_STENCIL_TEST 0x0B90
+	#define GL_VIEWPORT 0x0BA2
+	#define GL_BLEND 0x0BE2
+	#define GL_SCISSOR_BOX 0x0C10
+	#define GL_SCISSOR_TEST 0x0C11
+	#define GL_UNPACK_ALIGNMENT 0x0CF5
+	#define GL_PACK_ALIGNMENT 0x0D05
+	#define GL_MAX_TEXTURE_SIZE 0x0D33
+
+	#define GL_BYTE 0x1400
+	#define GL_UNSIGNED_BYTE 0x1401
+	#define GL_SHORT 0x1402
+	#define GL_UNSIGNED_SHORT 0x1403
+	#define GL_INT 0x1404
+	#define GL_UNSIGNED_INT 0x1405
+	#define GL_FLOAT 0x1406
+
+	#define GL_ALPHA 0x1906
+	#define GL_RGB 0x1907
+	#define GL_RGBA 0x1908
+	#define GL_LUMINANCE 0x1909
+	#define GL_LUMINANCE_ALPHA 0x190A
+
+	#define GL_VENDOR 0x1F00
+	#define GL_RENDERER 0x1F01
+	#define GL_VERSION 0x1F02
+	#define GL_EXTENSIONS 0x1F03
+
+	#define GL_NEAREST 0x2600
+	#define GL_LINEAR 0x2601
+	#define GL_NEAREST_MIPMAP_NEAREST 0x2700
+	#define GL_LINEAR_MIPMAP_NEAREST 0x2701
+	#define GL_NEAREST_MIPMAP_LINEAR 0x2702
+	#define GL_LINEAR_MIPMAP_LINEAR 0x2703
+	#define GL_TEXTURE_MAG_FILTER 0x2800
+	#define GL_TEXTURE_MIN_FILTER 0x2801
+	#define GL_TEXTURE_WRAP_S 0x2802
+	#define GL_TEXTURE_WRAP_T 0x2803
+	#define GL_REPEAT 0x2901
+	#define GL_CLAMP_TO_EDGE 0x812F
+	#define GL_MIRRORED_REPEAT 0x8370
+
+	#define GL_TEXTURE_2D 0x0DE1
+	#define GL_TEXTURE0 0x84C0
+	#define GL_ACTIVE_TEXTURE 0x84E0
+	#define GL_MAX_TEXTURE_IMAGE_UNITS 0x8872
+
+	#define GL_ARRAY_BUFFER 0x8892
+	#define GL_ELEMENT_ARRAY_BUFFER 0x8893
+	#define GL_ARRAY_BUFFER_BINDING 0x8894
+	#define GL_ELEMENT_ARRAY_BUFFER_BINDING 0x8895
+	#define GL_STREAM_DRAW 0x88E0
+	#define GL_STATIC_DRAW 0x88E4
+	#define GL_DYNAMIC_DRAW 0x88E8
+
+	#define GL_FRAGMENT_SHADER 0x8B30
+	#define GL_VERTEX_SHADER 0x8B31
+	#define GL_COMPILE_STATUS 0x8B81
+	#define GL_LINK_STATUS 0x8B82
+	#define GL_INFO_LOG_LENGTH 0x8B84
+	#define GL_CURRENT_PROGRAM 0x8B8D
+
+	#define GL_COMPRESSED_TEXTURE_FORMATS 0x86A3
+	#define GL_NUM_COMPRESSED_TEXTURE_FORMATS 0x86A2
+
+	#define GL_FRAMEBUFFER 0x8D40
+	#define GL_COLOR_ATTACHMENT0 0x8CE0
+	#define GL_FRAMEBUFFER_COMPLETE 0x8CD5
+	#define GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT 0x8CD6
+	#define GL_FRAMEBUFFER_BINDING 0x8CA6
+#endif
+
+namespace luna2d{ namespace LUNAHeadlessGl{
+
+// Counters of recorded commands
+struct Stats
+{
+	int calls = 0; // Count of all GL calls
+	int drawCalls = 0;
+	int drawnVertexes = 0;
+	int stateChanges = 0; // Calls changing bindings, capabilities, blending, viewport, scissor, uniforms and attributes
+	int textureUploads = 0;
+	size_t uploadedBytes = 0; // Bytes uploaded to buffers and textures
+	size_t rasterizedPixels = 0;
+};
+
+const Stats& GetStats();
+void ResetStats();
+
+// Rasterize triangles to CPU buffers of framebuffers and textures
+// Fragments are shaded like default shader: vertex color multiplied by nearest texel
+// Alpha textures are sampled as white with alpha, same as in font shader
+bool IsEnabledRasterization();
+void EnableRasterization(bool enable);
+
+// Set size of default framebuffer. Default framebuffer has no storage until size is set
+void SetDefaultFramebufferSize(int width, int height);
+
+// Delete all objects and reset state, same as after losing GL context
+void Reset();
+
+// GL functions
+void ActiveTexture(GLenum texture);
+void AttachShader(GLuint program, GLuint shader);
+void BindBuffer(GLenum target, GLuint buffer);
+void BindFramebuffer(GLenum target, GLuint framebuffer);
+void BindTexture(GLenum target, GLuint texture);
+void BlendFunc(GLenum sfactor, GLenum dfactor);
+void BufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+void BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data);
+GLenum CheckFramebufferStatus(GLenum target);
+void Clear(GLbitfield mask);
+void ClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha);
+void CompileShader(GLuint shader);
+void CompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height,
+	GLint border, GLsizei imageSize, const GLvoid* data);
+GLuint CreateProgram();
+GLuint CreateShader(GLenum type);
+void DeleteBuffers(GLsizei n, const GLuint* buffers);
+void DeleteFramebuffers(GLsizei n, const GLuint* framebuffers);
+void DeleteProgram(GLuint program);
+void DeleteShader(GLuint shader);
+void DeleteTextures(GLsizei n, const GLuint* textures);
+void DetachShader(GLuint program, GLuint shader);
+void Disable(GLenum cap);
+void DisableVertexAttribArray(GLuint index);
+void DrawArrays(GLenum mode, GLint first, GLsizei count);
+void DrawElements(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices);
+void Enable(GLenum cap);
+void EnableVertexAttribArray(GLuint index);
+void Finish();
+void Flush();
+void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level);
+void GenBuffers(GLsizei n, GLuint* buffers);
+void GenerateMipmap(GLenum target);
+void GenFramebuffers(GLsizei n, GLuint* framebuffers);
+void GenTextures(GLsizei n, GLuint* textures);
+int GetAttribLocation(GLuint program, const GLchar* name);
+GLenum GetError();
+void GetIntegerv(GLenum pname, GLint* params);
+void GetProgramInfoLog(GLuint program, GLsizei bufsize, GLsizei* length, GLchar* infolog);
+void GetProgramiv(GLuint program, GLenum pname, GLint* params);
+void GetShaderInfoLog(GLuint shader, GLsizei bufsize, GLsizei* length, GLchar* infolog);
+void GetShaderiv(GLuint shader, GLenum pname, GLint* params);
+const GLubyte* GetString(GLenum name);
+int GetUniformLocation(GLuint program, const GLchar* name);
+GLboolean IsEnabled(GLenum cap);
+GLboolean IsProgram(GLuint program);
+GLboolean IsTexture(GLuint texture);
+void LinkProgram(GLuint program);
+void PixelStorei(GLenum pname, GLint param);
+void ReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* pixels);
+void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+void ShaderSource(GLuint shader, GLsizei count, const GLchar* const* string, const GLint* length);
+void TexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border,
+	GLenum format, GLenum type, const GLvoid* pixels);
+void TexParameteri(GLenum target, GLenum pname, GLint param);
+void TexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+	GLenum format, GLenum type, const GLvoid* pixels);
+void Uniform1f(GLint location, GLfloat x);
+void Uniform1fv(GLint location, GLsizei count, const GLfloat* v);
+void Uniform1i(GLint location, GLint x);
+void Uniform1iv(GLint location, GLsizei count, const GLint* v);
+void Uniform2f(GLint location, GLfloat x, GLfloat y);
+void Uniform2fv(GLint location, GLsizei count, const GLfloat* v);
+void Uniform3f(GLint location, GLfloat x, GLfloat y, GLfloat z);
+void Uniform3fv(GLint location, GLsizei count, const GLfloat* v);
+void Uniform4f(GLint location, GLfloat x, GLfloat y, GLfloat z, GLfloat w);
+void Uniform4fv(GLint location, GLsizei count, const GLfloat* v);
+void UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+void UseProgram(GLuint program);
+void VertexAttribPointer(GLuint indx, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const GLvoid* ptr);
+void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+}}
+
+#define glActiveTexture luna2d::LUNAHeadlessGl::ActiveTexture
+#define glAttachShader luna2d::LUNAHeadlessGl::AttachShader
+#define glBindBuffer luna2d::LUNAHeadlessGl::BindBuffer
+#define glBindFramebuffer luna2d::LUNAHeadlessGl::BindFramebuffer
+#define glBindTexture luna2d::LUNAHeadlessGl::BindTexture
+#define glBlendFunc luna2d::LUNAHeadlessGl::BlendFunc
+#define glBufferData luna2d::LUNAHeadlessGl::BufferData
+#define glBufferSubData luna2d::LUNAHeadlessGl::BufferSubData
+#define glCheckFramebufferStatus luna2d::LUNAHeadlessGl::CheckFramebufferStatus
+#define glClear luna2d::LUNAHeadlessGl::Clear
+#define glClearColor luna2d::LUNAHeadlessGl::ClearColor
+#define glCompileShader luna2d::LUNAHeadlessGl::CompileShader
+#define glCompressedTexImage2D luna2d::LUNAHeadlessGl::CompressedTexImage2D
+#define glCreateProgram luna2d::LUNAHeadlessGl::CreateProgram
+#define glCreateShader luna2d::LUNAHeadlessGl::CreateShader
+#define glDeleteBuffers luna2d::LUNAHeadlessGl::DeleteBuffers
+#define glDeleteFramebuffers luna2d::LUNAHeadlessGl::DeleteFramebuffers
+#define glDeleteProgram luna2d::LUNAHeadlessGl::DeleteProgram
+#define glDeleteShader luna2d::LUNAHeadlessGl::DeleteShader
+#define glDeleteTextures luna2d::LUNAHeadlessGl::DeleteTextures
+#define glDetachShader luna2d::LUNAHeadlessGl::DetachShader
+#define glDisable luna2d::LUNAHeadlessGl::Disable
+#define glDisableVertexAttribArray luna2d::LUNAHeadlessGl::DisableVertexAttribArray
+#define glDrawArrays luna2d::LUNAHeadlessGl::DrawArrays
+#define glDrawElements luna2d::LUNAHeadlessGl::DrawElements
+#define glEnable luna2d::LUNAHeadlessGl::Enable
+#define glEnableVertexAttribArray luna2d::LUNAHeadlessGl::EnableVertexAttribArray
+#define glFinish luna2d::LUNAHeadlessGl::Finish
+#define glFlush luna2d::LUNAHeadlessGl::Flush
+#define glFramebufferTexture2D luna2d::LUNAHeadlessGl::FramebufferTexture2D
+#define glGenBuffers luna2d::LUNAHeadlessGl::GenBuffers
+#define glGenerateMipmap luna2d::LUNAHeadlessGl::GenerateMipmap
+#define glGenFramebuffers luna2d::LUNAHeadlessGl::GenFramebuffers
+#define glGenTextures luna2d::LUNAHeadlessGl::GenTextures
+#define glGetAttribLocation luna2d::LUNAHeadlessGl::GetAttribLocation
+#define glGetError luna2d::LUNAHeadlessGl::GetError
+#define glGetIntegerv luna2d::LUNAHeadlessGl::GetIntegerv
+#define glGetProgramInfoLog luna2d::LUNAHeadlessGl::GetProgramInfoLog
+#define glGetProgramiv luna2d::LUNAHeadlessGl::GetProgramiv
+#define glGetShaderInfoLog luna2d::LUNAHeadlessGl::GetShaderInfoLog
+#define glGetShaderiv luna2d::LUNAHeadlessGl::GetShaderiv
+#define glGetString luna2d::LUNAHeadlessGl::GetString
+#define glGetUniformLocation luna2d::LUNAHeadlessGl::GetUniformLocation
+#define glIsEnabled luna2d::LUNAHeadlessGl::IsEnabled
+#define glIsProgram luna2d::LUNAHeadlessGl::IsProgram
+#define glIsTexture luna2d::LUNAHeadlessGl::IsTexture
+#define glLinkProgram luna2d::LUNAHeadlessGl::LinkProgram
+#define glPixelStorei luna2d::LUNAHeadlessGl::PixelStorei
+#define glReadPixels luna2d::LUNAHeadlessGl::ReadPixels
+#define glScissor luna2d::LUNAHeadlessGl::Scissor
+#define glShaderSource luna2d::LUNAHeadlessGl::ShaderSource
+#define glTexImage2D luna2d::LUNAHeadlessGl::TexImage2D
+#define glTexParameteri luna2d::LUNAHeadlessGl::TexParameteri
+#define glTexSubImage2D luna2d::LUNAHeadlessGl::TexSubImage2D
+#define glUniform1f luna2d::LUNAHeadlessGl::Uniform1f
+#define glUniform1fv luna2d::LUNAHeadlessGl::Uniform1fv
+#define glUniform1i luna2d::LUNAHeadlessGl::Uniform1i
+#define glUniform1iv luna2d::LUNAHeadlessGl::Uniform1iv
+#define glUniform2f luna2d::LUNAHeadlessGl::Uniform2f
+#define glUniform2fv luna2d::LUNAHeadlessGl::Uniform2fv
+#define glUniform3f luna2d::LUNAHeadlessGl::Uniform3f
+#define glUniform3fv luna2d::LUNAHeadlessGl::Uniform3fv
+#define glUniform4f luna2d::LUNAHeadlessGl::Uniform4f
+#define glUniform4fv luna2d::LUNAHeadlessGl::Uniform4fv
+#define glUniformMatrix4fv luna2d::LUNAHeadlessGl::UniformMatrix4fv
+#define glUseProgram luna2d::LUNAHeadlessGl::UseProgram
+#define glVertexAttribPointer luna2d::LUNAHeadlessGl::VertexAttribPointer
+#define glViewport luna2d::LUNAHeadlessGl::Viewport
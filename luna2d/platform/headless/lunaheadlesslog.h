@@ -0,0 +1,48 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include "platform/lunalog.h"
+
+namespace luna2d{
+
+//--------------------------------------------------------
+// Log implementation for headless platform
+// Messages are printed to standard streams. Count of
+// errors is kept to check for errors in tests
+//--------------------------------------------------------
+class LUNAHeadlessLog : public LUNALog
+{
+private:
+	int errorsCount = 0;
+
+public:
+	virtual void Info(const char* message, ...); // Log info
+	virtual void Warning(const char* message, ...); // Log warning
+	virtual void Error(const char* message, ...); // Log error
+
+	int GetErrorsCount(); // Get count of errors logged since creating log
+};
+
+}
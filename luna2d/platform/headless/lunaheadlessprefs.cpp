@@ -0,0 +1,94 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaheadlessprefs.h"
+#include <cstdlib>
+
+using namespace luna2d;
+
+// Get string value from preferences
+std::string LUNAHeadlessPrefs::GetString(const std::string& name)
+{
+	auto it = values.find(name);
+	return it != values.end() ? it->second : "";
+}
+
+// Get int value from preferences
+int LUNAHeadlessPrefs::GetInt(const std::string& name)
+{
+	return std::atoi(GetString(name).c_str());
+}
+
+// Get float value from preferences
+float LUNAHeadlessPrefs::GetFloat(const std::string& name)
+{
+	return std::atof(GetString(name).c_str());
+}
+
+// Get bool value from preferences
+bool LUNAHeadlessPrefs::GetBool(const std::string& name)
+{
+	return GetString(name) == "true";
+}
+
+// Set string value to preferences
+void LUNAHeadlessPrefs::SetString(const std::string& name, const std::string& value)
+{
+	values[name] = value;
+}
+
+// Set int value to preferences
+void LUNAHeadlessPrefs::SetInt(const std::string& name, int value)
+{
+	values[name] = std::to_string(value);
+}
+
+// Set float value to preferences
+void LUNAHeadlessPrefs::SetFloat(const std::string& name, float value)
+{
+	values[name] = std::to_string(value);
+}
+
+// Set bool value to preferences
+void LUNAHeadlessPrefs::SetBool(const std::string& name, bool value)
+{
+	values[name] = value ? "true" : "false";
+}
+
+// Check for existing value
+bool LUNAHeadlessPrefs::HasValue(const std::string& name)
+{
+	return values.count(name) > 0;
+}
+
+// Remove valuee from preferences
+void LUNAHeadlessPrefs::RemoveValue(const std::string& name)
+{
+	values.erase(name);
+}
+
+// Remove all values from preferences
+void LUNAHeadlessPrefs::Clear()
+{
+	values.clear();
+}
@@ -0,0 +1,63 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunaheadlessutils.h"
+#include "lunalog.h"
+
+using namespace luna2d;
+
+// Get system locale in "xx_XX" format
+// Where "xx" is ISO-639 language code, and "XX" is ISO-3166 country code
+std::string LUNAHeadlessUtils::GetSystemLocale()
+{
+	return "en_US";
+}
+
+// Open given url in system browser
+void LUNAHeadlessUtils::OpenUrl(const std::string& url)
+{
+	LUNA_LOG("Open url \"%s\"", url.c_str());
+}
+
+// Show native dialog with "Ok" button
+// "onClose" calls when dialog closed
+void LUNAHeadlessUtils::MessageDialog(const std::string& title, const std::string& message,
+	const std::function<void()>& onClose)
+{
+	LUNA_LOG("%s: %s", title.c_str(), message.c_str());
+	if(onClose) onClose();
+}
+
+// Show native dialog with "Yes" and "No" buttons
+// "onClose" calls with "true" when "Yes" button pressed, and with "false" otherwise
+void LUNAHeadlessUtils::ConfirmDialog(const std::string& title, const std::string& message,
+	const std::function<void(bool)>& onClose)
+{
+	LUNA_LOG("%s: %s", title.c_str(), message.c_str());
+	if(onClose) onClose(true);
+}
+
+// Show/hide loading indicator over game view
+void LUNAHeadlessUtils::ShowLoadingIndicator(bool show)
+{
+}
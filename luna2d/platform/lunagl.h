@@ -27,6 +27,10 @@
 //-----------------------
 // Include OpenGL headers
 //-----------------------
+#if defined(LUNA_HEADLESS_GL)
+	#include "headless/lunaheadlessgl.h"
+#else
+
 #if LUNA_PLATFORM == LUNA_PLATFORM_QT
 	#include "qt/lunaqtgl.h"
 #endif
@@ -41,4 +45,6 @@
 
 #if LUNA_PLATFORM == LUNA_PLATFORM_WP
 	#include "wp/lunawpgl.h"
+#endif
+
 #endif
\ No newline at end of file
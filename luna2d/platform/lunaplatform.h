@@ -29,9 +29,19 @@
 #define LUNA_PLATFORM_ANDROID 2
 #define LUNA_PLATFORM_IOS 3
 #define LUNA_PLATFORM_WP 4
+#define LUNA_PLATFORM_HEADLESS 5
+
+// Headless desktop platform without window and GPU. Used for tests and benchmarks
+#if defined(LUNA_HEADLESS)
+	#define LUNA_PLATFORM LUNA_PLATFORM_HEADLESS
+	#define LUNA_PLATFORM_STRING "headless"
+
+	#ifndef LUNA_HEADLESS_GL
+		#define LUNA_HEADLESS_GL
+	#endif
 
 // Desktop emulator based on Qt
-#if defined(QT_CORE_LIB)
+#elif defined(QT_CORE_LIB)
 	#define LUNA_PLATFORM LUNA_PLATFORM_QT
 	#define LUNA_PLATFORM_STRING "qt"
 
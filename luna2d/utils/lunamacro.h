@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <cstring>
+
 #if defined(_WIN32) || defined(WIN32)
 	#define LUNA_SLASH '\\'
 #else
@@ -35,6 +35,13 @@ std::u32string luna2d::utf::ToUtf32(const std::string& string)
 	return std::move(ret);
 }
 
+// Convert UTF-8 string to UTF-32 string reusing memory of "out"
+void luna2d::utf::ToUtf32(const char* string, size_t length, std::u32string& out)
+{
+	out.clear();
+	utf8to32(string, string + length, std::back_inserter(out));
+}
+
 // Convert UTF-32 string to UTF-8 string
 std::string luna2d::utf::FromUtf32(const std::u32string& string)
 {
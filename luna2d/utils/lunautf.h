@@ -31,6 +31,7 @@
 namespace luna2d{ namespace utf{
 
 std::u32string ToUtf32(const std::string& string); // Convert UTF-8 string to UTF-32 string
+void ToUtf32(const char* string, size_t length, std::u32string& out); // Convert UTF-8 string to UTF-32 string reusing memory of "out"
 std::string FromUtf32(const std::u32string& string); // Convert UTF-32 string to UTF-8 string
 
 }}
@@ -0,0 +1,205 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunacompressedimage.h"
+#include "lunaetc1.h"
+#include <cstring>
+
+using namespace luna2d;
+
+// Block in individual mode with black base colors and table 0. Pixel (1, 0) has "+8" modifier, others have "+2"
+const unsigned char INDIVIDUAL_BLOCK[etc1::BLOCK_BYTES] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10 };
+
+// Flipped block in differential mode. Top subblock has base color (31, 0, 16) and table 0,
+// bottom subblock has red delta -4 and table 1. All pixels have negative large modifier
+const unsigned char DIFFERENTIAL_BLOCK[etc1::BLOCK_BYTES] = { 0xFC, 0x00, 0x80, 0x07, 0xFF, 0xFF, 0xFF, 0xFF };
+
+// Check color of pixel in RGB pixels with given row size (in pixels)
+static bool IsPixel(const std::vector<unsigned char>& pixels, int width, int x, int y, int r, int g, int b)
+{
+	const unsigned char* pixel = &pixels[(y * width + x) * 3];
+	return pixel[0] == r && pixel[1] == g && pixel[2] == b;
+}
+
+// Append 32-bit value to data in little-endian or big-endian byte order
+static void AppendUint32(std::vector<unsigned char>& data, uint32_t value, bool bigEndian = false)
+{
+	for(int i = 0; i < 4; i++)
+	{
+		int shift = bigEndian ? (3 - i) * 8 : i * 8;
+		data.push_back((value >> shift) & 0xFF);
+	}
+}
+
+// Make KTX file with one ETC1 level of given size
+static std::vector<unsigned char> MakeKtx(int width, int height, bool bigEndian = false, uint32_t keyValueBytes = 0)
+{
+	const unsigned char identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+	std::vector<unsigned char> data(identifier, identifier + sizeof(identifier));
+
+	uint32_t fields[] =
+	{
+		0x04030201, // Endianness
+		0, // glType
+		1, // glTypeSize
+		0, // glFormat
+		GL_FORMAT_ETC1_RGB8, // glInternalFormat
+		0x1907, // glBaseInternalFormat
+		static_cast<uint32_t>(width),
+		static_cast<uint32_t>(height),
+		0, // Depth
+		0, // Array elements
+		1, // Faces
+		1, // Mipmap levels
+		keyValueBytes,
+	};
+	for(uint32_t field : fields) AppendUint32(data, field, bigEndian);
+
+	size_t levelSize = etc1::GetDataSize(width, height);
+	AppendUint32(data, levelSize, bigEndian);
+	for(size_t i = 0; i < levelSize; i += etc1::BLOCK_BYTES)
+	{
+		data.insert(data.end(), INDIVIDUAL_BLOCK, INDIVIDUAL_BLOCK + etc1::BLOCK_BYTES);
+	}
+
+	return data;
+}
+
+// Make PKM file with one ETC1 block and given original sizes
+static std::vector<unsigned char> MakePkm(int width, int height)
+{
+	std::vector<unsigned char> data = { 'P', 'K', 'M', ' ', '1', '0', 0, 0, 0, 4, 0, 4 };
+	data.push_back(width >> 8);
+	data.push_back(width & 0xFF);
+	data.push_back(height >> 8);
+	data.push_back(height & 0xFF);
+	data.insert(data.end(), INDIVIDUAL_BLOCK, INDIVIDUAL_BLOCK + etc1::BLOCK_BYTES);
+
+	return data;
+}
+
+// Decoded blocks match colors computed by hand from ETC1 specification
+static int TestDecodeBlocks()
+{
+	std::vector<unsigned char> pixels(4 * 4 * 3);
+
+	etc1::DecodeBlock(INDIVIDUAL_BLOCK, &pixels[0], 4 * 3);
+	LUNA_CHECK(IsPixel(pixels, 4, 0, 0, 2, 2, 2));
+	LUNA_CHECK(IsPixel(pixels, 4, 1, 0, 8, 8, 8));
+	LUNA_CHECK(IsPixel(pixels, 4, 0, 1, 2, 2, 2));
+	LUNA_CHECK(IsPixel(pixels, 4, 3, 3, 2, 2, 2));
+
+	etc1::DecodeBlock(DIFFERENTIAL_BLOCK, &pixels[0], 4 * 3);
+	LUNA_CHECK(IsPixel(pixels, 4, 0, 0, 247, 0, 124));
+	LUNA_CHECK(IsPixel(pixels, 4, 3, 1, 247, 0, 124));
+	LUNA_CHECK(IsPixel(pixels, 4, 0, 2, 205, 0, 115));
+	LUNA_CHECK(IsPixel(pixels, 4, 3, 3, 205, 0, 115));
+
+	// Partial blocks on border of image are cut
+	LUNA_CHECK(etc1::Decode(INDIVIDUAL_BLOCK, sizeof(INDIVIDUAL_BLOCK), 2, 3, pixels));
+	LUNA_CHECK(pixels.size() == 2 * 3 * 3);
+	LUNA_CHECK(IsPixel(pixels, 2, 1, 0, 8, 8, 8));
+	LUNA_CHECK(IsPixel(pixels, 2, 1, 2, 2, 2, 2));
+
+	LUNA_CHECK(!etc1::Decode(INDIVIDUAL_BLOCK, sizeof(INDIVIDUAL_BLOCK), 8, 4, pixels));
+
+	return 0;
+}
+
+// KTX files in both byte orders are parsed, truncated files and files with too large sizes are rejected
+static int TestKtx()
+{
+	for(bool bigEndian : { false, true })
+	{
+		LUNACompressedImage image(MakeKtx(8, 4, bigEndian), "ktx");
+		LUNA_CHECK(!image.IsEmpty());
+		LUNA_CHECK(image.GetWidth() == 8 && image.GetHeight() == 4);
+		LUNA_CHECK(image.GetGlFormat() == GL_FORMAT_ETC1_RGB8);
+		LUNA_CHECK(image.GetLevelsCount() == 1);
+		LUNA_CHECK(image.GetLevel(0).size() == 16);
+		LUNA_CHECK(image.CanDecode());
+
+		LUNAImage decoded = image.Decode();
+		LUNA_CHECK(decoded.GetWidth() == 8 && decoded.GetHeight() == 4);
+		LUNA_CHECK(IsPixel(decoded.GetData(), 8, 5, 0, 8, 8, 8));
+	}
+
+	int errors = test::GetErrorsCount();
+
+	std::vector<unsigned char> truncated = MakeKtx(8, 4);
+	truncated.resize(truncated.size() - 1);
+	LUNA_CHECK(LUNACompressedImage(truncated, "ktx").IsEmpty());
+
+	LUNA_CHECK(LUNACompressedImage(MakeKtx(8, 4, false, 0xFFFFFFF0), "ktx").IsEmpty());
+
+	// Size of level close to max value doesn't overflow offset
+	std::vector<unsigned char> largeLevel = MakeKtx(8, 4);
+	std::memset(&largeLevel[64], 0xFF, 4);
+	LUNA_CHECK(LUNACompressedImage(largeLevel, "ktx").IsEmpty());
+
+	std::vector<unsigned char> badIdentifier = MakeKtx(8, 4);
+	badIdentifier[1] = 0;
+	LUNA_CHECK(LUNACompressedImage(badIdentifier, "ktx").IsEmpty());
+
+	LUNA_CHECK(test::GetErrorsCount() == errors + 4);
+
+	return 0;
+}
+
+// PKM header stores original sizes of image after sizes aligned by blocks
+static int TestPkm()
+{
+	LUNACompressedImage image(MakePkm(3, 2), "pkm");
+	LUNA_CHECK(!image.IsEmpty());
+	LUNA_CHECK(image.GetWidth() == 3 && image.GetHeight() == 2);
+	LUNA_CHECK(image.GetGlFormat() == GL_FORMAT_ETC1_RGB8);
+	LUNA_CHECK(image.GetLevel(0).size() == etc1::BLOCK_BYTES);
+
+	int errors = test::GetErrorsCount();
+
+	std::vector<unsigned char> truncated = MakePkm(3, 2);
+	truncated.pop_back();
+	LUNA_CHECK(LUNACompressedImage(truncated, "pkm").IsEmpty());
+
+	std::vector<unsigned char> badVersion = MakePkm(3, 2);
+	badVersion[4] = '3';
+	LUNA_CHECK(LUNACompressedImage(badVersion, "pkm").IsEmpty());
+
+	LUNA_CHECK(LUNACompressedImage(MakePkm(0, 2), "pkm").IsEmpty());
+
+	LUNA_CHECK(test::GetErrorsCount() == errors + 3);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(16, 16)) return 1;
+
+	int result = TestDecodeBlocks() || TestKtx() || TestPkm();
+
+	test::DeinitializeEngine();
+	return result;
+}
@@ -0,0 +1,104 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunafont.h"
+#include "lunafontgenerator.h"
+#include "lunasizes.h"
+#include <cmath>
+
+using namespace luna2d;
+
+const int CHAR_ADVANCE = 8; // Advance of char "A" in test font
+const float EPSILON = 0.001f;
+
+// Check distance field of square char at pixels with known distances to edge of char
+static int TestDistanceField(const std::shared_ptr<LUNAFontGenerator>& generator)
+{
+	int spread = generator->GetSdfSpread(test::TEST_FONT_PIXEL_SIZE);
+	LUNA_CHECK(spread == 2);
+
+	LUNAGlyphBitmap glyph;
+	LUNA_CHECK(generator->RenderChar(test::TEST_FONT_PIXEL_SIZE, 'A', glyph, spread));
+	LUNA_CHECK(glyph.width == 4 + spread * 2 && glyph.height == 4 + spread * 2);
+	LUNA_CHECK(glyph.advance == CHAR_ADVANCE);
+
+	// Square occupies pixels [2; 5] on both axes. Edge is stored as 128 and distance of spread maps to 0 or 255
+	auto at = [&glyph](int x, int y) { return (int)glyph.buffer[y * glyph.width + x]; };
+	LUNA_CHECK(at(3, 3) == 223); // Inside, 2 pixels to nearest outside pixel
+	LUNA_CHECK(at(4, 4) == 223);
+	LUNA_CHECK(at(2, 2) == 159); // Inside, 1 pixel to nearest outside pixel
+	LUNA_CHECK(at(2, 4) == 159);
+	LUNA_CHECK(at(1, 2) == 96); // Outside, 1 pixel to nearest inside pixel
+	LUNA_CHECK(at(6, 3) == 96);
+	LUNA_CHECK(at(1, 1) == 69); // Outside, sqrt(2) pixels to nearest inside pixel
+	LUNA_CHECK(at(0, 0) == 0); // Outside, farther than spread
+	LUNA_CHECK(at(7, 7) == 0);
+
+	return 0;
+}
+
+// Check for font using shared atlas scales regions of atlas font
+static int TestScaledFont(const std::shared_ptr<LUNAFontGenerator>& generator)
+{
+	int size = test::GetTestFontSize();
+	auto atlasFont = generator->GenerateFont(size, true);
+	LUNA_CHECK(atlasFont && atlasFont->IsSdf());
+
+	auto font = std::make_shared<LUNAFont>(atlasFont, size / 2);
+	float scale = (size / 2) / (float)size;
+	LUNA_CHECK(font->IsSdf());
+	LUNA_CHECK(std::fabs(font->GetGlyphScale() - scale) < EPSILON);
+
+	// Chars are taken from atlas font without rasterizing them again
+	auto atlasRegion = atlasFont->GetRegionForChar('A').lock();
+	LUNA_CHECK(atlasRegion && font->GetRegionForChar('A').lock() == atlasRegion);
+	LUNA_CHECK(font->GetTexture().lock() == atlasFont->GetTexture().lock());
+	LUNA_CHECK(font->GetGeneration() == atlasFont->GetGeneration());
+
+	// Sizes of regions are scaled, but margin of distance field isn't included to them
+	float textureScale = LUNAEngine::SharedSizes()->GetTextureScale();
+	LUNA_CHECK(atlasRegion->GetWidth() == CHAR_ADVANCE && atlasRegion->GetHeight() == test::TEST_FONT_HEIGHT);
+	LUNA_CHECK(std::fabs(atlasFont->GetStringWidth("AA") - 2 * CHAR_ADVANCE * textureScale) < EPSILON);
+	LUNA_CHECK(std::fabs(font->GetStringWidth("AA") - 2 * CHAR_ADVANCE * textureScale * scale) < EPSILON);
+	LUNA_CHECK(std::fabs(font->GetStringHeight("AA") - test::TEST_FONT_HEIGHT * scale) < EPSILON);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(320, 480)) return 1;
+
+	int result = 1;
+	auto generator = test::LoadTestFont();
+	if(generator)
+	{
+		result = TestDistanceField(generator) || TestScaledFont(generator) || test::GetErrorsCount() != 0;
+		generator = nullptr;
+	}
+
+	test::DeinitializeEngine();
+	return result;
+}
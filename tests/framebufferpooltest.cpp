@@ -0,0 +1,79 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunaframebufferpool.h"
+
+using namespace luna2d;
+
+// Framebuffers aren't created with color types which cannot be rendered to
+static int TestColorTypes(LUNAFrameBufferPool* pool)
+{
+	LUNA_CHECK(pool->Acquire(16, 16, LUNAColorType::ALPHA) == nullptr);
+	LUNA_CHECK(test::GetErrorsCount() == 1);
+
+	LUNAFrameBuffer frameBuffer(16, 16, LUNAColorType::ALPHA);
+	LUNA_CHECK(frameBuffer.GetColorType() == LUNAColorType::RGBA);
+	LUNA_CHECK(test::GetErrorsCount() == 2);
+
+	auto rgbFrameBuffer = pool->Acquire(16, 16, LUNAColorType::RGB);
+	LUNA_CHECK(rgbFrameBuffer && rgbFrameBuffer->GetColorType() == LUNAColorType::RGB);
+	pool->Release(rgbFrameBuffer);
+
+	return 0;
+}
+
+// Released framebuffers are reused and counted as free memory
+static int TestReuse(LUNAFrameBufferPool* pool)
+{
+	pool->Clear();
+
+	auto frameBuffer = pool->Acquire(32, 32, LUNAColorType::RGBA);
+	LUNA_CHECK(frameBuffer != nullptr);
+
+	size_t memory = frameBuffer->GetMemorySize();
+	LUNA_CHECK(pool->GetMemoryUsage() == memory);
+	LUNA_CHECK(pool->GetFreeMemory() == 0);
+
+	pool->Release(frameBuffer);
+	LUNA_CHECK(pool->GetFreeMemory() == memory);
+	LUNA_CHECK(LUNAEngine::SharedGraphics()->GetFrameBufferPoolFreeMemory() == memory);
+
+	LUNA_CHECK(pool->Acquire(32, 32, LUNAColorType::RGBA) == frameBuffer);
+	LUNA_CHECK(pool->GetFreeMemory() == 0);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(64, 64)) return 1;
+
+	LUNAFrameBufferPool* pool = LUNAEngine::SharedGraphics()->GetFrameBufferPool();
+	int result = TestColorTypes(pool) || TestReuse(pool);
+
+	test::DeinitializeEngine();
+	return result;
+}
@@ -0,0 +1,65 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunaglstate.h"
+
+using namespace luna2d;
+
+// Redundant changes of cached attributes are skipped, attributes out of cache range
+// (including -1 returned for missing attributes) are always passed to GL
+static int TestVertexAttribs()
+{
+	glstate::EnableVertexAttrib(3);
+	int issued = glstate::GetIssuedCalls();
+	int skipped = glstate::GetSkippedCalls();
+
+	glstate::EnableVertexAttrib(3);
+	LUNA_CHECK(glstate::GetIssuedCalls() == issued);
+	LUNA_CHECK(glstate::GetSkippedCalls() == skipped + 1);
+
+	GLuint missing = static_cast<GLuint>(-1);
+	glstate::EnableVertexAttrib(missing);
+	glstate::EnableVertexAttrib(missing);
+	glstate::DisableVertexAttrib(glstate::MAX_VERTEX_ATTRIBS);
+	glstate::DisableVertexAttrib(glstate::MAX_VERTEX_ATTRIBS);
+	LUNA_CHECK(glstate::GetIssuedCalls() == issued + 4);
+	LUNA_CHECK(glstate::GetSkippedCalls() == skipped + 1);
+
+	// Cached attribute isn't affected by uncached ones
+	glstate::EnableVertexAttrib(3);
+	LUNA_CHECK(glstate::GetSkippedCalls() == skipped + 2);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(16, 16)) return 1;
+
+	int result = TestVertexAttribs();
+
+	test::DeinitializeEngine();
+	return result;
+}
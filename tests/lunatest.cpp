@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunafontgenerator.h"
+#include "lunasizes.h"
+#include "lunaheadlessfiles.h"
+#include "lunaheadlesslog.h"
+#include "lunaheadlessprefs.h"
+#include "lunaheadlessutils.h"
+#include "lunaheadlessgl.h"
+#include "lunaqtservices.h"
+#include <cstdlib>
+
+using namespace luna2d;
+
+static std::string gamePath;
+static LUNAHeadlessLog* headlessLog = nullptr;
+
+// Create temporary game folder with given config and initialize engine on headless platform
+// Default framebuffer of headless GL has given size
+bool test::InitializeEngine(int screenWidth, int screenHeight, const std::string& config)
+{
+	char pathTemplate[] = "/tmp/luna2dtestXXXXXX";
+	if(!mkdtemp(pathTemplate)) return false;
+	gamePath = std::string(pathTemplate) + "/";
+
+	FILE* configFile = fopen((gamePath + CONFIG_FILENAME).c_str(), "wb");
+	if(!configFile) return false;
+	fputs(config.c_str(), configFile);
+	fclose(configFile);
+
+	LUNAHeadlessGl::Reset();
+	LUNAHeadlessGl::SetDefaultFramebufferSize(screenWidth, screenHeight);
+
+	headlessLog = new LUNAHeadlessLog();
+	LUNAEngine::Shared()->Assemble(new LUNAHeadlessFiles(gamePath, gamePath + "app/"), headlessLog,
+		new LUNAHeadlessUtils(), new LUNAHeadlessPrefs(), new LUNAQtServices());
+	LUNAEngine::Shared()->Initialize(screenWidth, screenHeight);
+
+	return LUNAEngine::Shared()->IsInitialized();
+}
+
+// Deinitialize engine and remove temporary game folder
+void test::DeinitializeEngine()
+{
+	LUNAEngine::Shared()->Deinitialize();
+	headlessLog = nullptr;
+
+	if(!gamePath.empty()) system(("rm -rf \"" + gamePath + "\"").c_str());
+	gamePath.clear();
+}
+
+// Get count of errors logged by engine since initializing
+int test::GetErrorsCount()
+{
+	return headlessLog ? headlessLog->GetErrorsCount() : 0;
+}
+
+// Write bitmap font with 8 bits per pixel to game folder and load it
+// Font contains printable ASCII chars rendered as filled rectangles. Char "A" is 4x4 square with advance of 8 pixels
+std::shared_ptr<LUNAFontGenerator> test::LoadTestFont()
+{
+	const std::string FILENAME = "test.bdf";
+
+	FILE* file = fopen((gamePath + FILENAME).c_str(), "wb");
+	if(!file) return nullptr;
+
+	fprintf(file, "STARTFONT 2.1\nFONT -test-rect-medium-r-normal--%d-160-75-75-c-80-iso10646-1\n", TEST_FONT_PIXEL_SIZE);
+	fprintf(file, "SIZE %d 75 75 8\nFONTBOUNDINGBOX 8 %d 0 -4\n", TEST_FONT_PIXEL_SIZE, TEST_FONT_HEIGHT);
+	fprintf(file, "STARTPROPERTIES 5\nPIXEL_SIZE %d\nFONT_ASCENT %d\nFONT_DESCENT 4\n",
+		TEST_FONT_PIXEL_SIZE, TEST_FONT_HEIGHT - 4);
+	fprintf(file, "CHARSET_REGISTRY \"ISO10646\"\nCHARSET_ENCODING \"1\"\nENDPROPERTIES\nCHARS %d\n", '~' - ' ' + 1);
+
+	for(int c = ' '; c <= '~'; c++)
+	{
+		// Sizes of other chars vary to make glyph offsets distinguishable
+		int width = c == 'A' ? 4 : 2 + c % 3;
+		int height = c == 'A' ? 4 : 3 + c % 5;
+		int advance = c == 'A' ? 8 : width + 1;
+		const char* pixel = c == ' ' ? "00" : "FF";
+
+		fprintf(file, "STARTCHAR U+%04X\nENCODING %d\nSWIDTH 500 0\nDWIDTH %d 0\n", c, c, advance);
+		fprintf(file, "BBX %d %d 0 0\nBITMAP\n", width, height);
+		for(int y = 0; y < height; y++)
+		{
+			for(int x = 0; x < width; x++) fputs(pixel, file);
+			fputs("\n", file);
+		}
+		fputs("ENDCHAR\n", file);
+	}
+
+	fputs("ENDFONT\n", file);
+	fclose(file);
+
+	auto generator = std::make_shared<LUNAFontGenerator>();
+	if(!generator->Load(FILENAME)) return nullptr;
+
+	return generator;
+}
+
+// Get font size in game points which is rasterized with pixel size of test font
+int test::GetTestFontSize()
+{
+	return static_cast<int>(TEST_FONT_PIXEL_SIZE * LUNAEngine::SharedSizes()->GetTextureScale() + 0.5f);
+}
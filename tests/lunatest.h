@@ -0,0 +1,71 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+#include <memory>
+#include <cstdio>
+
+//--------------------------------------------------------
+// Check macro for tests. Logs failed condition and returns
+// from test function with failure code
+//--------------------------------------------------------
+#define LUNA_CHECK(condition) \
+	do \
+	{ \
+		if(!(condition)) \
+		{ \
+			fprintf(stderr, "%s:%d: Check failed: %s\n", __FILE__, __LINE__, #condition); \
+			return 1; \
+		} \
+	} while(false)
+
+namespace luna2d{
+
+class LUNAFontGenerator;
+
+namespace test{
+
+const int TEST_FONT_PIXEL_SIZE = 16; // Size of single strike of test font
+const int TEST_FONT_HEIGHT = 16; // Height of all chars of test font
+
+
+// Create temporary game folder with given config and initialize engine on headless platform
+// Default framebuffer of headless GL has given size
+bool InitializeEngine(int screenWidth, int screenHeight, const std::string& config = "{ \"name\": \"test\" }");
+
+// Deinitialize engine and remove temporary game folder
+void DeinitializeEngine();
+
+// Get count of errors logged by engine since initializing
+int GetErrorsCount();
+
+// Write bitmap font with 8 bits per pixel to game folder and load it
+// Font contains printable ASCII chars rendered as filled rectangles. Char "A" is 4x4 square with advance of 8 pixels
+std::shared_ptr<LUNAFontGenerator> LoadTestFont();
+
+// Get font size in game points which is rasterized with pixel size of test font
+int GetTestFontSize();
+
+}}
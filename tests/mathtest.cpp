@@ -0,0 +1,116 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunamath.h"
+#include <cmath>
+
+using namespace luna2d;
+
+const float EPSILON = 0.001f;
+
+// Transform quad of given size with origin in its center by "TransformQuad" and compare corners
+// with scalar rotation formula computed in double precision
+static int CheckTransformQuad(float width, float height, float scaleX, float scaleY, float angle, float x, float y)
+{
+	float left = -width / 2 * scaleX;
+	float right = width / 2 * scaleX;
+	float bottom = -height / 2 * scaleY;
+	float top = height / 2 * scaleY;
+	float xs[4] = { left, left, right, right };
+	float ys[4] = { bottom, top, top, bottom };
+
+	double radians = angle * M_PI / 180.0;
+	float sin = std::sin(radians);
+	float cos = std::cos(radians);
+
+	// Extra item is guard for writing out of four corners
+	glm::vec2 out[5];
+	out[4] = glm::vec2(-1.0f, -1.0f);
+	math::TransformQuad(xs, ys, sin, cos, x, y, out);
+
+	for(int i = 0; i < 4; i++)
+	{
+		double expectedX = xs[i] * std::cos(radians) - ys[i] * std::sin(radians) + x;
+		double expectedY = xs[i] * std::sin(radians) + ys[i] * std::cos(radians) + y;
+		LUNA_CHECK(std::fabs(out[i].x - expectedX) < EPSILON);
+		LUNA_CHECK(std::fabs(out[i].y - expectedY) < EPSILON);
+	}
+	LUNA_CHECK(out[4] == glm::vec2(-1.0f, -1.0f));
+
+	return 0;
+}
+
+// Quads without rotation are only translated
+static int TestTranslated()
+{
+	LUNA_CHECK(CheckTransformQuad(10, 20, 1, 1, 0, 0, 0) == 0);
+	LUNA_CHECK(CheckTransformQuad(10, 20, 1, 1, 0, 100.5f, -30.25f) == 0);
+
+	float xs[4] = { 0, 0, 2, 2 };
+	float ys[4] = { 0, 3, 3, 0 };
+	glm::vec2 out[4];
+	math::TransformQuad(xs, ys, 0, 1, 5, 7, out);
+
+	// Corners are written in input order as pairs of coordinates
+	LUNA_CHECK(out[0] == glm::vec2(5, 7));
+	LUNA_CHECK(out[1] == glm::vec2(5, 10));
+	LUNA_CHECK(out[2] == glm::vec2(7, 10));
+	LUNA_CHECK(out[3] == glm::vec2(7, 7));
+
+	return 0;
+}
+
+static int TestRotated()
+{
+	for(float angle : { 30.0f, 45.0f, 90.0f, 135.0f, 180.0f, 270.0f, -60.0f, 359.0f })
+	{
+		LUNA_CHECK(CheckTransformQuad(10, 20, 1, 1, angle, 0, 0) == 0);
+	}
+
+	return 0;
+}
+
+// Scaled quads including mirrored ones
+static int TestScaled()
+{
+	LUNA_CHECK(CheckTransformQuad(10, 20, 2.5f, 0.5f, 0, 0, 0) == 0);
+	LUNA_CHECK(CheckTransformQuad(10, 20, -1, 1, 0, 0, 0) == 0);
+	LUNA_CHECK(CheckTransformQuad(10, 20, 3, -2, 0, 0, 0) == 0);
+
+	return 0;
+}
+
+static int TestCombined()
+{
+	LUNA_CHECK(CheckTransformQuad(64, 32, 1.5f, 0.75f, 37.0f, 320.0f, 240.0f) == 0);
+	LUNA_CHECK(CheckTransformQuad(1, 1, -2, 4, -123.0f, -15.5f, 1000.0f) == 0);
+	LUNA_CHECK(CheckTransformQuad(128, 8, 0.1f, 10, 210.0f, 0.5f, -0.5f) == 0);
+
+	return 0;
+}
+
+int main()
+{
+	return TestTranslated() || TestRotated() || TestScaled() || TestCombined();
+}
@@ -0,0 +1,138 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunamesh.h"
+#include "lunaheadlessgl.h"
+
+using namespace luna2d;
+
+const int SCREEN_SIZE = 32;
+const float FAR = 100000.0f; // Coordinate outside of any camera area
+
+// Make texture with red left half and green right half
+static std::shared_ptr<LUNATexture> MakeTwoColorTexture()
+{
+	LUNAImage image(2, 1, LUNAColorType::RGBA);
+	image.SetPixel(0, 0, LUNAColor::RED);
+	image.SetPixel(1, 0, LUNAColor::GREEN);
+
+	return std::make_shared<LUNATexture>(image);
+}
+
+// Add triangle covering whole screen with same texture coordinates in all vertexes
+static void AddScreenTriangle(LUNAMesh& mesh, float u, float v)
+{
+	mesh.AddVertex(-FAR, -FAR, 1, 1, 1, 1, u, v);
+	mesh.AddVertex(0, FAR, 1, 1, 1, 1, u, v);
+	mesh.AddVertex(FAR, -FAR, 1, 1, 1, 1, u, v);
+}
+
+// Check for pixel in center of screen is green
+static bool IsCenterGreen(LUNARenderer* renderer)
+{
+	std::vector<unsigned char> data;
+	int width, height;
+	renderer->ReadPixels(data, width, height);
+
+	size_t index = ((height / 2) * width + width / 2) * 3;
+	return data[index] < 8 && data[index + 1] > 247 && data[index + 2] < 8;
+}
+
+// Render mesh in immediate and deferred modes. Center of screen should be green in both modes
+static int RenderMesh(LUNARenderer* renderer, LUNAMesh& mesh)
+{
+	for(bool deferred : { false, true })
+	{
+		renderer->EnableDeferredRender(deferred);
+		renderer->BeginRender();
+		mesh.Render();
+		renderer->EndRender();
+		renderer->EnableDeferredRender(false);
+
+		LUNA_CHECK(IsCenterGreen(renderer));
+	}
+
+	return 0;
+}
+
+// Texture coordinates out of range [0, 1] aren't clamped in "packed" vertex format,
+// vertexes added before them keep their texture coordinates
+static int TestRepeatedTexCoords(LUNARenderer* renderer)
+{
+	auto texture = MakeTwoColorTexture();
+	LUNAMesh mesh(texture);
+
+	// Clamped texture coordinate 1.75 would sample red texel
+	AddScreenTriangle(mesh, 1.75f, 0.5f);
+	LUNA_CHECK(RenderMesh(renderer, mesh) == 0);
+
+	mesh.Clear();
+	AddScreenTriangle(mesh, 0.75f, 0.5f);
+
+	// Triangle outside of screen switches mesh to float texture coordinates
+	mesh.AddVertex(FAR, FAR, 1, 1, 1, 1, 2.0f, 2.0f);
+	mesh.AddVertex(FAR, FAR + 1, 1, 1, 1, 1, 2.0f, 2.0f);
+	mesh.AddVertex(FAR + 1, FAR, 1, 1, 1, 1, 2.0f, 2.0f);
+	LUNA_CHECK(RenderMesh(renderer, mesh) == 0);
+
+	return 0;
+}
+
+// Vertex format keeps texture coordinates out of range [0, 1] only when they are stored as floats
+static int TestCanStoreTexCoords()
+{
+	LUNAVertexFormat packed(LUNAVertexFormatType::PACKED);
+	LUNAVertexFormat floatFormat = packed.GetFloatTexCoordsFormat();
+
+	LUNA_CHECK(packed.CanStoreTexCoords(0.0f, 1.0f));
+	LUNA_CHECK(!packed.CanStoreTexCoords(-0.5f, 0.5f));
+	LUNA_CHECK(!packed.CanStoreTexCoords(0.5f, 2.0f));
+	LUNA_CHECK(floatFormat.CanStoreTexCoords(-0.5f, 2.0f));
+	LUNA_CHECK(floatFormat.GetColorOffset() == packed.GetColorOffset());
+
+	std::vector<unsigned char> vertexes;
+	floatFormat.AppendVertex(vertexes, 1.0f, 2.0f, LUNAColor::RED, -0.5f, 2.0f);
+
+	float x, y, u, v;
+	LUNAColor color;
+	floatFormat.ReadVertex(vertexes, 0, x, y, color, u, v);
+	LUNA_CHECK(x == 1.0f && y == 2.0f && u == -0.5f && v == 2.0f);
+	LUNA_CHECK(color.r == 1.0f && color.g == 0.0f && color.a == 1.0f);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(SCREEN_SIZE, SCREEN_SIZE, "{ \"name\": \"test\", \"vertexFormat\": \"packed\" }")) return 1;
+	LUNAHeadlessGl::EnableRasterization(true);
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	int result = TestRepeatedTexCoords(renderer) || TestCanStoreTexCoords() || test::GetErrorsCount() != 0;
+
+	test::DeinitializeEngine();
+	return result;
+}
@@ -0,0 +1,58 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunaframebufferpool.h"
+#include "lunalua.h"
+
+using namespace luna2d;
+
+// Post-process created from Lua and collected when Lua state is deleted after graphics
+// doesn't release its scene target to deleted framebuffer pool
+static int TestCollectAfterGraphics()
+{
+	LUNAEngine::SharedLua()->DoString(
+		"postProcess = luna.graphics.PostProcess()\n"
+		"postProcess:addPass(luna.graphics.getDefaultShader())\n"
+		"postProcess:begin()\n");
+
+	// Scene target is acquired and kept by post-process until it's finished
+	LUNAFrameBufferPool* pool = LUNAEngine::SharedGraphics()->GetFrameBufferPool();
+	LUNA_CHECK(pool->GetMemoryUsage() > 0 && pool->GetFreeMemory() == 0);
+	LUNA_CHECK(LUNAEngine::SharedGraphics()->GetRenderer()->GetFrameBuffer() != nullptr);
+	LUNA_CHECK(test::GetErrorsCount() == 0);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(32, 32)) return 1;
+
+	int result = TestCollectAfterGraphics();
+
+	test::DeinitializeEngine();
+	return result;
+}
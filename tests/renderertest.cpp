@@ -0,0 +1,228 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunarenderer.h"
+#include "lunamaterial.h"
+#include "lunatexture.h"
+#include "lunasprite.h"
+#include "lunacamera.h"
+#include "lunagl.h"
+#include <cmath>
+
+using namespace luna2d;
+
+const int SCREEN_WIDTH = 64;
+const int SCREEN_HEIGHT = 48;
+const float FAR = 100000.0f; // Coordinate outside of any camera area
+
+// Make white texture, so quads are filled with vertex color
+static std::shared_ptr<LUNATexture> MakeWhiteTexture()
+{
+	LUNAImage image(1, 1, LUNAColorType::RGBA);
+	image.Fill(LUNAColor::WHITE);
+
+	return std::make_shared<LUNATexture>(image);
+}
+
+// Render quad covering whole screen
+static void RenderScreenQuad(LUNARenderer* renderer, const LUNAMaterial& material, const LUNAColor& color)
+{
+	renderer->RenderQuad(
+		-FAR, -FAR, 0, 1,
+		-FAR, FAR, 0, 0,
+		FAR, FAR, 1, 0,
+		FAR, -FAR, 1, 1,
+		&material, color);
+}
+
+// Get color of pixel in center of screen
+static LUNAColor GetCenterPixel(LUNARenderer* renderer)
+{
+	std::vector<unsigned char> data;
+	int width, height;
+	renderer->ReadPixels(data, width, height);
+
+	size_t index = ((height / 2) * width + width / 2) * 3;
+	return LUNAColor::RgbFloat(data[index] / 255.0f, data[index + 1] / 255.0f, data[index + 2] / 255.0f);
+}
+
+// Compare colors with precision of 8-bit color channels
+static bool IsSameColor(const LUNAColor& color1, const LUNAColor& color2)
+{
+	const float EPSILON = 1.0f / 255.0f;
+	return std::abs(color1.r - color2.r) <= EPSILON && std::abs(color1.g - color2.g) <= EPSILON &&
+		std::abs(color1.b - color2.b) <= EPSILON;
+}
+
+// Quad is drawn with single draw call and rasterized to default framebuffer
+static int TestRenderQuad(LUNARenderer* renderer)
+{
+	auto texture = MakeWhiteTexture();
+	LUNAMaterial material(texture, renderer->GetDefaultShader(), LUNABlendingMode::ALPHA);
+
+	LUNAHeadlessGl::ResetStats();
+	renderer->BeginRender();
+	RenderScreenQuad(renderer, material, LUNAColor::RED);
+	renderer->EndRender();
+
+	const LUNAHeadlessGl::Stats& stats = LUNAHeadlessGl::GetStats();
+	LUNA_CHECK(stats.drawCalls == 1);
+	LUNA_CHECK(stats.drawnVertexes == 6);
+	LUNA_CHECK(stats.rasterizedPixels >= static_cast<size_t>(SCREEN_WIDTH * SCREEN_HEIGHT));
+	LUNA_CHECK(IsSameColor(GetCenterPixel(renderer), LUNAColor::RED));
+
+	return 0;
+}
+
+// Deferred render merges quads with same material into one draw call
+static int TestDeferredMerge(LUNARenderer* renderer)
+{
+	auto texture = MakeWhiteTexture();
+	LUNAMaterial material(texture, renderer->GetDefaultShader(), LUNABlendingMode::ALPHA);
+
+	renderer->EnableDeferredRender(true);
+	LUNAHeadlessGl::ResetStats();
+	renderer->BeginRender();
+	for(int i = 0; i < 10; i++) RenderScreenQuad(renderer, material, LUNAColor::GREEN);
+	renderer->EndRender();
+	renderer->EnableDeferredRender(false);
+
+	LUNA_CHECK(LUNAHeadlessGl::GetStats().drawCalls == 1);
+	LUNA_CHECK(LUNAHeadlessGl::GetStats().drawnVertexes == 60);
+	LUNA_CHECK(IsSameColor(GetCenterPixel(renderer), LUNAColor::GREEN));
+
+	return 0;
+}
+
+// Render triangle crossing edge of current clip rect, so scissor test is enabled for it
+static void RenderClippedTriangle(LUNARenderer* renderer, const LUNAMaterial& material)
+{
+	std::vector<unsigned char> vertexes;
+	const LUNAVertexFormat& format = renderer->GetVertexFormat();
+	format.AppendVertex(vertexes, -FAR, -FAR, LUNAColor::WHITE, 0, 0);
+	format.AppendVertex(vertexes, 0, FAR, LUNAColor::WHITE, 0, 0);
+	format.AppendVertex(vertexes, FAR, -FAR, LUNAColor::WHITE, 0, 0);
+
+	renderer->RenderVertexArray(vertexes, &material);
+}
+
+// Lines are cut by scissor inside clip rect, and aren't cut by scissor left after popping clip rect
+static int TestLinesClip(LUNARenderer* renderer)
+{
+	auto texture = MakeWhiteTexture();
+	LUNAMaterial material(texture, renderer->GetDefaultShader(), LUNABlendingMode::ALPHA);
+	auto camera = LUNAEngine::SharedGraphics()->GetCamera();
+	glm::vec2 clipMin = camera->Unproject(glm::vec2(SCREEN_WIDTH / 4, SCREEN_HEIGHT / 4));
+	glm::vec2 clipMax = camera->Unproject(glm::vec2(SCREEN_WIDTH * 3 / 4, SCREEN_HEIGHT * 3 / 4));
+	glm::vec2 clipSize = clipMax - clipMin;
+
+	// Line crossing clip rect
+	renderer->BeginRender();
+	renderer->PushClipRect(clipMin.x, clipMin.y, clipSize.x, clipSize.y);
+	renderer->RenderLine(-FAR, -FAR, FAR, FAR, LUNAColor::WHITE);
+	renderer->EndRender();
+	LUNA_CHECK(glIsEnabled(GL_SCISSOR_TEST));
+
+	// Line outside of clip rect
+	LUNAHeadlessGl::ResetStats();
+	renderer->BeginRender();
+	renderer->PushClipRect(clipMin.x, clipMin.y, clipSize.x, clipSize.y);
+	renderer->RenderLine(clipMax.x + 1, clipMax.y + 1, FAR, FAR, LUNAColor::WHITE);
+	renderer->EndRender();
+	LUNA_CHECK(LUNAHeadlessGl::GetStats().drawCalls == 0);
+
+	// Line after popping clip rect
+	LUNAHeadlessGl::ResetStats();
+	renderer->BeginRender();
+	renderer->PushClipRect(clipMin.x, clipMin.y, clipSize.x, clipSize.y);
+	RenderClippedTriangle(renderer, material);
+	renderer->PopClipRect();
+	renderer->RenderLine(-FAR, -FAR, FAR, FAR, LUNAColor::WHITE);
+	renderer->EndRender();
+	LUNA_CHECK(LUNAHeadlessGl::GetStats().drawCalls == 2);
+	LUNA_CHECK(!glIsEnabled(GL_SCISSOR_TEST));
+
+	return 0;
+}
+
+// Switching render target disables scissor set for previous target
+static int TestFrameBufferScissor(LUNARenderer* renderer)
+{
+	auto texture = MakeWhiteTexture();
+	LUNAMaterial material(texture, renderer->GetDefaultShader(), LUNABlendingMode::ALPHA);
+
+	renderer->BeginRender();
+	renderer->PushClipRect(0, 0, 1, 1);
+	RenderClippedTriangle(renderer, material);
+	renderer->Render();
+	LUNA_CHECK(glIsEnabled(GL_SCISSOR_TEST));
+
+	renderer->SetFrameBuffer(nullptr);
+	LUNA_CHECK(!glIsEnabled(GL_SCISSOR_TEST));
+	renderer->PopClipRect();
+	renderer->EndRender();
+
+	return 0;
+}
+
+// Object with negative layer is rendered below objects with zero layer
+static int TestNegativeLayer(LUNARenderer* renderer)
+{
+	auto texture = MakeWhiteTexture();
+	LUNASprite top(texture), bottom(texture);
+	top.SetPos(-FAR, -FAR);
+	top.SetSize(FAR * 2, FAR * 2);
+	top.SetColor(255, 0, 0);
+	bottom.SetPos(-FAR, -FAR);
+	bottom.SetSize(FAR * 2, FAR * 2);
+	bottom.SetColor(0, 255, 0);
+	bottom.SetLayer(-1);
+
+	renderer->EnableDeferredRender(true);
+	renderer->BeginRender();
+	top.Render();
+	bottom.Render();
+	renderer->EndRender();
+	renderer->EnableDeferredRender(false);
+
+	LUNA_CHECK(bottom.GetLayer() == -1);
+	LUNA_CHECK(IsSameColor(GetCenterPixel(renderer), LUNAColor::RED));
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(SCREEN_WIDTH, SCREEN_HEIGHT)) return 1;
+	LUNAHeadlessGl::EnableRasterization(true);
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	int result = TestRenderQuad(renderer) || TestDeferredMerge(renderer) || TestLinesClip(renderer) ||
+		TestFrameBufferScissor(renderer) || TestNegativeLayer(renderer) || test::GetErrorsCount() != 0;
+
+	test::DeinitializeEngine();
+	return result;
+}
@@ -0,0 +1,127 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunarenderer.h"
+#include "lunarenderqueue.h"
+#include "lunaintersect.h"
+#include <cstdlib>
+
+using namespace luna2d;
+
+// Get submission index of command at given position in sorted order
+static size_t GetSubmissionIndex(LUNARenderQueue& queue, size_t position)
+{
+	return queue.GetCommand(position).vertexOffset; // Each command has one byte of vertex data
+}
+
+// Negative layers are rendered before zero layer
+static int TestSignedLayers(const LUNAMaterial& material)
+{
+	LUNARenderQueue queue;
+	queue.Add(material, LUNABatchMode::QUADS, 0, LUNARect(0, 0, 10, 10), 1);
+	queue.Add(material, LUNABatchMode::QUADS, RENDER_QUEUE_MIN_LAYER, LUNARect(0, 0, 10, 10), 1);
+	queue.Add(material, LUNABatchMode::QUADS, -1, LUNARect(0, 0, 10, 10), 1);
+	queue.Add(material, LUNABatchMode::QUADS, RENDER_QUEUE_MAX_LAYER, LUNARect(0, 0, 10, 10), 1);
+	queue.Sort();
+
+	LUNA_CHECK(GetSubmissionIndex(queue, 0) == 1);
+	LUNA_CHECK(GetSubmissionIndex(queue, 1) == 2);
+	LUNA_CHECK(GetSubmissionIndex(queue, 2) == 0);
+	LUNA_CHECK(GetSubmissionIndex(queue, 3) == 3);
+
+	return 0;
+}
+
+// Non-overlapping commands are grouped by material, overlapping commands keep submission order
+static int TestMerge(const LUNAMaterial& material1, const LUNAMaterial& material2)
+{
+	LUNARenderQueue queue;
+	queue.Add(material1, LUNABatchMode::QUADS, 0, LUNARect(0, 0, 10, 10), 1);
+	queue.Add(material2, LUNABatchMode::QUADS, 0, LUNARect(20, 0, 10, 10), 1);
+	queue.Add(material1, LUNABatchMode::QUADS, 0, LUNARect(40, 0, 10, 10), 1);
+	queue.Sort();
+
+	LUNA_CHECK(queue.GetCommand(0).materialId == queue.GetCommand(1).materialId);
+
+	queue.Clear();
+	queue.Add(material1, LUNABatchMode::QUADS, 0, LUNARect(0, 0, 10, 10), 1);
+	queue.Add(material2, LUNABatchMode::QUADS, 0, LUNARect(5, 0, 10, 10), 1);
+	queue.Add(material1, LUNABatchMode::QUADS, 0, LUNARect(10, 0, 10, 10), 1);
+	queue.Sort();
+
+	for(size_t i = 0; i < 3; i++) LUNA_CHECK(GetSubmissionIndex(queue, i) == i);
+
+	return 0;
+}
+
+// Every pair of overlapping commands with different materials keeps submission order
+// Count of commands is larger than count of commands checked when adding command
+static int TestPaintersOrder(const LUNAMaterial& material1, const LUNAMaterial& material2)
+{
+	const size_t COUNT = 2000;
+
+	srand(1);
+	LUNARenderQueue queue;
+	std::vector<LUNARect> bounds;
+	std::vector<int> materials;
+
+	for(size_t i = 0; i < COUNT; i++)
+	{
+		bounds.push_back(LUNARect(rand() % 1000, rand() % 1000, 10 + rand() % 50, 10 + rand() % 50));
+		materials.push_back(rand() % 4 == 0 ? 1 : 0);
+		queue.Add(materials[i] == 0 ? material1 : material2, LUNABatchMode::QUADS, 0, bounds[i], 1);
+	}
+	queue.Sort();
+
+	std::vector<size_t> positions(COUNT);
+	for(size_t i = 0; i < COUNT; i++) positions[GetSubmissionIndex(queue, i)] = i;
+
+	for(size_t i = 0; i < COUNT; i++)
+	{
+		for(size_t j = i + 1; j < COUNT; j++)
+		{
+			if(materials[i] == materials[j] || !intersect::Rectangles(bounds[i], bounds[j])) continue;
+			LUNA_CHECK(positions[i] < positions[j]);
+		}
+	}
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(64, 64)) return 1;
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	LUNAMaterial material1(std::weak_ptr<LUNATexture>(), renderer->GetDefaultShader(), LUNABlendingMode::ALPHA);
+	LUNAMaterial material2(std::weak_ptr<LUNATexture>(), renderer->GetPrimitvesShader(), LUNABlendingMode::ALPHA);
+
+	int result = TestSignedLayers(material1) || TestMerge(material1, material2) ||
+		TestPaintersOrder(material1, material2) || test::GetErrorsCount() != 0;
+
+	test::DeinitializeEngine();
+	return result;
+}
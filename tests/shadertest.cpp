@@ -0,0 +1,69 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunashader.h"
+#include "shaders/sdffont.frag.h"
+
+using namespace luna2d;
+
+// Extension directive of SDF font shader precedes default precision and any other code
+static int TestSdfFontDirectives()
+{
+	std::string source = LUNAShader::PreprocessFragment(SDF_FONT_FRAG_SHADER);
+
+	size_t extensionPos = source.find("#extension GL_OES_standard_derivatives");
+	LUNA_CHECK(extensionPos == 0);
+	LUNA_CHECK(source.find("precision mediump float;") != std::string::npos);
+	LUNA_CHECK(extensionPos < source.find("precision mediump float;"));
+	LUNA_CHECK(extensionPos < source.find("#ifdef GL_ES"));
+
+	return 0;
+}
+
+// Only "#version" and "#extension" directives are kept before default directives
+static int TestLeadingDirectives()
+{
+	std::string source = LUNAShader::PreprocessFragment(
+		"#version 100\n"
+		"#extension GL_OES_standard_derivatives : enable\n"
+		"#define SCALE 2.0\n"
+		"void main() {}\n");
+
+	size_t precisionPos = source.find("#ifdef GL_ES\nprecision mediump float;");
+	LUNA_CHECK(source.find("#version 100\n#extension") == 0);
+	LUNA_CHECK(precisionPos != std::string::npos);
+	LUNA_CHECK(source.find("#extension") < precisionPos);
+	LUNA_CHECK(precisionPos < source.find("#define SCALE"));
+
+	// Conditional directives can depend on defaults, so they aren't moved before them
+	std::string vertexSource = LUNAShader::PreprocessVertex("#ifdef GL_ES\n#define X\n#endif\n");
+	LUNA_CHECK(vertexSource.find("#ifndef GL_ES") == 0);
+
+	return 0;
+}
+
+int main()
+{
+	return TestSdfFontDirectives() || TestLeadingDirectives();
+}
@@ -0,0 +1,155 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunaspritebatch.h"
+#include "lunaheadlessgl.h"
+#include "lunalua.h"
+
+using namespace luna2d;
+
+// Make white texture for sprites
+static std::shared_ptr<LUNATexture> MakeWhiteTexture()
+{
+	LUNAImage image(1, 1, LUNAColorType::RGBA);
+	image.Fill(LUNAColor::WHITE);
+
+	return std::make_shared<LUNATexture>(image);
+}
+
+// Make sprite with given position and size
+static std::shared_ptr<LUNASprite> MakeSprite(const std::shared_ptr<LUNATexture>& texture, float x, float y, float size)
+{
+	auto sprite = std::make_shared<LUNASprite>(texture);
+	sprite->SetPos(x, y);
+	sprite->SetSize(size, size);
+	return sprite;
+}
+
+// Rendering sprite batch in deferred mode doesn't flush draw calls recorded before it
+static int TestDeferredRender(LUNARenderer* renderer)
+{
+	auto texture = MakeWhiteTexture();
+	auto camera = LUNAEngine::SharedGraphics()->GetCamera();
+	glm::vec2 origin = camera->Unproject(glm::vec2(0, 0));
+	float size = (camera->Unproject(glm::vec2(8, 8)) - origin).x;
+
+	LUNASpriteBatch batch(texture);
+	batch.Add(MakeSprite(texture, origin.x, origin.y, size));
+	batch.Add(MakeSprite(texture, origin.x + size, origin.y, size));
+
+	auto sprite1 = MakeSprite(texture, origin.x, origin.y + size * 2, size);
+	auto sprite2 = MakeSprite(texture, origin.x + size * 2, origin.y + size * 2, size);
+
+	for(bool vertexBuffers : { true, false })
+	{
+		renderer->EnableVertexBuffers(vertexBuffers);
+		renderer->EnableDeferredRender(true);
+		LUNAHeadlessGl::ResetStats();
+		renderer->BeginRender();
+		sprite1->Render();
+		batch.Render();
+		sprite2->Render();
+		renderer->EndRender();
+		renderer->EnableDeferredRender(false);
+
+		// Separate sprites are merged to one draw call. Batch is merged with them only without vertex buffers
+		LUNA_CHECK(LUNAHeadlessGl::GetStats().drawCalls == (vertexBuffers ? 2 : 1));
+	}
+
+	renderer->EnableVertexBuffers(true);
+
+	return 0;
+}
+
+// Ids of quads are kept after removing other quads
+static int TestRemove()
+{
+	auto texture = MakeWhiteTexture();
+	auto sprite = MakeSprite(texture, 0, 0, 10);
+	LUNASpriteBatch batch(texture);
+
+	int id1 = batch.Add(sprite);
+	int id2 = batch.Add(sprite);
+	int id3 = batch.Add(sprite);
+	LUNA_CHECK(batch.GetCount() == 3);
+
+	batch.Remove(id1);
+	LUNA_CHECK(batch.GetCount() == 2);
+	LUNA_CHECK(test::GetErrorsCount() == 0);
+
+	batch.Set(id3, sprite);
+	batch.Remove(id3);
+	batch.Set(id2, sprite);
+	LUNA_CHECK(batch.GetCount() == 1);
+	LUNA_CHECK(test::GetErrorsCount() == 0);
+
+	// Removed ids are invalid until they are reused
+	batch.Remove(id3);
+	LUNA_CHECK(test::GetErrorsCount() == 1);
+
+	int id4 = batch.Add(sprite);
+	LUNA_CHECK(id4 == id1 || id4 == id3);
+	LUNA_CHECK(batch.GetCount() == 2);
+
+	batch.Remove(id2);
+	batch.Remove(id4);
+	LUNA_CHECK(batch.GetCount() == 0);
+	LUNA_CHECK(test::GetErrorsCount() == 1);
+
+	return 0;
+}
+
+// Sprite batch created from Lua is collected when Lua state is deleted after graphics,
+// so it must not flush its buffer through deleted renderer
+static int TestLuaBatch(LUNARenderer* renderer)
+{
+	LuaScript* lua = LUNAEngine::SharedLua();
+	lua->GetGlobalTable().SetField("testTexture", MakeWhiteTexture());
+	lua->DoString(
+		"testBatch = luna.graphics.SpriteBatch(testTexture)\n"
+		"testBatch:add(luna.graphics.Sprite(testTexture))\n");
+
+	renderer->EnableDeferredRender(true);
+	renderer->BeginRender();
+	lua->DoString("testBatch:render()");
+	renderer->EndRender();
+	renderer->EnableDeferredRender(false);
+
+	LUNA_CHECK(test::GetErrorsCount() == 1); // Error from "TestRemove"
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(64, 64)) return 1;
+
+	LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+	int result = TestDeferredRender(renderer) || TestRemove() || TestLuaBatch(renderer);
+
+	test::DeinitializeEngine();
+	return result;
+}
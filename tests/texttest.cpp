@@ -0,0 +1,129 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunagraphics.h"
+#include "lunatext.h"
+#include "lunafont.h"
+#include "lunafontgenerator.h"
+#include "lunaheadlessgl.h"
+
+using namespace luna2d;
+
+const int SCREEN_WIDTH = 640;
+const int SCREEN_HEIGHT = 320;
+
+// Render text on cleared screen and read rendered pixels. If text isn't given, only background is rendered
+static void RenderText(LUNARenderer* renderer, LUNAText* text, std::vector<unsigned char>& pixels)
+{
+	int width, height;
+
+	renderer->BeginRender();
+	if(text) text->Render();
+	renderer->EndRender();
+	renderer->ReadPixels(pixels, width, height);
+}
+
+// Formats reading wrong argument type or count are rejected. Text value is kept after rejecting
+static int TestFormatValidation(const std::shared_ptr<LUNAFont>& font)
+{
+	LUNAText text(font);
+	text.SetText("initial");
+	int errors = test::GetErrorsCount();
+
+	for(const char* format : { "%s", "%ld", "%*d", "%d and %d", "Score: %d%", "100%" })
+	{
+		text.SetFormatted(format, 1.0f);
+		LUNA_CHECK(test::GetErrorsCount() == ++errors);
+		LUNA_CHECK(text.GetText() == "initial");
+	}
+
+	text.SetFormatted("%d%%", 50.0f);
+	LUNA_CHECK(text.GetText() == "50%");
+
+	text.SetFormatted("Time: %5.2f", 3.14159f);
+	LUNA_CHECK(text.GetText() == "Time:  3.14");
+	LUNA_CHECK(test::GetErrorsCount() == errors);
+
+	return 0;
+}
+
+// Text changed to value with common prefix is laid out only from first changed char,
+// but its glyphs and bounds should be same as after laying out whole text
+static int TestRelayout(LUNARenderer* renderer, const std::shared_ptr<LUNAFont>& font)
+{
+	const float SCALE = 1.5f; // Fractional scale makes glyph offsets rounded
+
+	std::vector<unsigned char> background, expected, pixels;
+	RenderText(renderer, nullptr, background);
+
+	// Text is placed so that prefix "Score:" is outside of screen. If bounds wouldn't be updated
+	// after changing text, it would be culled
+	float x = -font->GetStringWidth("Score:") * SCALE - 10;
+
+	LUNAText fullText(font);
+	fullText.SetScale(SCALE);
+	fullText.SetColor(255, 0, 0); // Background is white
+	fullText.SetPos(x, 0);
+	fullText.SetText("Score: 1234");
+	RenderText(renderer, &fullText, expected);
+	LUNA_CHECK(expected != background);
+
+	// Previous values share prefix of different length with new value
+	for(const char* prefix : { "Score:", "Score: 1299", "Score: 12345678", "Time" })
+	{
+		LUNAText text(font);
+		text.SetScale(SCALE);
+		text.SetColor(255, 0, 0);
+		text.SetPos(x, 0);
+		text.SetText(prefix);
+		RenderText(renderer, &text, pixels);
+
+		text.SetText("Score: 1234");
+		RenderText(renderer, &text, pixels);
+		LUNA_CHECK(renderer->GetCulledObjects() == 0);
+		LUNA_CHECK(pixels == expected);
+		LUNA_CHECK(text.GetWidth() == fullText.GetWidth() && text.GetHeight() == fullText.GetHeight());
+	}
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(SCREEN_WIDTH, SCREEN_HEIGHT)) return 1;
+	LUNAHeadlessGl::EnableRasterization(true);
+
+	int result = 1;
+	auto generator = test::LoadTestFont();
+	if(generator)
+	{
+		auto font = generator->GenerateFont(test::GetTestFontSize());
+		LUNARenderer* renderer = LUNAEngine::SharedGraphics()->GetRenderer();
+		result = TestFormatValidation(font) || TestRelayout(renderer, font);
+	}
+
+	test::DeinitializeEngine();
+	return result;
+}
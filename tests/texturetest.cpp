@@ -0,0 +1,65 @@
+//-----------------------------------------------------------------------------
+// luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "lunatest.h"
+#include "lunaengine.h"
+#include "lunatexture.h"
+#include "lunaheadlessgl.h"
+
+using namespace luna2d;
+
+// Count of levels uploaded for texture with mipmap filter made from image with given size
+static int GetUploadedLevels(int width, int height)
+{
+	LUNAImage image(width, height, LUNAColorType::RGBA);
+	image.Fill(LUNAColor::WHITE);
+
+	LUNATextureParams params;
+	params.filter = LUNATextureFilter::LINEAR_MIPMAP;
+
+	LUNAHeadlessGl::ResetStats();
+	LUNATexture texture(image, params);
+
+	return LUNAHeadlessGl::GetStats().textureUploads;
+}
+
+// Levels are uploaded down to 1x1 level, which is uploaded once
+static int TestMipmapLevels()
+{
+	LUNA_CHECK(GetUploadedLevels(1, 1) == 1);
+	LUNA_CHECK(GetUploadedLevels(2, 2) == 2);
+	LUNA_CHECK(GetUploadedLevels(4, 1) == 3);
+	LUNA_CHECK(GetUploadedLevels(8, 2) == 4);
+
+	return 0;
+}
+
+int main()
+{
+	if(!test::InitializeEngine(32, 32)) return 1;
+
+	int result = TestMipmapLevels() || test::GetErrorsCount() != 0;
+
+	test::DeinitializeEngine();
+	return result;
+}
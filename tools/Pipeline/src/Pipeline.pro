@@ -43,6 +43,7 @@ SOURCES += main.cpp\
     pipeline/resizer.cpp \
     utils/mathutils.cpp \
     pipeline/atlasbuilder.cpp \
+    pipeline/etc1encoder.cpp \
 	ui/settings.cpp \
 	../../../thirdparty/RectangleBinPack/MaxRectsBinPack.cpp \
 	../../../thirdparty/RectangleBinPack/Rect.cpp
@@ -58,6 +59,7 @@ HEADERS  += ui/mainwindow.h \
     pipeline/resizer.h \
     utils/mathutils.h \
     pipeline/atlasbuilder.h \
+    pipeline/etc1encoder.h \
     ui/settings.h \
 	../../../thirdparty/RectangleBinPack/MaxRectsBinPack.h \
 	../../../thirdparty/RectangleBinPack/Rect.h
@@ -47,6 +47,7 @@ QPair<QImage,QJsonObject> AtlasBuilder::Run(ImageList images, int width, int hei
 		break;
 	case OutputFormat::PNG_24:
 	case OutputFormat::JPEG:
+	case OutputFormat::ETC1_KTX:
 		fillFormat = QImage::Format_RGB32;
 		fillColor = Qt::black;
 		break;
@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// luna2d Pipeline
+// This is part of luna2d engine
+// Copyright 2014-2017 Stepan Prokofjev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "etc1encoder.h"
+#include <QFile>
+#include <QDataStream>
+#include <algorithm>
+#include <array>
+#include <limits>
+
+const int BLOCK_SIZE = 4;
+const unsigned int GL_ETC1_RGB8 = 0x8D64;
+const unsigned int GL_RGB = 0x1907;
+const unsigned char KTX_IDENTIFIER[] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+
+// Intensity modifiers for each table codeword
+static const int MODIFIER_TABLE[8][2] =
+{
+	{ 2, 8 },
+	{ 5, 17 },
+	{ 9, 29 },
+	{ 13, 42 },
+	{ 18, 60 },
+	{ 24, 80 },
+	{ 33, 106 },
+	{ 47, 183 },
+};
+
+typedef std::array<std::array<QRgb, BLOCK_SIZE>, BLOCK_SIZE> Block; // Pixels of block indexed as [x][y]
+
+struct Subblock
+{
+	int color[3];
+	int table;
+	unsigned int msb;
+	unsigned int lsb;
+	int error;
+};
+
+static inline int Clamp(int value)
+{
+	return std::min(std::max(value, 0), 255);
+}
+
+static inline bool IsInSubblock(int x, int y, int index, bool flip)
+{
+	return (flip ? y / 2 : x / 2) == index;
+}
+
+// Find base color, modifiers table and pixel indexes for subblock in individual mode
+static Subblock EncodeSubblock(const Block& block, int index, bool flip)
+{
+	Subblock ret = {};
+	int sum[3] = {};
+
+	for(int x = 0; x < BLOCK_SIZE; x++)
+	{
+		for(int y = 0; y < BLOCK_SIZE; y++)
+		{
+			if(!IsInSubblock(x, y, index, flip)) continue;
+			sum[0] += qRed(block[x][y]);
+			sum[1] += qGreen(block[x][y]);
+			sum[2] += qBlue(block[x][y]);
+		}
+	}
+
+	// Quantize average color to 4 bits per component
+	int base[3];
+	for(int i = 0; i < 3; i++)
+	{
+		ret.color[i] = (sum[i] / 8 * 15 + 127) / 255;
+		base[i] = (ret.color[i] << 4) | ret.color[i];
+	}
+
+	ret.error = std::numeric_limits<int>::max();
+	for(int table = 0; table < 8; table++)
+	{
+		int error = 0;
+		unsigned int msb = 0;
+		unsigned int lsb = 0;
+
+		for(int x = 0; x < BLOCK_SIZE; x++)
+		{
+			for(int y = 0; y < BLOCK_SIZE; y++)
+			{
+				if(!IsInSubblock(x, y, index, flip)) continue;
+
+				// Select best of four modifiers for pixel
+				int bestError = std::numeric_limits<int>::max();
+				int bestModifier = 0;
+				for(int modifier = 0; modifier < 4; modifier++)
+				{
+					int value = MODIFIER_TABLE[table][modifier & 1];
+					if(modifier & 2) value = -value;
+
+					int dr = Clamp(base[0] + value) - qRed(block[x][y]);
+					int dg = Clamp(base[1] + value) - qGreen(block[x][y]);
+					int db = Clamp(base[2] + value) - qBlue(block[x][y]);
+					int pixelError = dr * dr + dg * dg + db * db;
+
+					if(pixelError < bestError)
+					{
+						bestError = pixelError;
+						bestModifier = modifier;
+					}
+				}
+
+				// Pixel indexes are stored in column-major order
+				int bit = x * 4 + y;
+				lsb |= (bestModifier & 1) << bit;
+				msb |= ((bestModifier >> 1) & 1) << bit;
+				error += bestError;
+			}
+		}
+
+		if(error < ret.error)
+		{
+			ret.error = error;
+			ret.table = table;
+			ret.msb = msb;
+			ret.lsb = lsb;
+		}
+	}
+
+	return ret;
+}
+
+// Encode block to 8 bytes of big-endian ETC1 data
+static void EncodeBlock(const Block& block, unsigned char* out)
+{
+	int bestError = std::numeric_limits<int>::max();
+	unsigned int high = 0;
+	unsigned int low = 0;
+
+	// Try both directions of splitting block to subblocks
+	for(int flip = 0; flip < 2; flip++)
+	{
+		Subblock first = EncodeSubblock(block, 0, flip);
+		Subblock second = EncodeSubblock(block, 1, flip);
+		if(first.error + second.error >= bestError) continue;
+
+		bestError = first.error + second.error;
+		high = ((unsigned int)first.color[0] << 28) | (second.color[0] << 24) |
+			(first.color[1] << 20) | (second.color[1] << 16) |
+			(first.color[2] << 12) | (second.color[2] << 8) |
+			(first.table << 5) | (second.table << 2) | flip;
+		low = ((first.msb | second.msb) << 16) | (first.lsb | second.lsb);
+	}
+
+	for(int i = 0; i < 4; i++)
+	{
+		out[i] = (high >> (24 - i * 8)) & 0xFF;
+		out[i + 4] = (low >> (24 - i * 8)) & 0xFF;
+	}
+}
+
+// Encode image to ETC1 and save it as KTX file. Alpha channel is discarded
+bool Etc1Encoder::SaveKtx(const QImage& image, const QString& path)
+{
+	if(image.isNull()) return false;
+
+	QImage source = image.convertToFormat(QImage::Format_RGB32);
+	int width = source.width();
+	int height = source.height();
+	int blocksX = (width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	int blocksY = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+	QByteArray data(blocksX * blocksY * 8, 0);
+	unsigned char* out = reinterpret_cast<unsigned char*>(data.data());
+
+	for(int blockY = 0; blockY < blocksY; blockY++)
+	{
+		for(int blockX = 0; blockX < blocksX; blockX++)
+		{
+			// Partial blocks on image border are padded by repeating edge pixels
+			Block block;
+			for(int x = 0; x < BLOCK_SIZE; x++)
+			{
+				for(int y = 0; y < BLOCK_SIZE; y++)
+				{
+					int pixelX = std::min(blockX * BLOCK_SIZE + x, width - 1);
+					int pixelY = std::min(blockY * BLOCK_SIZE + y, height - 1);
+					block[x][y] = source.pixel(pixelX, pixelY);
+				}
+			}
+
+			EncodeBlock(block, out);
+			out += 8;
+		}
+	}
+
+	QFile file(path);
+	if(!file.open(QIODevice::WriteOnly)) return false;
+
+	QDataStream stream(&file);
+	stream.setByteOrder(QDataStream::LittleEndian);
+
+	// KTX header for single level 2D texture
+	stream.writeRawData(reinterpret_cast<const char*>(KTX_IDENTIFIER), sizeof(KTX_IDENTIFIER));
+	stream << (quint32)0x04030201; // Endianness
+	stream << (quint32)0; // glType
+	stream << (quint32)1; // glTypeSize
+	stream << (quint32)0; // glFormat
+	stream << (quint32)GL_ETC1_RGB8; // glInternalFormat
+	stream << (quint32)GL_RGB; // glBaseInternalFormat
+	stream << (quint32)width;
+	stream << (quint32)height;
+	stream << (quint32)0; // Depth
+	stream << (quint32)0; // Array elements
+	stream << (quint32)1; // Faces
+	stream << (quint32)1; // Mipmap levels
+	stream << (quint32)0; // Bytes of key-value data
+
+	stream << (quint32)data.size();
+	stream.writeRawData(data.constData(), data.size());
+
+	return stream.status() == QDataStream::Ok;
+}
@@ -29,6 +29,7 @@
 #include <QFileInfo>
 #include <QDir>
 #include "utils/mathutils.h"
+#include "etc1encoder.h"
 
 static QString MakeFilename(const QString& name, const QString& resolution, const QString& extension)
 {
@@ -50,6 +51,8 @@ static bool SaveImage(const QImage& image, const QString& directory, const QStri
 	case OutputFormat::JPEG:
 		strFormat = "JPEG";
 		break;
+	case OutputFormat::ETC1_KTX:
+		return Etc1Encoder::SaveKtx(image, outputDir.absoluteFilePath(filename));
 	}
 
 	return image.save(outputDir.absoluteFilePath(filename), strFormat);
@@ -64,6 +67,8 @@ static QString ExtensionForFormat(OutputFormat format)
 		return "png";
 	case OutputFormat::JPEG:
 		return "jpg";
+	case OutputFormat::ETC1_KTX:
+		return "ktx";
 	}
 
 	return "";
@@ -56,6 +56,7 @@ Task::Task(Project* project, const QJsonObject& jsonTask) :
 	if(jsonOutputFormat == "PNG_32") outputFormat = OutputFormat::PNG_32;
 	else if(jsonOutputFormat == "PNG_24") outputFormat = OutputFormat::PNG_24;
 	else if(jsonOutputFormat == "JPEG") outputFormat = OutputFormat::JPEG;
+	else if(jsonOutputFormat == "ETC1_KTX") outputFormat = OutputFormat::ETC1_KTX;
 
 	for(auto jsonRes : jsonTask["outputRes"].toArray())
 	{
@@ -160,6 +161,9 @@ QJsonObject Task::ToJson()
 	case OutputFormat::JPEG:
 		jsonTask["outputFormat"] = "JPEG";
 		break;
+	case OutputFormat::ETC1_KTX:
+		jsonTask["outputFormat"] = "ETC1_KTX";
+		break;
 	}
 
 	QJsonArray jsonResolutions;
@@ -37,7 +37,8 @@ enum class OutputFormat
 {
 	PNG_32,
 	PNG_24,
-	JPEG
+	JPEG,
+	ETC1_KTX
 };
 
 class Task
@@ -43,7 +43,7 @@ MainWindow::MainWindow(const QString& projectPath) :
 	ui->projectTree->setContextMenuPolicy(Qt::CustomContextMenu);
 
 	// Fill output format combo box with formats
-	ui->comboFormat->addItems({ "PNG32", "PNG24", "JPEG" });
+	ui->comboFormat->addItems({ "PNG32", "PNG24", "JPEG", "ETC1" });
 
 	// Fill heuristic combo box
 	// SEE: "FreeRectChoiceHeuristic" in "MaxRectsBinPack.h"